@@ -43,6 +43,7 @@ typedef struct GPUBindTable
     static void Free(GPUBindTableID table);
 
     void Bind(GPURenderPassEncoderID encoder) const;
+    void Bind(GPUComputePassEncoderID encoder) const;
     void Update(const GPUDescriptorData* pData, uint32_t count);
 
     GPURootSignatureID m_pRS               = nullptr;
@@ -54,6 +55,13 @@ typedef struct GPUBindTable
 
 private:
     void UpdateSelfIfDirty();
+    void CollectTransientData();
+
+    // push descriptor writes of the transient set, rebuilt by every update
+    GPUDescriptorData* m_pTransientDatas = nullptr;
+    uint32_t mTransientCapacity          = 0;
+    uint32_t mTransientDatasCount        = 0;
+    uint32_t mTransientTableIndex        = UINT32_MAX;
 
 } GPUBindTable;
 
@@ -71,3 +79,4 @@ GPUBindTableID GPUCreateBindTable(GPUDeviceID device, const GPUBindTableDescript
 void GPUFreeBindTable(GPUBindTableID table);
 void GPUBindTableUpdate(GPUBindTableID table, const GPUDescriptorData* datas, uint32_t count);
 void GPURenderEncoderBindBindTable(GPURenderPassEncoderID encoder, GPUBindTableID table);
+void GPUComputeEncoderBindBindTable(GPUComputePassEncoderID encoder, GPUBindTableID table);
@@ -0,0 +1,135 @@
+#pragma once
+#include "api.h"
+#include "GPUBindTable.hpp"
+#include <unordered_map>
+#include <vector>
+
+DEFINE_GPU_OBJECT(GPUDrawList)
+
+// Sort key, most significant first: layer 8 | pipeline 12 | bind table 14 | geometry 14 | depth 16,
+// depth only orders draws that share all state. Depth-major layers put it right below the layer:
+// layer 8 | depth 16 | pipeline 12 | bind table 14 | geometry 14, which keeps blended draws in depth order
+// across pipelines at the cost of more state changes.
+// Pipelines, bind tables and geometries get dense indices in recording order
+#define GPU_DRAW_LIST_MAX_PIPELINES   (1u << 12)
+#define GPU_DRAW_LIST_MAX_BIND_TABLES (1u << 14)
+#define GPU_DRAW_LIST_MAX_GEOMETRIES  (1u << 14)
+
+typedef struct GPUDrawListDescriptor
+{
+    const char8_t* push_constant_name; // block the per-draw push data goes to
+    uint32_t push_data_size;           // bytes of push data per draw, 0 if the draws push nothing
+    uint32_t instance_data_size;       // bytes of per-instance data per draw, 0 if the draws have none
+    uint32_t reserve_count;            // draws to reserve up front
+    const uint8_t* depth_major_layers; // layers sorted by depth before state, transparent ones usually
+    uint32_t depth_major_layers_count;
+} GPUDrawListDescriptor;
+
+typedef struct GPUDrawGeometry
+{
+    const GPUBufferID* vertex_buffers;
+    const uint32_t* strides;
+    const uint32_t* offsets;
+    uint32_t vertex_buffers_count;
+    GPUBufferID index_buffer; // null for non indexed draws
+    uint32_t index_offset;
+    uint32_t index_stride;
+} GPUDrawGeometry;
+
+typedef struct GPUDrawPacket
+{
+    GPURenderPipelineID pipeline;
+    GPUBindTableID bind_table; // null uses the default table of the replay
+    const GPUDrawGeometry* geometry;
+    uint32_t count;            // index count, vertex count for non indexed geometry
+    uint32_t first;            // first index or vertex
+    int32_t vertex_offset;
+    uint8_t layer;             // coarse order, opaque before transparent and so on
+    uint16_t depth;            // quantized by the caller, front to back or back to front
+    const void* push_data;     // push_data_size bytes
+    const void* instance_data; // instance_data_size bytes
+} GPUDrawPacket;
+
+typedef struct GPUDrawListReplayDescriptor
+{
+    GPUBindTableID default_bind_table;
+    /// Mapped buffer that receives the instance data in draw order, it is bound after the
+    /// vertex buffers of every geometry and read through per-instance vertex attributes
+    GPUBufferID instance_buffer;
+    uint64_t instance_offset;
+} GPUDrawListReplayDescriptor;
+
+typedef struct GPUDrawListStats
+{
+    uint32_t draws;
+    uint32_t draw_calls;
+    uint32_t pipeline_binds;
+    uint32_t bind_table_binds;
+    uint32_t geometry_binds;
+} GPUDrawListStats;
+
+typedef struct GPUDrawList
+{
+    static GPUDrawListID Create(GPUDeviceID device, const GPUDrawListDescriptor* desc);
+    static void Free(GPUDrawListID list);
+
+    void Record(const GPUDrawPacket* packet);
+    void Sort();
+    // identical consecutive draws of the sorted stream become one instanced call
+    GPUDrawListStats Replay(GPURenderPassEncoderID encoder, const GPUDrawListReplayDescriptor* desc);
+    void Reset();
+    uint64_t InstanceDataSize() const { return (uint64_t)mKeys.size() * mInstanceDataSize; }
+
+    GPUDeviceID m_pDevice           = nullptr;
+    const char8_t* m_pPushConstName = nullptr;
+    uint32_t mPushDataSize          = 0;
+    uint32_t mInstanceDataSize      = 0;
+
+private:
+    struct Geometry
+    {
+        GPUBufferID vertexBuffers[GPU_MAX_VERTEX_ATTRIBS];
+        uint32_t strides[GPU_MAX_VERTEX_ATTRIBS];
+        uint32_t offsets[GPU_MAX_VERTEX_ATTRIBS];
+        uint32_t vertexBuffersCount;
+        GPUBufferID indexBuffer;
+        uint32_t indexOffset;
+        uint32_t indexStride;
+    };
+
+    uint32_t FindOrAddGeometry(const GPUDrawGeometry* geometry);
+    bool IsDepthMajor(uint32_t layer) const { return (mDepthMajorLayers[layer >> 6] >> (layer & 63)) & 1; }
+    uint64_t StateBits(uint64_t key) const;
+    bool CanMerge(uint32_t a, uint32_t b) const;
+
+    // the draw stream, one entry per recorded draw
+    std::vector<uint64_t> mKeys;
+    std::vector<uint32_t> mOrder; // draw indices in key order after Sort
+    std::vector<uint32_t> mCounts;
+    std::vector<uint32_t> mFirsts;
+    std::vector<int32_t> mVertexOffsets;
+    std::vector<uint8_t> mPushData;
+    std::vector<uint8_t> mInstanceData;
+    bool mSorted = true;
+    uint64_t mDepthMajorLayers[4] = {}; // one bit per layer
+
+    // state tables the keys index into
+    std::vector<GPURenderPipelineID> mPipelines;
+    std::vector<GPUBindTableID> mBindTables;
+    std::vector<Geometry> mGeometries;
+    std::unordered_map<GPURenderPipelineID, uint32_t> mPipelineIndices;
+    std::unordered_map<GPUBindTableID, uint32_t> mBindTableIndices;
+    std::unordered_multimap<uint64_t, uint32_t> mGeometryIndices;
+
+    // radix sort scratch
+    std::vector<uint64_t> mScratchKeys;
+    std::vector<uint32_t> mScratchOrder;
+} GPUDrawList;
+
+/////////////////////////
+GPUDrawListID GPUCreateDrawList(GPUDeviceID device, const GPUDrawListDescriptor* desc);
+void GPUFreeDrawList(GPUDrawListID list);
+// the packet is copied, the geometry arrays and data pointers do not have to outlive the call
+void GPUDrawListRecord(GPUDrawListID list, const GPUDrawPacket* packet);
+GPUDrawListStats GPUDrawListReplay(GPUDrawListID list, GPURenderPassEncoderID encoder, const GPUDrawListReplayDescriptor* desc);
+void GPUDrawListReset(GPUDrawListID list);
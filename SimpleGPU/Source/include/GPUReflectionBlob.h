@@ -0,0 +1,25 @@
+#pragma once
+#include "api.h"
+
+#define GPU_REFLECTION_BLOB_MAGIC   0x46524750 // "PGRF"
+#define GPU_REFLECTION_BLOB_VERSION 3
+
+// Blob layout: header, entries, vertex inputs, shader resources, spec constants, strings.
+// The structs are stored as they are in memory with every pointer replaced by an
+// offset from the end of the header, loading is one copy and a pointer fixup.
+typedef struct GPUReflectionBlobHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entrys_count;
+    uint32_t reserved;
+    uint64_t size; // including the header
+} GPUReflectionBlobHeader;
+
+/////////////////////////
+// writes the reflection of the library into dst and returns the size of the blob, a null dst only queries the size.
+// Offline tools can produce the blobs from reflection only libraries of the null backend
+uint64_t GPUSerializeShaderReflection(GPUShaderLibraryID library, void* dst, uint64_t dst_size);
+// the entries and everything they point to live in one allocation, release it with free.
+// Returns false and leaves the outputs untouched for a malformed blob or one of another version
+bool GPUUtil_LoadShaderReflection(const void* blob, uint64_t size, GPUShaderReflection** entries, uint32_t* entrys_count);
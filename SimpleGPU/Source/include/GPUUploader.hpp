@@ -0,0 +1,110 @@
+#pragma once
+#include "api.h"
+#include <deque>
+#include <mutex>
+#include <vector>
+
+DEFINE_GPU_OBJECT(GPUUploader)
+
+#define GPU_UPLOADER_CMD_COUNT 3
+
+// completion token of an upload, the uploader timeline reaches it once the copies are done
+typedef uint64_t GPUUploadToken;
+
+typedef struct GPUUploaderDescriptor
+{
+    GPUQueueID queue;   // transfer queue, or the graphics queue if the device has none
+    uint64_t ring_size; // persistently mapped staging memory, 0 uses 64MB
+} GPUUploaderDescriptor;
+
+typedef struct GPUBufferUpload
+{
+    GPUBufferID dst;
+    uint64_t dst_offset;
+    const void* data;
+    uint64_t size;
+    EGPUResourceState src_state;
+    EGPUResourceState dst_state;
+} GPUBufferUpload;
+
+typedef struct GPUTextureUpload
+{
+    GPUTextureID dst;
+    GPUTextureSubresource dst_subresource;
+    const void* data;
+    uint64_t size; // tightly packed texels of the whole mip level
+    EGPUResourceState src_state;
+    EGPUResourceState dst_state;
+} GPUTextureUpload;
+
+typedef struct GPUUploadBatch
+{
+    const GPUBufferUpload* buffers;
+    uint32_t buffers_count;
+    const GPUTextureUpload* textures;
+    uint32_t textures_count;
+    /// Queue that consumes the resources, ownership is released to it when its family differs,
+    /// the consumer has to acquire them and wait for the token on the uploader timeline
+    EGPUQueueType dst_queue_type;
+} GPUUploadBatch;
+
+typedef struct GPUUploader
+{
+    static GPUUploaderID Create(GPUDeviceID device, const GPUUploaderDescriptor* desc);
+    static void Free(GPUUploaderID uploader);
+
+    GPUUploadToken Enqueue(const GPUUploadBatch* batch);
+    GPUUploadToken Flush();
+    bool IsComplete(GPUUploadToken token) const;
+    void Wait(GPUUploadToken token);
+
+    GPUDeviceID m_pDevice      = nullptr;
+    GPUQueueID m_pQueue        = nullptr;
+    GPUSemaphoreID m_pTimeline = nullptr;
+    GPUBufferID m_pRing        = nullptr;
+    uint64_t mRingSize         = 0;
+
+private:
+    struct PendingBufferCopy
+    {
+        GPUBufferUpload upload;
+        uint64_t offset;
+        EGPUQueueType dstQueueType;
+    };
+    struct PendingTextureCopy
+    {
+        GPUTextureUpload upload;
+        uint64_t offset;
+        EGPUQueueType dstQueueType;
+    };
+    struct RingRange
+    {
+        GPUUploadToken token;
+        uint64_t end;
+    };
+
+    uint64_t Allocate(std::unique_lock<std::mutex>& lock, uint64_t size, uint64_t alignment);
+    void Retire();
+    GPUUploadToken FlushLocked();
+
+    std::mutex mLock;
+    std::vector<PendingBufferCopy> mPendingBuffers;
+    std::vector<PendingTextureCopy> mPendingTextures;
+    std::deque<RingRange> mInflightRanges;
+    uint64_t mHead                                     = 0;
+    uint64_t mTail                                     = 0;
+    GPUUploadToken mNextToken                          = 1;
+    GPUCommandPoolID m_pPools[GPU_UPLOADER_CMD_COUNT]  = {};
+    GPUCommandBufferID m_pCmds[GPU_UPLOADER_CMD_COUNT] = {};
+    GPUUploadToken mCmdTokens[GPU_UPLOADER_CMD_COUNT]  = {};
+} GPUUploader;
+
+/////////////////////////
+GPUUploaderID GPUCreateUploader(GPUDeviceID device, const GPUUploaderDescriptor* desc);
+void GPUFreeUploader(GPUUploaderID uploader);
+// copies the data into the staging ring right away, safe to call from any thread
+GPUUploadToken GPUUploaderEnqueue(GPUUploaderID uploader, const GPUUploadBatch* batch);
+// records and submits everything enqueued so far, returns the token of the submission
+GPUUploadToken GPUUploaderFlush(GPUUploaderID uploader);
+bool GPUUploaderIsComplete(GPUUploaderID uploader, GPUUploadToken token);
+void GPUUploaderWait(GPUUploaderID uploader, GPUUploadToken token);
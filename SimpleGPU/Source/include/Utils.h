@@ -66,4 +66,44 @@ namespace Utils
         }
         return false;
     }
+
+    // no block compressed formats yet, every texel is its own block
+    static inline uint32_t FormatUtil_WidthOfBlock(EGPUFormat const fmt)
+    {
+        return 1;
+    }
+
+    static inline uint32_t FormatUtil_HeightOfBlock(EGPUFormat const fmt)
+    {
+        return 1;
+    }
+
+    static inline uint32_t FormatUtil_BitSizeOfBlock(EGPUFormat const fmt)
+    {
+        switch (fmt)
+        {
+            case GPU_FORMAT_R16_UINT:
+            case GPU_FORMAT_D16_UNORM:
+                return 16;
+            case GPU_FORMAT_D16_UNORM_S8_UINT:
+                return 24;
+            case GPU_FORMAT_B8G8R8A8_UNORM:
+            case GPU_FORMAT_B8G8R8A8_SRGB:
+            case GPU_FORMAT_R8G8BA8_UNORM:
+            case GPU_FORMAT_R8G8B8A8_SRGB:
+            case GPU_FORMAT_R32_UINT:
+            case GPU_FORMAT_R32_SFLOAT:
+            case GPU_FORMAT_D24_UNORM_S8_UINT:
+            case GPU_FORMAT_D32_SFLOAT:
+                return 32;
+            case GPU_FORMAT_R32G32_SFLOAT:
+            case GPU_FORMAT_D32_SFLOAT_S8_UINT:
+                return 64;
+            case GPU_FORMAT_R32G32B32_SFLOAT:
+                return 96;
+            default:
+                return 0;
+        }
+        return 0;
+    }
 }
\ No newline at end of file
@@ -31,6 +31,7 @@ DEFINE_GPU_OBJECT(GPUTextureView)
 DEFINE_GPU_OBJECT(GPUShaderLibrary)
 DEFINE_GPU_OBJECT(GPURootSignature)
 DEFINE_GPU_OBJECT(GPURenderPipeline)
+DEFINE_GPU_OBJECT(GPUComputePipeline)
 DEFINE_GPU_OBJECT(GPUSampler)
 DEFINE_GPU_OBJECT(GPURootSignaturePool)
 DEFINE_GPU_OBJECT(GPUCommandPool)
@@ -39,7 +40,9 @@ DEFINE_GPU_OBJECT(GPUFence)
 DEFINE_GPU_OBJECT(GPUSemaphore)
 DEFINE_GPU_OBJECT(GPUBuffer)
 DEFINE_GPU_OBJECT(GPURenderPassEncoder)
+DEFINE_GPU_OBJECT(GPUComputePassEncoder)
 DEFINE_GPU_OBJECT(GPUDescriptorSet)
+DEFINE_GPU_OBJECT(GPUBindlessHeap)
 
 #ifdef __cplusplus
 extern "C" {
@@ -59,6 +62,7 @@ extern "C" {
 	{
 		GPUBackend_Vulkan = 0,
         GPUBackend_D3D12  = 1,
+        GPUBackend_Null   = 2,
 		GPUBackend_Count,
 		GPUBackend_MAX_ENUM_BIT = 0x7FFFFFFF
 	} EGPUBackend;
@@ -309,6 +313,8 @@ extern "C" {
         GPU_BCF_NO_DESCRIPTOR_VIEW_CREATION = 0x10,
         /// Flag to specify to create GPUOnly buffer as Host visible
         GPU_BCF_HOST_VISIBLE = 0x20,
+        /// Buffer exposes GPUBuffer::gpu_address, the device has to be created with enableBufferDeviceAddress
+        GPU_BCF_DEVICE_ADDRESS_BIT = 0x40,
 #ifdef GPU_USE_METAL
         /* ICB Flags */
         /// Inherit pipeline in ICB
@@ -343,6 +349,17 @@ extern "C" {
         GPU_MIPMAP_MODE_MAX_ENUM_BIT = 0x7FFFFFFF
     } EGPUMipMapMode;
 
+    // arrays of a bindless heap, the value is also the binding inside the heap set
+    typedef enum EGPUBindlessRange
+    {
+        GPU_BINDLESS_RANGE_TEXTURE = 0,
+        GPU_BINDLESS_RANGE_RW_TEXTURE,
+        GPU_BINDLESS_RANGE_BUFFER,
+        GPU_BINDLESS_RANGE_SAMPLER,
+        GPU_BINDLESS_RANGE_COUNT,
+        GPU_BINDLESS_RANGE_MAX_ENUM_BIT = 0x7FFFFFFF
+    } EGPUBindlessRange;
+
     typedef enum EGPUResourceState
     {
         GPU_RESOURCE_STATE_UNDEFINED                  = 0,
@@ -369,6 +386,31 @@ extern "C" {
     } EGPUResourceState;
     typedef uint32_t GPUResourceStates;
 
+    // bit values mirror VkPipelineStageFlagBits
+    typedef enum EGPUPipelineStage
+    {
+        GPU_PIPELINE_STAGE_NONE                    = 0,
+        GPU_PIPELINE_STAGE_TOP_OF_PIPE             = 0x1,
+        GPU_PIPELINE_STAGE_DRAW_INDIRECT           = 0x2,
+        GPU_PIPELINE_STAGE_VERTEX_INPUT            = 0x4,
+        GPU_PIPELINE_STAGE_VERTEX_SHADER           = 0x8,
+        GPU_PIPELINE_STAGE_TESC_SHADER             = 0x10,
+        GPU_PIPELINE_STAGE_TESE_SHADER             = 0x20,
+        GPU_PIPELINE_STAGE_GEOMETRY_SHADER         = 0x40,
+        GPU_PIPELINE_STAGE_FRAGMENT_SHADER         = 0x80,
+        GPU_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS    = 0x100,
+        GPU_PIPELINE_STAGE_LATE_FRAGMENT_TESTS     = 0x200,
+        GPU_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT = 0x400,
+        GPU_PIPELINE_STAGE_COMPUTE_SHADER          = 0x800,
+        GPU_PIPELINE_STAGE_TRANSFER                = 0x1000,
+        GPU_PIPELINE_STAGE_BOTTOM_OF_PIPE          = 0x2000,
+        GPU_PIPELINE_STAGE_HOST                    = 0x4000,
+        GPU_PIPELINE_STAGE_ALL_GRAPHICS            = 0x8000,
+        GPU_PIPELINE_STAGE_ALL_COMMANDS            = 0x10000,
+        GPU_PIPELINE_STAGE_MAX_ENUM_BIT            = 0x7FFFFFFF
+    } EGPUPipelineStage;
+    typedef uint32_t GPUPipelineStages;
+
         typedef enum EGPUResourceType
     {
         GPU_RESOURCE_TYPE_NONE    = 0,
@@ -438,10 +480,20 @@ extern "C" {
     typedef void (*GPUProcFreeQueue)(GPUQueueID queue);
     void GPUSubmitQueue(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* desc);
     typedef void (*GPUProcSubmitQueue)(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* desc);
+    // several batches in one driver call, counts as one submission
+    void GPUSubmitQueueBatches(GPUQueueID queue, const struct GPUQueueBatchSubmitDescriptor* desc);
+    typedef void (*GPUProcSubmitQueueBatches)(GPUQueueID queue, const struct GPUQueueBatchSubmitDescriptor* desc);
+    // initial state transitions of resources created with an owner_queue are deferred and ride on the next submit of that queue,
+    // flush submits them on their own (e.g. before first use on another queue) and returns the submission to wait for, 0 if nothing was pending
+    uint64_t GPUFlushQueueTransitions(GPUQueueID queue);
+    typedef uint64_t (*GPUProcFlushQueueTransitions)(GPUQueueID queue);
     void GPUWaitQueueIdle(GPUQueueID queue);
     typedef void (*GPUProcWaitQueueIdle)(GPUQueueID queue);
     void GPUQueuePresent(GPUQueueID queue, const struct GPUQueuePresentDescriptor* desc);
     typedef void (*GPUProcQueuePresent)(GPUQueueID queue, const struct GPUQueuePresentDescriptor* desc);
+    // submission counter: every GPUSubmitQueue signals queue->timeline with ++queue->submitCount
+    uint64_t GPUQueueCompletedSubmission(GPUQueueID queue);
+    bool GPUWaitQueueSubmission(GPUQueueID queue, uint64_t submission, uint64_t timeout);
 
 
 	// surface api
@@ -491,11 +543,19 @@ extern "C" {
     typedef GPURenderPipelineID (*GPUProcCreateRenderPipeline)(GPUDeviceID pDevice, const GPURenderPipelineDescriptor* pDesc);
     void GPUFreeRenderPipeline(GPURenderPipelineID pPipeline);
     typedef void (*GPUProcFreeRenderPipeline)(GPURenderPipelineID pPipeline);
+    GPUComputePipelineID GPUCreateComputePipeline(GPUDeviceID pDevice, const GPUComputePipelineDescriptor* pDesc);
+    typedef GPUComputePipelineID (*GPUProcCreateComputePipeline)(GPUDeviceID pDevice, const GPUComputePipelineDescriptor* pDesc);
+    void GPUFreeComputePipeline(GPUComputePipelineID pPipeline);
+    typedef void (*GPUProcFreeComputePipeline)(GPUComputePipelineID pPipeline);
 
     GPURootSignatureID GPUCreateRootSignature(GPUDeviceID device, const struct GPURootSignatureDescriptor* desc);
     typedef GPURootSignatureID (*GPUProcCreateRootSignature)(GPUDeviceID device, const struct GPURootSignatureDescriptor* desc);
     void GPUFreeRootSignature(GPURootSignatureID RS);
     typedef void (*GPUProcFreeRootSignature)(GPURootSignatureID RS);
+    GPURootSignaturePoolID GPUCreateRootSignaturePool(GPUDeviceID device, const struct GPURootSignaturePoolDescriptor* desc);
+    typedef GPURootSignaturePoolID (*GPUProcCreateRootSignaturePool)(GPUDeviceID device, const struct GPURootSignaturePoolDescriptor* desc);
+    void GPUFreeRootSignaturePool(GPURootSignaturePoolID pool);
+    typedef void (*GPUProcFreeRootSignaturePool)(GPURootSignaturePoolID pool);
 
     //command
     GPUCommandPoolID GPUCreateCommandPool(GPUQueueID queue);
@@ -520,6 +580,13 @@ extern "C" {
     typedef void (*GPUProcCmdTransferBufferToBuffer)(GPUCommandBufferID cmd, const struct GPUBufferToBufferTransfer* desc);
     void GPUCmdTransferTextureToTexture(GPUCommandBufferID cmd, const struct GPUTextureToTextureTransfer* desc);
     typedef void (*GPUProcCmdTransferTextureToTexture)(GPUCommandBufferID cmd, const struct GPUTextureToTextureTransfer* desc);
+    // N regions between one src and one dst, recorded as a single copy command
+    void GPUCmdTransferBufferToTextureRegions(GPUCommandBufferID cmd, const struct GPUBufferToTextureRegions* desc);
+    typedef void (*GPUProcCmdTransferBufferToTextureRegions)(GPUCommandBufferID cmd, const struct GPUBufferToTextureRegions* desc);
+    void GPUCmdTransferBufferToBufferRegions(GPUCommandBufferID cmd, const struct GPUBufferToBufferRegions* desc);
+    typedef void (*GPUProcCmdTransferBufferToBufferRegions)(GPUCommandBufferID cmd, const struct GPUBufferToBufferRegions* desc);
+    void GPUCmdTransferTextureToTextureRegions(GPUCommandBufferID cmd, const struct GPUTextureToTextureRegions* desc);
+    typedef void (*GPUProcCmdTransferTextureToTextureRegions)(GPUCommandBufferID cmd, const struct GPUTextureToTextureRegions* desc);
 
     //fence & semaphore
     GPUFenceID GPUCreateFence(GPUDeviceID device);
@@ -534,23 +601,64 @@ extern "C" {
     typedef GPUSemaphoreID (*GPUProcCreateSemaphore)(GPUDeviceID device);
     void GPUFreeSemaphore(GPUSemaphoreID semaphore);
     typedef void (*GPUProcFreeSemaphore)(GPUSemaphoreID semaphore);
+    GPUSemaphoreID GPUCreateTimelineSemaphore(GPUDeviceID device, uint64_t initialValue);
+    typedef GPUSemaphoreID (*GPUProcCreateTimelineSemaphore)(GPUDeviceID device, uint64_t initialValue);
+    void GPUSignalSemaphore(GPUSemaphoreID semaphore, uint64_t value);
+    typedef void (*GPUProcSignalSemaphore)(GPUSemaphoreID semaphore, uint64_t value);
+    // timeout in nanoseconds, UINT64_MAX waits forever. returns false on timeout
+    bool GPUWaitSemaphores(const GPUSemaphoreID* semaphores, const uint64_t* values, uint32_t count, uint64_t timeout);
+    typedef bool (*GPUProcWaitSemaphores)(const GPUSemaphoreID* semaphores, const uint64_t* values, uint32_t count, uint64_t timeout);
+    uint64_t GPUQuerySemaphoreValue(GPUSemaphoreID semaphore);
+    typedef uint64_t (*GPUProcQuerySemaphoreValue)(GPUSemaphoreID semaphore);
 
     GPURenderPassEncoderID GPUCmdBeginRenderPass(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc);
     typedef GPURenderPassEncoderID (*GPUProcCmdBeginRenderPass)(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc);
     void GPUCmdEndRenderPass(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder);
     typedef void (*GPUProcCmdEndRenderPass)(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder);
+    // bundles record a pass's draws once into a secondary command buffer and replay them every frame.
+    // Begin also begins the command buffer, the bundle matches any pass with the same attachment formats
+    // and sample count. Viewport and scissor are not inherited and have to be set inside the bundle
+    GPURenderPassEncoderID GPUCmdBeginRenderBundle(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc);
+    typedef GPURenderPassEncoderID (*GPUProcCmdBeginRenderBundle)(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc);
+    void GPUCmdEndRenderBundle(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder);
+    typedef void (*GPUProcCmdEndRenderBundle)(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder);
+    // passes begun with bundled only, bindings are forgotten afterwards
+    void GPURenderEncoderExecuteBundles(GPURenderPassEncoderID encoder, const GPUCommandBufferID* bundles, uint32_t count);
+    typedef void (*GPUProcRenderEncoderExecuteBundles)(GPURenderPassEncoderID encoder, const GPUCommandBufferID* bundles, uint32_t count);
     void GPURenderEncoderSetViewport(GPURenderPassEncoderID encoder, float x, float y, float width, float height, float min_depth, float max_depth);
     typedef void (*GPUProcRenderEncoderSetViewport)(GPURenderPassEncoderID encoder, float x, float y, float width, float height, float min_depth, float max_depth);
     void GPURenderEncoderSetScissor(GPURenderPassEncoderID encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     typedef void (*GPUProcRenderEncoderSetScissor)(GPURenderPassEncoderID encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     void GPURenderEncoderBindPipeline(GPURenderPassEncoderID encoder, GPURenderPipelineID pipeline);
     typedef void (*GPUProcRenderEncoderBindPipeline)(GPURenderPassEncoderID encoder, GPURenderPipelineID pipeline);
+    // extended dynamic state devices only, binding a pipeline restores its own states.
+    // Fill mode, depth clamp and depth bias enable also need the level 2 and 3 support, the topology stays in the class of the pipeline's
+    void GPURenderEncoderSetRasterizerState(GPURenderPassEncoderID encoder, const struct GPURasterizerStateDescriptor* state);
+    typedef void (*GPUProcRenderEncoderSetRasterizerState)(GPURenderPassEncoderID encoder, const struct GPURasterizerStateDescriptor* state);
+    void GPURenderEncoderSetDepthState(GPURenderPassEncoderID encoder, const struct GPUDepthStateDesc* state);
+    typedef void (*GPUProcRenderEncoderSetDepthState)(GPURenderPassEncoderID encoder, const struct GPUDepthStateDesc* state);
+    void GPURenderEncoderSetPrimitiveTopology(GPURenderPassEncoderID encoder, EGPUPrimitiveTopology topology);
+    typedef void (*GPUProcRenderEncoderSetPrimitiveTopology)(GPURenderPassEncoderID encoder, EGPUPrimitiveTopology topology);
     void GPURenderEncoderDraw(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t first_vertex);
     typedef void (*GPUProcRenderEncoderDraw)(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t first_vertex);
+    void GPURenderEncoderDrawInstanced(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance);
+    typedef void (*GPUProcRenderEncoderDrawInstanced)(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance);
     void GPURenderEncoderDrawIndexed(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t firstIndex, uint32_t vertexOffset);
     typedef void (*GPUProcRenderEncoderDrawIndexed)(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t firstIndex, uint32_t vertexOffset);
     void GPURenderEncoderDrawIndexedInstanced(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
     typedef void (*GPUProcRenderEncoderDrawIndexedInstanced)(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+    // reads drawCount GPUDrawIndirectArguments from offset, the buffer needs GPU_RESOURCE_TYPE_INDIRECT_BUFFER
+    void GPURenderEncoderDrawIndirect(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    typedef void (*GPUProcRenderEncoderDrawIndirect)(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    // reads drawCount GPUDrawIndexedIndirectArguments from offset, the buffer needs GPU_RESOURCE_TYPE_INDIRECT_BUFFER
+    void GPURenderEncoderDrawIndexedIndirect(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    typedef void (*GPUProcRenderEncoderDrawIndexedIndirect)(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    // the draw count is a uint32_t read from countBuffer at countOffset, clamped to maxDrawCount,
+    // requires GPUAdapterDetail::support_draw_indirect_count
+    void GPURenderEncoderDrawIndirectCount(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride);
+    typedef void (*GPUProcRenderEncoderDrawIndirectCount)(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride);
+    void GPURenderEncoderDrawIndexedIndirectCount(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride);
+    typedef void (*GPUProcRenderEncoderDrawIndexedIndirectCount)(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride);
     void GPURenderEncoderBindVertexBuffers(GPURenderPassEncoderID encoder, uint32_t buffer_count,
                                                   const GPUBufferID* buffers, const uint32_t* strides, const uint32_t* offsets);
     typedef void (*GPUProcRenderEncoderBindVertexBuffers)(GPURenderPassEncoderID encoder, uint32_t buffer_count,
@@ -559,6 +667,35 @@ extern "C" {
     typedef void (*GPUProcRenderEncoderBindIndexBuffer)(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint32_t offset, uint64_t indexStride);
     void GPURenderEncoderBindDescriptorSet(GPURenderPassEncoderID encoder, GPUDescriptorSetID set);
     typedef void (*GPUProcRenderEncoderBindDescriptorSet)(GPURenderPassEncoderID encoder, GPUDescriptorSetID set);
+    // one offset per dynamic buffer of the set, in binding order
+    void GPURenderEncoderBindDescriptorSetWithOffsets(GPURenderPassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count);
+    typedef void (*GPUProcRenderEncoderBindDescriptorSetWithOffsets)(GPURenderPassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count);
+    // writes the whole reflected push constant block called name, data has to hold its size in bytes
+    void GPURenderEncoderPushConstants(GPURenderPassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data);
+    typedef void (*GPUProcRenderEncoderPushConstants)(GPURenderPassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data);
+    // writes a transient set of the root signature into the command buffer, no descriptor set involved
+    void GPURenderEncoderPushDescriptorSet(GPURenderPassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count);
+    typedef void (*GPUProcRenderEncoderPushDescriptorSet)(GPURenderPassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count);
+
+    GPUComputePassEncoderID GPUCmdBeginComputePass(GPUCommandBufferID cmd, const struct GPUComputePassDescriptor* desc);
+    typedef GPUComputePassEncoderID (*GPUProcCmdBeginComputePass)(GPUCommandBufferID cmd, const struct GPUComputePassDescriptor* desc);
+    void GPUCmdEndComputePass(GPUCommandBufferID cmd, GPUComputePassEncoderID encoder);
+    typedef void (*GPUProcCmdEndComputePass)(GPUCommandBufferID cmd, GPUComputePassEncoderID encoder);
+    void GPUComputeEncoderBindPipeline(GPUComputePassEncoderID encoder, GPUComputePipelineID pipeline);
+    typedef void (*GPUProcComputeEncoderBindPipeline)(GPUComputePassEncoderID encoder, GPUComputePipelineID pipeline);
+    void GPUComputeEncoderBindDescriptorSet(GPUComputePassEncoderID encoder, GPUDescriptorSetID set);
+    typedef void (*GPUProcComputeEncoderBindDescriptorSet)(GPUComputePassEncoderID encoder, GPUDescriptorSetID set);
+    void GPUComputeEncoderBindDescriptorSetWithOffsets(GPUComputePassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count);
+    typedef void (*GPUProcComputeEncoderBindDescriptorSetWithOffsets)(GPUComputePassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count);
+    void GPUComputeEncoderPushConstants(GPUComputePassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data);
+    typedef void (*GPUProcComputeEncoderPushConstants)(GPUComputePassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data);
+    void GPUComputeEncoderPushDescriptorSet(GPUComputePassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count);
+    typedef void (*GPUProcComputeEncoderPushDescriptorSet)(GPUComputePassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count);
+    void GPUComputeEncoderDispatch(GPUComputePassEncoderID encoder, uint32_t x, uint32_t y, uint32_t z);
+    typedef void (*GPUProcComputeEncoderDispatch)(GPUComputePassEncoderID encoder, uint32_t x, uint32_t y, uint32_t z);
+    // reads a GPUDispatchIndirectArguments at offset, the buffer needs GPU_RESOURCE_TYPE_INDIRECT_BUFFER
+    void GPUComputeEncoderDispatchIndirect(GPUComputePassEncoderID encoder, GPUBufferID buffer, uint64_t offset);
+    typedef void (*GPUProcComputeEncoderDispatchIndirect)(GPUComputePassEncoderID encoder, GPUBufferID buffer, uint64_t offset);
 
     //buffer
     GPUBufferID GPUCreateBuffer(GPUDeviceID device, const GPUBufferDescriptor* desc);
@@ -581,6 +718,22 @@ extern "C" {
     void GPUUpdateDescriptorSet(GPUDescriptorSetID set, const struct GPUDescriptorData* datas, uint32_t count);
     typedef void (*GPUProcUpdateDescriptorSet)(GPUDescriptorSetID set, const struct GPUDescriptorData* datas, uint32_t count);
 
+    // bindless heap, requires a device created with enableBindless
+    GPUBindlessHeapID GPUCreateBindlessHeap(GPUDeviceID device, const struct GPUBindlessHeapDescriptor* desc);
+    typedef GPUBindlessHeapID (*GPUProcCreateBindlessHeap)(GPUDeviceID device, const struct GPUBindlessHeapDescriptor* desc);
+    void GPUFreeBindlessHeap(GPUBindlessHeapID heap);
+    typedef void (*GPUProcFreeBindlessHeap)(GPUBindlessHeapID heap);
+    // returns the heap index of the resource, adding it again returns the same index and takes another reference
+    uint32_t GPUBindlessHeapAddTexture(GPUBindlessHeapID heap, GPUTextureViewID view, bool writable);
+    typedef uint32_t (*GPUProcBindlessHeapAddTexture)(GPUBindlessHeapID heap, GPUTextureViewID view, bool writable);
+    uint32_t GPUBindlessHeapAddBuffer(GPUBindlessHeapID heap, GPUBufferID buffer);
+    typedef uint32_t (*GPUProcBindlessHeapAddBuffer)(GPUBindlessHeapID heap, GPUBufferID buffer);
+    uint32_t GPUBindlessHeapAddSampler(GPUBindlessHeapID heap, GPUSamplerID sampler);
+    typedef uint32_t (*GPUProcBindlessHeapAddSampler)(GPUBindlessHeapID heap, GPUSamplerID sampler);
+    // drops one reference, the index is reused once all are gone so only remove what the GPU finished reading
+    void GPUBindlessHeapRemove(GPUBindlessHeapID heap, EGPUBindlessRange range, uint32_t index);
+    typedef void (*GPUProcBindlessHeapRemove)(GPUBindlessHeapID heap, EGPUBindlessRange range, uint32_t index);
+
 	typedef struct GPUProcTable
 	{
 		//instance api
@@ -598,6 +751,8 @@ extern "C" {
         const GPUProcGetQueue GetQueue;
         const GPUProcFreeQueue FreeQueue;
         const GPUProcSubmitQueue SubmitQueue;
+        const GPUProcSubmitQueueBatches SubmitQueueBatches;
+        const GPUProcFlushQueueTransitions FlushQueueTransitions;
         const GPUProcWaitQueueIdle WaitQueueIdle;
         const GPUProcQueuePresent QueuePresent;
 
@@ -619,9 +774,13 @@ extern "C" {
         //pipeline
         const GPUProcCreateRenderPipeline CreateRenderPipeline;
         const GPUProcFreeRenderPipeline FreeRenderPipeline;
+        const GPUProcCreateComputePipeline CreateComputePipeline;
+        const GPUProcFreeComputePipeline FreeComputePipeline;
 
         const GPUProcCreateRootSignature CreateRootSignature;
         const GPUProcFreeRootSignature FreeRootSignature;
+        const GPUProcCreateRootSignaturePool CreateRootSignaturePool;
+        const GPUProcFreeRootSignaturePool FreeRootSignaturePool;
 
         //command
         const GPUProcCreateCommandPool CreateCommandPool;
@@ -635,6 +794,9 @@ extern "C" {
         const GPUProcCmdTransferBufferToTexture CmdTransferBufferToTexture;
         const GPUProcCmdTransferBufferToBuffer CmdTransferBufferToBuffer;
         const GPUProcCmdTransferTextureToTexture CmdTransferTextureToTexture;
+        const GPUProcCmdTransferBufferToTextureRegions CmdTransferBufferToTextureRegions;
+        const GPUProcCmdTransferBufferToBufferRegions CmdTransferBufferToBufferRegions;
+        const GPUProcCmdTransferTextureToTextureRegions CmdTransferTextureToTextureRegions;
 
         //fence & semaphore
         const GPUProcCreateFence CreateFence;
@@ -643,18 +805,45 @@ extern "C" {
         const GPUProcQueryFenceStatus QueryFenceStatus;
         const GPUProcCreateSemaphore GpuCreateSemaphore;
         const GPUProcFreeSemaphore GpuFreeSemaphore;
+        const GPUProcCreateTimelineSemaphore CreateTimelineSemaphore;
+        const GPUProcSignalSemaphore SignalSemaphore;
+        const GPUProcWaitSemaphores WaitSemaphores;
+        const GPUProcQuerySemaphoreValue QuerySemaphoreValue;
 
         const GPUProcCmdBeginRenderPass CmdBeginRenderPass;
         const GPUProcCmdEndRenderPass CmdEndRenderPass;
+        const GPUProcCmdBeginRenderBundle CmdBeginRenderBundle;
+        const GPUProcCmdEndRenderBundle CmdEndRenderBundle;
+        const GPUProcRenderEncoderExecuteBundles RenderEncoderExecuteBundles;
         const GPUProcRenderEncoderSetViewport RenderEncoderSetViewport;
         const GPUProcRenderEncoderSetScissor RenderEncoderSetScissor;
         const GPUProcRenderEncoderBindPipeline RenderEncoderBindPipeline;
+        const GPUProcRenderEncoderSetRasterizerState RenderEncoderSetRasterizerState;
+        const GPUProcRenderEncoderSetDepthState RenderEncoderSetDepthState;
+        const GPUProcRenderEncoderSetPrimitiveTopology RenderEncoderSetPrimitiveTopology;
         const GPUProcRenderEncoderDraw RenderEncoderDraw;
+        const GPUProcRenderEncoderDrawInstanced RenderEncoderDrawInstanced;
         const GPUProcRenderEncoderDrawIndexed RenderEncoderDrawIndexed;
         const GPUProcRenderEncoderDrawIndexedInstanced RenderEncoderDrawIndexedInstanced;
+        const GPUProcRenderEncoderDrawIndirect RenderEncoderDrawIndirect;
+        const GPUProcRenderEncoderDrawIndexedIndirect RenderEncoderDrawIndexedIndirect;
+        const GPUProcRenderEncoderDrawIndirectCount RenderEncoderDrawIndirectCount;
+        const GPUProcRenderEncoderDrawIndexedIndirectCount RenderEncoderDrawIndexedIndirectCount;
         const GPUProcRenderEncoderBindVertexBuffers RenderEncoderBindVertexBuffers;
         const GPUProcRenderEncoderBindIndexBuffer RenderEncoderBindIndexBuffer;
         const GPUProcRenderEncoderBindDescriptorSet RenderEncoderBindDescriptorSet;
+        const GPUProcRenderEncoderBindDescriptorSetWithOffsets RenderEncoderBindDescriptorSetWithOffsets;
+        const GPUProcRenderEncoderPushConstants RenderEncoderPushConstants;
+        const GPUProcRenderEncoderPushDescriptorSet RenderEncoderPushDescriptorSet;
+        const GPUProcCmdBeginComputePass CmdBeginComputePass;
+        const GPUProcCmdEndComputePass CmdEndComputePass;
+        const GPUProcComputeEncoderBindPipeline ComputeEncoderBindPipeline;
+        const GPUProcComputeEncoderBindDescriptorSet ComputeEncoderBindDescriptorSet;
+        const GPUProcComputeEncoderBindDescriptorSetWithOffsets ComputeEncoderBindDescriptorSetWithOffsets;
+        const GPUProcComputeEncoderPushConstants ComputeEncoderPushConstants;
+        const GPUProcComputeEncoderPushDescriptorSet ComputeEncoderPushDescriptorSet;
+        const GPUProcComputeEncoderDispatch ComputeEncoderDispatch;
+        const GPUProcComputeEncoderDispatchIndirect ComputeEncoderDispatchIndirect;
 
         //buffer
         const GPUProcCreateBuffer CreateBuffer;
@@ -668,6 +857,13 @@ extern "C" {
         const GPUProcCreateDescriptorSet CreateDescriptorSet;
         const GPUProcFreeDescriptorSet FreeDescriptorSet;
         const GPUProcUpdateDescriptorSet UpdateDescriptorSet;
+
+        const GPUProcCreateBindlessHeap CreateBindlessHeap;
+        const GPUProcFreeBindlessHeap FreeBindlessHeap;
+        const GPUProcBindlessHeapAddTexture BindlessHeapAddTexture;
+        const GPUProcBindlessHeapAddBuffer BindlessHeapAddBuffer;
+        const GPUProcBindlessHeapAddSampler BindlessHeapAddSampler;
+        const GPUProcBindlessHeapRemove BindlessHeapRemove;
 	}GPUProcTable;
 
 	typedef struct CGPUChainedDescriptor {
@@ -700,6 +896,17 @@ extern "C" {
 	typedef struct GPUAdapterDetail
 	{
         GPUFormatSupport format_supports[GPU_FORMAT_COUNT];
+        uint32_t support_timeline_semaphore : 1;
+        uint32_t support_synchronization2 : 1;
+        uint32_t support_draw_indirect_count : 1;
+        uint32_t support_bindless : 1;
+        uint32_t support_descriptor_buffer : 1;
+        uint32_t support_push_descriptor : 1;
+        uint32_t support_buffer_device_address : 1;
+        uint32_t support_graphics_pipeline_library : 1;
+        uint32_t support_extended_dynamic_state : 1;
+        uint32_t support_extended_dynamic_state2 : 1;
+        uint32_t support_extended_dynamic_state3 : 1; // polygon mode and depth clamp
 	} GPUAdapterDetail;
 
 	typedef struct GPUAdapter
@@ -719,6 +926,18 @@ extern "C" {
         GPUQueueGroupDescriptor* pQueueGroup;
         uint32_t queueGroupCount;
         bool disablePipelineCache;
+        // descriptor sets become ranges of one mapped buffer, requires GPUAdapterDetail::support_descriptor_buffer
+        bool enableDescriptorBuffer;
+        // allows GPU_BCF_DEVICE_ADDRESS_BIT buffers, requires GPUAdapterDetail::support_buffer_device_address
+        bool enableBufferDeviceAddress;
+        // allows GPUCreateBindlessHeap, requires GPUAdapterDetail::support_bindless
+        bool enableBindless;
+        // render pipelines are linked from cached vertex input, shader and output parts,
+        // requires GPUAdapterDetail::support_graphics_pipeline_library
+        bool enableGraphicsPipelineLibrary;
+        // rasterizer, depth stencil and topology states become encoder state instead of pipeline state,
+        // requires GPUAdapterDetail::support_extended_dynamic_state, levels 2 and 3 are used when present
+        bool enableExtendedDynamicState;
 	} GPUDeviceDescriptor;
 
 	typedef struct GPUDevice
@@ -733,6 +952,8 @@ extern "C" {
         GPUDeviceID pDevice;
         EGPUQueueType queueType;
         uint32_t queueIndex;
+        GPUSemaphoreID timeline; // signaled with submitCount by every submit
+        uint64_t submitCount;
 	} GPUQueue;
 
 	typedef struct GPUSwapchainDescriptor
@@ -924,6 +1145,55 @@ extern "C" {
         GPUTextureSubresource dst_subresource;
     } GPUTextureToTextureTransfer;
 
+    typedef struct GPUTextureOffset
+    {
+        int32_t x;
+        int32_t y;
+        int32_t z;
+    } GPUTextureOffset;
+
+    typedef struct GPUTextureExtent
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t depth;
+    } GPUTextureExtent;
+
+    typedef struct GPUBufferToTextureRegion
+    {
+        uint64_t src_offset;
+        uint32_t row_pitch;      // bytes between rows of blocks, 0 for tightly packed
+        uint32_t rows_per_image; // rows of blocks between depth slices and layers, 0 for tightly packed
+        GPUTextureSubresource dst_subresource;
+        GPUTextureOffset dst_offset;
+        GPUTextureExtent extent; // 0 extends to the end of the mip level
+    } GPUBufferToTextureRegion;
+
+    typedef struct GPUBufferToTextureRegions
+    {
+        GPUTextureID dst;
+        GPUBufferID src;
+        const GPUBufferToTextureRegion* regions;
+        uint32_t regions_count;
+    } GPUBufferToTextureRegions;
+
+    typedef struct GPUTextureToTextureRegion
+    {
+        GPUTextureSubresource src_subresource;
+        GPUTextureOffset src_offset;
+        GPUTextureSubresource dst_subresource;
+        GPUTextureOffset dst_offset;
+        GPUTextureExtent extent; // 0 extends to the end of the dst mip level
+    } GPUTextureToTextureRegion;
+
+    typedef struct GPUTextureToTextureRegions
+    {
+        GPUTextureID src;
+        GPUTextureID dst;
+        const GPUTextureToTextureRegion* regions;
+        uint32_t regions_count;
+    } GPUTextureToTextureRegions;
+
     typedef struct GPUShaderLibraryDescriptor
     {
         const char8_t* pName;
@@ -931,6 +1201,8 @@ extern "C" {
         uint32_t codeSize;
         EGPUShaderStage stage;
         bool reflectionOnly;
+        const void* reflection; // blob of GPUSerializeShaderReflection, the code is not parsed then
+        uint64_t reflectionSize;
     } GPUShaderLibraryDescriptor;
 
     // Shaders
@@ -945,6 +1217,7 @@ extern "C" {
         uint32_t size;
         uint32_t offset;
         GPUShaderStages stages;
+        bool dynamic_offset; // listed in GPURootSignatureDescriptor::dynamic_buffer_names
     } CGPUShaderResource;
 
     typedef struct GPUVertexInput
@@ -954,14 +1227,24 @@ extern "C" {
         EGPUFormat format;
     } GPUVertexInput;
 
+    typedef struct GPUShaderSpecConstant
+    {
+        const char8_t* name;
+        uint32_t constant_id;
+        uint32_t size;          // 4 or 8 bytes, bools are 4
+        uint64_t default_value; // bits of the literal, 0 or 1 for bools
+    } GPUShaderSpecConstant;
+
     typedef struct GPUShaderReflection
     {
         const char8_t* entry_name;
         EGPUShaderStage stage;
         GPUVertexInput* vertex_inputs;
         GPUShaderResource* shader_resources;
+        GPUShaderSpecConstant* spec_constants;
         uint32_t vertex_inputs_count;
         uint32_t shader_resources_count;
+        uint32_t spec_constants_count;
         uint32_t thread_group_sizes[3];
     } GPUShaderReflection;
 
@@ -973,15 +1256,29 @@ extern "C" {
         uint32_t entrys_count;
     } CGPUShaderLibrary;
 
+    // 32-bit and 64-bit scalar constants, bools are passed as 0 or 1
+    typedef struct GPUConstantSpecialization
+    {
+        uint32_t constantID;
+        uint32_t size; // 8 for the 64-bit members, 0 or 4 for the others
+        union
+        {
+            uint32_t u;
+            int32_t i;
+            float f;
+            uint64_t u64;
+            int64_t i64;
+            double d;
+        };
+    } GPUConstantSpecialization;
+
     typedef struct GPUShaderEntryDescriptor
     {
         GPUShaderLibraryID pLibrary;
         const char8_t* entry;
         EGPUShaderStage stage;
-        // ++ constant_specialization
-        //const CGPUConstantSpecialization* constants;
-        //uint32_t num_constants;
-        // -- constant_specialization
+        const GPUConstantSpecialization* constants; // has to live until the pipeline is created
+        uint32_t num_constants;
     } CGPUShaderEntryDescriptor;
 
     typedef struct GPUVertexAttribute
@@ -1009,10 +1306,24 @@ extern "C" {
         uint32_t static_sampler_count;
         const char8_t* const* push_constant_names;
         uint32_t push_constant_count;
+        // uniform/storage buffers bound with an offset given at bind time instead of a descriptor write
+        const char8_t* const* dynamic_buffer_names;
+        uint32_t dynamic_buffer_count;
+        // the heap is bound as bindless_set, shader resources declared in that set are its ranges
+        GPUBindlessHeapID bindless_heap;
+        uint32_t bindless_set;
+        // sets pushed at bind time instead of allocated, requires GPUAdapterDetail::support_push_descriptor and allows one set,
+        // dynamic buffers have to live in another set
+        uint32_t transient_set_mask;
+        // signatures of the pool with the same tables, static samplers and push constants share their layouts
         GPURootSignaturePoolID pool;
-
     } GPURootSignatureDescriptor;
 
+    typedef struct GPURootSignaturePoolDescriptor
+    {
+        EGPUPipelineType pipeline_type;
+    } GPURootSignaturePoolDescriptor;
+
     typedef struct GPUSamplerDescriptor
     {
         EGPUFilterType min_filter;
@@ -1031,6 +1342,20 @@ extern "C" {
         GPUDeviceID device;
     } GPUSampler;
 
+    // 0 picks the default size of a range
+    typedef struct GPUBindlessHeapDescriptor
+    {
+        uint32_t texture_count;
+        uint32_t rw_texture_count;
+        uint32_t buffer_count;
+        uint32_t sampler_count;
+    } GPUBindlessHeapDescriptor;
+
+    typedef struct GPUBindlessHeap
+    {
+        GPUDeviceID device;
+    } GPUBindlessHeap;
+
     typedef struct GPURootSignaturePool
     {
         GPUDeviceID device;
@@ -1054,9 +1379,12 @@ extern "C" {
         uint32_t push_constant_count;
         CGPUShaderResource* static_samplers;
         uint32_t static_sampler_count;
+        GPUBindlessHeapID bindless_heap;
+        uint32_t bindless_set;
+        uint32_t transient_set_mask;
         EGPUPipelineType pipeline_type;
         GPURootSignaturePoolID pool;
-        GPURootSignatureID pool_sig;
+        GPURootSignatureID pool_sig; // owner of the shared layouts
     } GPURootSignature;
 
     typedef struct GPUDepthStateDesc
@@ -1135,6 +1463,18 @@ extern "C" {
         GPURootSignatureID pRootSignature;
     } GPURenderPipeline;
 
+    typedef struct GPUComputePipelineDescriptor
+    {
+        GPURootSignatureID pRootSignature;
+        const GPUShaderEntryDescriptor* pComputeShader;
+    } GPUComputePipelineDescriptor;
+
+    typedef struct GPUComputePipeline
+    {
+        GPUDeviceID pDevice;
+        GPURootSignatureID pRootSignature;
+    } GPUComputePipeline;
+
     typedef struct GPUCommandPool
     {
         GPUQueueID queue;
@@ -1167,6 +1507,7 @@ extern "C" {
     typedef struct GPUSemaphore
     {
         GPUDeviceID device;
+        bool timeline;
     } GPUSemaphore;
 
     typedef struct GPUColorAttachment {
@@ -1197,6 +1538,7 @@ extern "C" {
         const GPUColorAttachment* color_attachments;
         const GPUDepthStencilAttachment* depth_stencil;
         uint32_t render_target_count;
+        bool bundled; // the contents come only from GPURenderEncoderExecuteBundles
     } GPURenderPassDescriptor;
 
     typedef struct GPUTextureBarrier {
@@ -1213,6 +1555,9 @@ extern "C" {
         uint16_t array_layer;
         uint8_t d3d12_begin_only;
         uint8_t d3d12_end_only;
+        /// Optional stage hints, derived from src_state/dst_state when GPU_PIPELINE_STAGE_NONE
+        GPUPipelineStages src_stages;
+        GPUPipelineStages dst_stages;
     } GPUTextureBarrier;
 
     typedef struct GPUBufferDescriptor
@@ -1237,6 +1582,8 @@ extern "C" {
          * Applicable to buffers created in CPU accessible heaps (CPU, CPU_TO_GPU, GPU_TO_CPU)
          */
         void* cpu_mapped_address;
+        /// GPU virtual address for shaders, 0 unless created with GPU_BCF_DEVICE_ADDRESS_BIT
+        uint64_t gpu_address;
         uint64_t size : 37;
         uint64_t descriptors : 24;
         uint64_t memory_usage : 3;
@@ -1252,6 +1599,9 @@ extern "C" {
         EGPUQueueType queue_type;
         uint8_t d3d12_begin_only;
         uint8_t d3d12_end_only;
+        /// Optional stage hints, derived from src_state/dst_state when GPU_PIPELINE_STAGE_NONE
+        GPUPipelineStages src_stages;
+        GPUPipelineStages dst_stages;
     } GPUBufferBarrier;
 
     typedef struct GPUResourceBarrierDescriptor
@@ -1266,17 +1616,73 @@ extern "C" {
         GPUDeviceID device;
     } GPURenderPassEncoder;
 
+    typedef struct GPUComputePassDescriptor {
+        const char* name;
+    } GPUComputePassDescriptor;
+
+    typedef struct GPUComputePassEncoder {
+        GPUDeviceID device;
+    } GPUComputePassEncoder;
+
+    typedef struct GPUDispatchIndirectArguments {
+        uint32_t x;
+        uint32_t y;
+        uint32_t z;
+    } GPUDispatchIndirectArguments;
+
+    typedef struct GPUDrawIndirectArguments {
+        uint32_t vertex_count;
+        uint32_t instance_count;
+        uint32_t first_vertex;
+        uint32_t first_instance;
+    } GPUDrawIndirectArguments;
+
+    typedef struct GPUDrawIndexedIndirectArguments {
+        uint32_t index_count;
+        uint32_t instance_count;
+        uint32_t first_index;
+        int32_t vertex_offset;
+        uint32_t first_instance;
+    } GPUDrawIndexedIndirectArguments;
+
     typedef struct GPUQueueSubmitDescriptor
     {
         GPUCommandBufferID* cmds;
         GPUFenceID signal_fence;
         GPUSemaphoreID* wait_semaphores;
         GPUSemaphoreID* signal_semaphores;
+        const uint64_t* wait_values;   // per wait semaphore, only read for timeline semaphores
+        const uint64_t* signal_values; // per signal semaphore, only read for timeline semaphores
+        const GPUPipelineStages* wait_stages; // per wait semaphore, null waits in all stages
         uint32_t cmds_count;
         uint32_t wait_semaphore_count;
         uint32_t signal_semaphore_count;
     } GPUQueueSubmitDescriptor;
 
+    typedef struct GPUSemaphoreSubmitInfo
+    {
+        GPUSemaphoreID semaphore;
+        uint64_t value;           // ignored for binary semaphores
+        GPUPipelineStages stages; // GPU_PIPELINE_STAGE_NONE means all commands
+    } GPUSemaphoreSubmitInfo;
+
+    typedef struct GPUQueueSubmitBatch
+    {
+        const GPUCommandBufferID* cmds;
+        const GPUSemaphoreSubmitInfo* waits;
+        const GPUSemaphoreSubmitInfo* signals;
+        uint32_t cmds_count;
+        uint32_t wait_count;
+        uint32_t signal_count;
+    } GPUQueueSubmitBatch;
+
+    typedef struct GPUQueueBatchSubmitDescriptor
+    {
+        const GPUQueueSubmitBatch* batches;
+        uint32_t batch_count;
+        GPUFenceID signal_fence;
+    } GPUQueueBatchSubmitDescriptor;
+
     typedef struct GPUQueuePresentDescriptor
     {
         GPUSwapchainID swapchain;
@@ -1300,6 +1706,21 @@ extern "C" {
         uint64_t size;
     } GPUBufferToBufferTransfer;
 
+    typedef struct GPUBufferToBufferRegion
+    {
+        uint64_t src_offset;
+        uint64_t dst_offset;
+        uint64_t size;
+    } GPUBufferToBufferRegion;
+
+    typedef struct GPUBufferToBufferRegions
+    {
+        GPUBufferID dst;
+        GPUBufferID src;
+        const GPUBufferToBufferRegion* regions;
+        uint32_t regions_count;
+    } GPUBufferToBufferRegions;
+
     typedef struct GPUDescriptorSetDescriptor
     {
         GPURootSignatureID root_signature;
@@ -1354,7 +1775,7 @@ extern "C" {
             /// Array of pipeline descriptors
             GPURenderPipelineID* render_pipelines;
             /// Array of pipeline descriptors
-            //GPUComputePipelineID* compute_pipelines;
+            GPUComputePipelineID* compute_pipelines;
             /// DescriptorSet buffer extraction
             GPUDescriptorSetID* descriptor_sets;
             /// Custom binding (raytracing acceleration structure ...)
@@ -0,0 +1,154 @@
+#pragma once
+#include "api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus extern "C" {
+
+    // chained to GPUInstanceDescriptor::pChained with backend = GPUBackend_Null
+    typedef struct GPUNullInstanceDescriptor
+    {
+        CGPUChainedDescriptor chained;
+        // submissions complete this long after they were made, 0 completes them right away
+        uint32_t completion_delay_us;
+        // asserts every barrier starts from the state the resource was last transitioned to, in recording order
+        bool validate_barriers;
+    } GPUNullInstanceDescriptor;
+
+    // driverless backend, objects only carry their common part and commands record nothing
+    const GPUProcTable* GPUNullProcTable();
+
+	//instance api
+    GPUInstanceID GPUCreateInstance_Null(const struct GPUInstanceDescriptor* pDesc);
+    void GPUFreeInstance_Null(GPUInstanceID instance);
+
+	//adapter
+    void GPUEnumerateAdapters_Null(GPUInstanceID pInstance, GPUAdapterID* const ppAdapters, uint32_t* adapterCount);
+
+	//device api
+    GPUDeviceID GPUCreateDevice_Null(GPUAdapterID pAdapter, const GPUDeviceDescriptor* pDesc);
+    void GPUFreeDevice_Null(GPUDeviceID pDevice);
+
+    //queue
+    GPUQueueID GPUGetQueue_Null(GPUDeviceID pDevice, EGPUQueueType queueType, uint32_t queueIndex);
+    void GPUFreeQueue_Null(GPUQueueID queue);
+    void GPUSubmitQueue_Null(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* desc);
+    void GPUSubmitQueueBatches_Null(GPUQueueID queue, const struct GPUQueueBatchSubmitDescriptor* desc);
+    uint64_t GPUFlushQueueTransitions_Null(GPUQueueID queue);
+    void GPUWaitQueueIdle_Null(GPUQueueID queue);
+    void GPUQueuePresent_Null(GPUQueueID queue, const struct GPUQueuePresentDescriptor* desc);
+
+	//swapchain
+    GPUSwapchainID GPUCreateSwapchain_Null(GPUDeviceID pDevice, GPUSwapchainDescriptor* pDesc);
+    void GPUFreeSwapchain_Null(GPUSwapchainID pSwapchain);
+    uint32_t GPUAcquireNextImage_Null(GPUSwapchainID swapchain, const struct GPUAcquireNextDescriptor* desc);
+
+    //texture & texture_view api
+    GPUTextureViewID GPUCreateTextureView_Null(GPUDeviceID pDevice, const struct GPUTextureViewDescriptor* pDesc);
+    void GPUFreeTextureView_Null(GPUTextureViewID pTextureView);
+    GPUTextureID GPUCreateTexture_Null(GPUDeviceID device, const GPUTextureDescriptor* desc);
+    void GPUFreeTexture_Null(GPUTextureID texture);
+
+    //shader
+    GPUShaderLibraryID GPUCreateShaderLibrary_Null(GPUDeviceID pDevice, const GPUShaderLibraryDescriptor* pDesc);
+    void GPUFreeShaderLibrary_Null(GPUShaderLibraryID pShader);
+
+    //pipeline
+    GPURenderPipelineID GPUCreateRenderPipeline_Null(GPUDeviceID pDevice, const GPURenderPipelineDescriptor* pDesc);
+    void GPUFreeRenderPipeline_Null(GPURenderPipelineID pPipeline);
+    GPUComputePipelineID GPUCreateComputePipeline_Null(GPUDeviceID pDevice, const GPUComputePipelineDescriptor* pDesc);
+    void GPUFreeComputePipeline_Null(GPUComputePipelineID pPipeline);
+
+    //rootsignature
+    GPURootSignatureID GPUCreateRootSignature_Null(GPUDeviceID device, const struct GPURootSignatureDescriptor* desc);
+    void GPUFreeRootSignature_Null(GPURootSignatureID RS);
+    GPURootSignaturePoolID GPUCreateRootSignaturePool_Null(GPUDeviceID device, const struct GPURootSignaturePoolDescriptor* desc);
+    void GPUFreeRootSignaturePool_Null(GPURootSignaturePoolID pool);
+
+    //command
+    GPUCommandPoolID GPUCreateCommandPool_Null(GPUQueueID queue);
+    void GPUFreeCommandPool_Null(GPUCommandPoolID pool);
+    void GPUResetCommandPool_Null(GPUCommandPoolID pool);
+    GPUCommandBufferID GPUCreateCommandBuffer_Null(GPUCommandPoolID pool, const GPUCommandBufferDescriptor* desc);
+    void GPUFreeCommandBuffer_Null(GPUCommandBufferID cmd);
+    void GPUCmdBegin_Null(GPUCommandBufferID cmdBuffer);
+    void GPUCmdEnd_Null(GPUCommandBufferID cmdBuffer);
+    void GPUCmdResourceBarrier_Null(GPUCommandBufferID cmd, const struct GPUResourceBarrierDescriptor* desc);
+    void GPUCmdTransferBufferToTexture_Null(GPUCommandBufferID cmd, const struct GPUBufferToTextureTransfer* desc);
+    void GPUCmdTransferBufferToBuffer_Null(GPUCommandBufferID cmd, const struct GPUBufferToBufferTransfer* desc);
+    void GPUCmdTransferTextureToTexture_Null(GPUCommandBufferID cmd, const struct GPUTextureToTextureTransfer* desc);
+    void GPUCmdTransferBufferToTextureRegions_Null(GPUCommandBufferID cmd, const struct GPUBufferToTextureRegions* desc);
+    void GPUCmdTransferBufferToBufferRegions_Null(GPUCommandBufferID cmd, const struct GPUBufferToBufferRegions* desc);
+    void GPUCmdTransferTextureToTextureRegions_Null(GPUCommandBufferID cmd, const struct GPUTextureToTextureRegions* desc);
+
+    //fence & semaphore
+    GPUFenceID GPUCreateFence_Null(GPUDeviceID device);
+    void GPUFreeFence_Null(GPUFenceID fence);
+    void GPUWaitFences_Null(const GPUFenceID* fences, uint32_t fenceCount);
+    EGPUFenceStatus GPUQueryFenceStatus_Null(GPUFenceID fence);
+    GPUSemaphoreID GPUCreateSemaphore_Null(GPUDeviceID device);
+    void GPUFreeSemaphore_Null(GPUSemaphoreID semaphore);
+    GPUSemaphoreID GPUCreateTimelineSemaphore_Null(GPUDeviceID device, uint64_t initialValue);
+    void GPUSignalSemaphore_Null(GPUSemaphoreID semaphore, uint64_t value);
+    bool GPUWaitSemaphores_Null(const GPUSemaphoreID* semaphores, const uint64_t* values, uint32_t count, uint64_t timeout);
+    uint64_t GPUQuerySemaphoreValue_Null(GPUSemaphoreID semaphore);
+
+    //render pass
+    GPURenderPassEncoderID GPUCmdBeginRenderPass_Null(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc);
+    void GPUCmdEndRenderPass_Null(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder);
+    GPURenderPassEncoderID GPUCmdBeginRenderBundle_Null(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc);
+    void GPUCmdEndRenderBundle_Null(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder);
+    void GPURenderEncoderExecuteBundles_Null(GPURenderPassEncoderID encoder, const GPUCommandBufferID* bundles, uint32_t count);
+    void GPURenderEncoderSetViewport_Null(GPURenderPassEncoderID encoder, float x, float y, float width, float height, float min_depth, float max_depth);
+    void GPURenderEncoderSetScissor_Null(GPURenderPassEncoderID encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    void GPURenderEncoderBindPipeline_Null(GPURenderPassEncoderID encoder, GPURenderPipelineID pipeline);
+    void GPURenderEncoderSetRasterizerState_Null(GPURenderPassEncoderID encoder, const struct GPURasterizerStateDescriptor* state);
+    void GPURenderEncoderSetDepthState_Null(GPURenderPassEncoderID encoder, const struct GPUDepthStateDesc* state);
+    void GPURenderEncoderSetPrimitiveTopology_Null(GPURenderPassEncoderID encoder, EGPUPrimitiveTopology topology);
+    void GPURenderEncoderDraw_Null(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t first_vertex);
+    void GPURenderEncoderDrawInstanced_Null(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance);
+    void GPURenderEncoderDrawIndexed_Null(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t firstIndex, uint32_t vertexOffset);
+    void GPURenderEncoderDrawIndexedInstanced_Null(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+    void GPURenderEncoderDrawIndirect_Null(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void GPURenderEncoderDrawIndexedIndirect_Null(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void GPURenderEncoderDrawIndirectCount_Null(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride);
+    void GPURenderEncoderDrawIndexedIndirectCount_Null(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride);
+    void GPURenderEncoderBindVertexBuffers_Null(GPURenderPassEncoderID encoder, uint32_t buffer_count, const GPUBufferID* buffers, const uint32_t* strides, const uint32_t* offsets);
+    void GPURenderEncoderBindIndexBuffer_Null(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint32_t offset, uint64_t indexStride);
+    void GPURenderEncoderBindDescriptorSet_Null(GPURenderPassEncoderID encoder, GPUDescriptorSetID set);
+    void GPURenderEncoderBindDescriptorSetWithOffsets_Null(GPURenderPassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count);
+    void GPURenderEncoderPushConstants_Null(GPURenderPassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data);
+    void GPURenderEncoderPushDescriptorSet_Null(GPURenderPassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count);
+    GPUComputePassEncoderID GPUCmdBeginComputePass_Null(GPUCommandBufferID cmd, const struct GPUComputePassDescriptor* desc);
+    void GPUCmdEndComputePass_Null(GPUCommandBufferID cmd, GPUComputePassEncoderID encoder);
+    void GPUComputeEncoderBindPipeline_Null(GPUComputePassEncoderID encoder, GPUComputePipelineID pipeline);
+    void GPUComputeEncoderBindDescriptorSet_Null(GPUComputePassEncoderID encoder, GPUDescriptorSetID set);
+    void GPUComputeEncoderBindDescriptorSetWithOffsets_Null(GPUComputePassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count);
+    void GPUComputeEncoderPushConstants_Null(GPUComputePassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data);
+    void GPUComputeEncoderPushDescriptorSet_Null(GPUComputePassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count);
+    void GPUComputeEncoderDispatch_Null(GPUComputePassEncoderID encoder, uint32_t x, uint32_t y, uint32_t z);
+    void GPUComputeEncoderDispatchIndirect_Null(GPUComputePassEncoderID encoder, GPUBufferID buffer, uint64_t offset);
+
+    //buffer
+    GPUBufferID GPUCreateBuffer_Null(GPUDeviceID device, const GPUBufferDescriptor* desc);
+    void GPUFreeBuffer_Null(GPUBufferID buffer);
+    void GPUTransferBufferToBuffer_Null(GPUCommandBufferID cmd, const struct GPUBufferToBufferTransfer* desc);
+
+    // sampler
+    GPUSamplerID GPUCreateSampler_Null(GPUDeviceID device, const struct GPUSamplerDescriptor* desc);
+    void GPUFreeSampler_Null(GPUSamplerID sampler);
+    GPUDescriptorSetID GPUCreateDescriptorSet_Null(GPUDeviceID device, const struct GPUDescriptorSetDescriptor* desc);
+    void GPUFreeDescriptorSet_Null(GPUDescriptorSetID set);
+    void GPUUpdateDescriptorSet_Null(GPUDescriptorSetID set, const struct GPUDescriptorData* datas, uint32_t count);
+
+    // bindless heap
+    GPUBindlessHeapID GPUCreateBindlessHeap_Null(GPUDeviceID device, const struct GPUBindlessHeapDescriptor* desc);
+    void GPUFreeBindlessHeap_Null(GPUBindlessHeapID heap);
+    uint32_t GPUBindlessHeapAddTexture_Null(GPUBindlessHeapID heap, GPUTextureViewID view, bool writable);
+    uint32_t GPUBindlessHeapAddBuffer_Null(GPUBindlessHeapID heap, GPUBufferID buffer);
+    uint32_t GPUBindlessHeapAddSampler_Null(GPUBindlessHeapID heap, GPUSamplerID sampler);
+    void GPUBindlessHeapRemove_Null(GPUBindlessHeapID heap, EGPUBindlessRange range, uint32_t index);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus extern "C" }
@@ -18,6 +18,10 @@ extern "C" {
 #endif
 
     #define MAX_PLANE_COUNT 3
+    #define GPU_VK_INNER_CMD_COUNT 4
+    #define GPU_VK_MAX_BOUND_SETS 8
+    #define GPU_VK_MAX_VERTEX_BINDINGS 64
+    #define GPU_VK_MAX_DYNAMIC_OFFSETS 8
 
 	const GPUProcTable* GPUVulkanProcTable();
 	const GPUSurfacesProcTable* GPUVulkanSurfacesTable();
@@ -40,6 +44,8 @@ extern "C" {
     GPUQueueID GetQueue_Vulkan(GPUDeviceID pDevice, EGPUQueueType queueType, uint32_t queueIndex);
     void GPUFreeQueue_Vulkan(GPUQueueID queue);
     void GPUSubmitQueue_Vulkan(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* desc);
+    void GPUSubmitQueueBatches_Vulkan(GPUQueueID queue, const struct GPUQueueBatchSubmitDescriptor* desc);
+    uint64_t GPUFlushQueueTransitions_Vulkan(GPUQueueID queue);
     void GPUWaitQueueIdle_Vulkan(GPUQueueID queue);
     void GPUQueuePresent_Vulkan(GPUQueueID queue, const struct GPUQueuePresentDescriptor* desc);
 	//swapchain
@@ -60,10 +66,14 @@ extern "C" {
     //pipeline
     GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GPURenderPipelineDescriptor* pDesc);
     void GPUFreeRenderPipeline_Vulkan(GPURenderPipelineID pPipeline);
+    GPUComputePipelineID GPUCreateComputePipeline_Vulkan(GPUDeviceID pDevice, const GPUComputePipelineDescriptor* pDesc);
+    void GPUFreeComputePipeline_Vulkan(GPUComputePipelineID pPipeline);
 
     //rootsignature
     GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struct GPURootSignatureDescriptor* desc);
     void GPUFreeRootSignature_Vulkan(GPURootSignatureID RS);
+    GPURootSignaturePoolID GPUCreateRootSignaturePool_Vulkan(GPUDeviceID device, const struct GPURootSignaturePoolDescriptor* desc);
+    void GPUFreeRootSignaturePool_Vulkan(GPURootSignaturePoolID pool);
     void CGPUUtil_InitRSParamTables(GPURootSignature* RS, const struct GPURootSignatureDescriptor* desc);
     void GPUUtil_FreeRSParamTables(GPURootSignature* RS);
 
@@ -80,6 +90,9 @@ extern "C" {
     void GPUCmdTransferBufferToTexture_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToTextureTransfer* desc);
     void GPUCmdTransferBufferToBuffer_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToBufferTransfer* desc);
     void GPUCmdTransferTextureToTexture_Vulkan(GPUCommandBufferID cmd, const struct GPUTextureToTextureTransfer* desc);
+    void GPUCmdTransferBufferToTextureRegions_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToTextureRegions* desc);
+    void GPUCmdTransferBufferToBufferRegions_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToBufferRegions* desc);
+    void GPUCmdTransferTextureToTextureRegions_Vulkan(GPUCommandBufferID cmd, const struct GPUTextureToTextureRegions* desc);
 
     //fence & semaphore
     GPUFenceID GPUCreateFence_Vulkan(GPUDeviceID device);
@@ -88,20 +101,47 @@ extern "C" {
     EGPUFenceStatus GPUQueryFenceStatus_Vulkan(GPUFenceID fence);
     GPUSemaphoreID GPUCreateSemaphore_Vulkan(GPUDeviceID device);
     void GPUFreeSemaphore_Vulkan(GPUSemaphoreID semaphore);
+    GPUSemaphoreID GPUCreateTimelineSemaphore_Vulkan(GPUDeviceID device, uint64_t initialValue);
+    void GPUSignalSemaphore_Vulkan(GPUSemaphoreID semaphore, uint64_t value);
+    bool GPUWaitSemaphores_Vulkan(const GPUSemaphoreID* semaphores, const uint64_t* values, uint32_t count, uint64_t timeout);
+    uint64_t GPUQuerySemaphoreValue_Vulkan(GPUSemaphoreID semaphore);
 
     //render pass
     GPURenderPassEncoderID GPUCmdBeginRenderPass_Vulkan(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc);
     void GPUCmdEndRenderPass_Vulkan(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder);
+    GPURenderPassEncoderID GPUCmdBeginRenderBundle_Vulkan(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc);
+    void GPUCmdEndRenderBundle_Vulkan(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder);
+    void GPURenderEncoderExecuteBundles_Vulkan(GPURenderPassEncoderID encoder, const GPUCommandBufferID* bundles, uint32_t count);
     void GPURenderEncoderSetViewport_Vulkan(GPURenderPassEncoderID encoder, float x, float y, float width, float height, float min_depth, float max_depth);
     void GPURenderEncoderSetScissor_Vulkan(GPURenderPassEncoderID encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     void GPURenderEncoderBindPipeline_Vulkan(GPURenderPassEncoderID encoder, GPURenderPipelineID pipeline);
+    void GPURenderEncoderSetRasterizerState_Vulkan(GPURenderPassEncoderID encoder, const struct GPURasterizerStateDescriptor* state);
+    void GPURenderEncoderSetDepthState_Vulkan(GPURenderPassEncoderID encoder, const struct GPUDepthStateDesc* state);
+    void GPURenderEncoderSetPrimitiveTopology_Vulkan(GPURenderPassEncoderID encoder, EGPUPrimitiveTopology topology);
     void GPURenderEncoderDraw_Vulkan(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t first_vertex);
+    void GPURenderEncoderDrawInstanced_Vulkan(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance);
     void GPURenderEncoderDrawIndexed_Vulkan(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t firstIndex, uint32_t vertexOffset);
     void GPURenderEncoderDrawIndexedInstanced_Vulkan(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+    void GPURenderEncoderDrawIndirect_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void GPURenderEncoderDrawIndexedIndirect_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride);
+    void GPURenderEncoderDrawIndirectCount_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride);
+    void GPURenderEncoderDrawIndexedIndirectCount_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride);
     void GPURenderEncoderBindVertexBuffers_Vulkan(GPURenderPassEncoderID encoder, uint32_t buffer_count,
                                                   const GPUBufferID* buffers, const uint32_t* strides, const uint32_t* offsets);
     void GPURenderEncoderBindIndexBuffer_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint32_t offset, uint64_t indexStride);
     void GPURenderEncoderBindDescriptorSet_Vulkan(GPURenderPassEncoderID encoder, GPUDescriptorSetID set);
+    void GPURenderEncoderBindDescriptorSetWithOffsets_Vulkan(GPURenderPassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count);
+    void GPURenderEncoderPushConstants_Vulkan(GPURenderPassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data);
+    void GPURenderEncoderPushDescriptorSet_Vulkan(GPURenderPassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count);
+    GPUComputePassEncoderID GPUCmdBeginComputePass_Vulkan(GPUCommandBufferID cmd, const struct GPUComputePassDescriptor* desc);
+    void GPUCmdEndComputePass_Vulkan(GPUCommandBufferID cmd, GPUComputePassEncoderID encoder);
+    void GPUComputeEncoderBindPipeline_Vulkan(GPUComputePassEncoderID encoder, GPUComputePipelineID pipeline);
+    void GPUComputeEncoderBindDescriptorSet_Vulkan(GPUComputePassEncoderID encoder, GPUDescriptorSetID set);
+    void GPUComputeEncoderBindDescriptorSetWithOffsets_Vulkan(GPUComputePassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count);
+    void GPUComputeEncoderPushConstants_Vulkan(GPUComputePassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data);
+    void GPUComputeEncoderPushDescriptorSet_Vulkan(GPUComputePassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count);
+    void GPUComputeEncoderDispatch_Vulkan(GPUComputePassEncoderID encoder, uint32_t x, uint32_t y, uint32_t z);
+    void GPUComputeEncoderDispatchIndirect_Vulkan(GPUComputePassEncoderID encoder, GPUBufferID buffer, uint64_t offset);
 
     //buffer
     GPUBufferID GPUCreateBuffer_Vulkan(GPUDeviceID device, const GPUBufferDescriptor* desc);
@@ -118,6 +158,14 @@ extern "C" {
     void GPUFreeDescriptorSet_Vulkan(GPUDescriptorSetID set);
     void GPUUpdateDescriptorSet_Vulkan(GPUDescriptorSetID set, const GPUDescriptorData* datas, uint32_t count);
 
+    // bindless heap
+    GPUBindlessHeapID GPUCreateBindlessHeap_Vulkan(GPUDeviceID device, const struct GPUBindlessHeapDescriptor* desc);
+    void GPUFreeBindlessHeap_Vulkan(GPUBindlessHeapID heap);
+    uint32_t GPUBindlessHeapAddTexture_Vulkan(GPUBindlessHeapID heap, GPUTextureViewID view, bool writable);
+    uint32_t GPUBindlessHeapAddBuffer_Vulkan(GPUBindlessHeapID heap, GPUBufferID buffer);
+    uint32_t GPUBindlessHeapAddSampler_Vulkan(GPUBindlessHeapID heap, GPUSamplerID sampler);
+    void GPUBindlessHeapRemove_Vulkan(GPUBindlessHeapID heap, EGPUBindlessRange range, uint32_t index);
+
     typedef struct VkUtil_DescriptorPool
     {
         struct GPUDevice_Vulkan* Device;
@@ -161,7 +209,11 @@ extern "C" {
         VkPhysicalDevice pPhysicalDevice;
         VkPhysicalDeviceProperties2KHR physicalDeviceProperties;
         VkPhysicalDeviceFeatures2 physicalDeviceFeatures;
+        VkPhysicalDeviceVulkan12Features physicalDeviceFeatures12;
+        VkPhysicalDeviceVulkan13Features physicalDeviceFeatures13;
         VkPhysicalDeviceSubgroupProperties subgroupProperties;
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorBufferProperties;
+        VkPhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties;
 
         VkQueueFamilyProperties* pQueueFamilyProperties;
         uint32_t queueFamiliesCount;
@@ -175,6 +227,7 @@ extern "C" {
 	} GPUAdapter_Vulkan;
 
     typedef struct VmaAllocator_T* VmaAllocator;
+    typedef struct VmaVirtualAllocation_T* VmaVirtualAllocation;
 	typedef struct GPUDevice_Vulkan
 	{
         GPUDevice spuer;
@@ -182,17 +235,28 @@ extern "C" {
         VkUtil_DescriptorPool* pDescriptorPool;
         struct VolkDeviceTable mVkDeviceTable;
         struct GPUVkPassTable* pPassTable;
+        struct GPUVkTransitionTable* pTransitionTable;
         VmaAllocator pVmaAllocator;
+        struct GPUVkDescriptorHeap* pDescriptorHeap; // descriptor buffer mode only
+        struct GPUVkShaderCache* pShaderCache;
+        struct GPUVkPipelineLibraryCache* pPipelineLibraries; // vertex input and fragment output parts
+        bool bufferDeviceAddress;
+        bool bindless;
+        bool graphicsPipelineLibrary;
+        bool extendedDynamicState;  // cull, front face, topology, depth and stencil tests
+        bool extendedDynamicState2; // depth bias enable
+        bool extendedDynamicState3; // polygon mode and depth clamp
 	} GPUDevice_Vulkan;
 
 	typedef struct GPUQueue_Vulkan
 	{
-        const GPUQueue super;
+        GPUQueue super;
         VkQueue pQueue;
         uint32_t queueFamilyIndex;// Cmd pool for inner usage like resource transition
-        GPUCommandPoolID pInnerCmdPool;
-        GPUCommandBufferID pInnerCmdBuffer;
-        GPUFenceID pInnerFence;
+        GPUCommandPoolID pInnerCmdPools[GPU_VK_INNER_CMD_COUNT];
+        GPUCommandBufferID pInnerCmdBuffers[GPU_VK_INNER_CMD_COUNT];
+        uint64_t innerCmdSubmissions[GPU_VK_INNER_CMD_COUNT];
+        uint32_t innerCmdIndex;
 	} GPUQueue_Vulkan;
 
 	typedef struct GPUSwapchain_Vulkan {
@@ -226,6 +290,7 @@ extern "C" {
         GPUShaderLibrary super;
         VkShaderModule pShader;
         struct SpvReflectShaderModule* pReflect;
+        struct GPUVkCachedShader* pCached; // module and reflection are owned by the device shader cache
     } GPUShaderLibrary_Vulkan;
 
     typedef struct SetLayout_Vulkan
@@ -234,6 +299,16 @@ extern "C" {
         VkDescriptorUpdateTemplate pUpdateTemplate;
         uint32_t updateEntriesCount;
         VkDescriptorSet pEmptyDescSet;
+        uint64_t hash; // of the bindings, equal hashes are compatible layouts
+        uint32_t dynamicOffsetCount;
+        uint32_t storageDynamicOffsetMask; // bit i set when dynamic offset i belongs to a storage buffer
+        // descriptor buffer mode, the empty set also carries the static samplers new sets copy
+        VkDeviceSize descriptorSize;
+        VkDeviceSize* pBindingOffsets;
+        uint32_t bindingOffsetCount;
+        VkDeviceSize emptyOffset;
+        bool samplerDescriptors; // placed where sampler descriptor buffer bindings can address it
+        VmaVirtualAllocation pEmptyAllocation;
     } SetLayout_Vulkan;
 
     typedef struct GPURootSignature_Vulkan
@@ -244,6 +319,7 @@ extern "C" {
         VkDescriptorSetLayout* pVkSetLayouts;
         uint32_t setLayoutsCount;
         VkPushConstantRange* pPushConstantRanges;
+        struct GPUVkPipelineLibraryCache* pPipelineLibraries; // shader parts, they are built with the layout
     } GPURootSignature_Vulkan;
 
     typedef struct VulkanRenderPassDescriptor
@@ -260,25 +336,79 @@ extern "C" {
         EGPUStoreAction stencilStoreOp;
     } VulkanRenderPassDescriptor;
 
+    // the render states that extended dynamic state moves out of the pipeline,
+    // stencil masks and depth bias factors stay baked
+    typedef struct GPUVkDynamicState
+    {
+        VkCullModeFlags cullMode;
+        VkFrontFace frontFace;
+        VkPrimitiveTopology topology;
+        VkPolygonMode polygonMode;
+        VkBool32 depthClamp;
+        VkBool32 depthBias;
+        VkBool32 depthTest;
+        VkBool32 depthWrite;
+        VkCompareOp depthCompareOp;
+        VkBool32 stencilTest;
+        VkStencilOpState front; // ops only
+        VkStencilOpState back;  // ops only
+    } GPUVkDynamicState;
+
     typedef struct GPURenderPipeline_Vulkan
     {
         GPURenderPipeline super;
         VkPipeline pPipeline;
+        GPUVkDynamicState dynamicState; // restored on bind when the device uses extended dynamic state
     } GPURenderPipeline_Vulkan;
 
+    typedef struct GPUComputePipeline_Vulkan
+    {
+        GPUComputePipeline super;
+        VkPipeline pPipeline;
+    } GPUComputePipeline_Vulkan;
+
     typedef struct GPUCommandPool_Vulkan
     {
         GPUCommandPool super;
         VkCommandPool pPool;
     } GPUCommandPool_Vulkan;
 
+    // what the encoder last handed to vulkan, identical binds are dropped against it
+    typedef struct GPUVkBoundState
+    {
+        VkPipeline pPipeline;
+        const GPURootSignature_Vulkan* pRootSignature;
+        VkDescriptorSet pSets[GPU_VK_MAX_BOUND_SETS];
+        VkDeviceSize setOffsets[GPU_VK_MAX_BOUND_SETS]; // descriptor buffer mode
+        uint32_t dynamicOffsets[GPU_VK_MAX_BOUND_SETS][GPU_VK_MAX_DYNAMIC_OFFSETS];
+        uint32_t boundSets;
+        uint32_t dirtySets;
+        VkBuffer pVertexBuffers[GPU_VK_MAX_VERTEX_BINDINGS];
+        VkDeviceSize vertexOffsets[GPU_VK_MAX_VERTEX_BINDINGS];
+        uint32_t vertexBufferCount;
+        VkBuffer pIndexBuffer;
+        VkDeviceSize indexOffset;
+        VkIndexType indexType;
+        VkViewport viewport;
+        VkRect2D scissor;
+        VkPipelineBindPoint bindPoint;
+        GPUVkDynamicState dynamicState;
+        uint32_t viewportValid : 1;
+        uint32_t scissorValid : 1;
+        uint32_t bindPointValid : 1;
+        uint32_t descriptorHeapBound : 1;
+        uint32_t dynamicStateValid : 1;
+    } GPUVkBoundState;
+
     typedef struct GPUCommandBuffer_Vulkan
     {
         GPUCommandBuffer super;
         VkCommandBuffer pVkCmd;
-        VkPipelineLayout pLayout;
         VkRenderPass pPass;
         uint32_t type;
+        bool secondary;
+        bool bundled; // the open pass takes only secondary command buffers
+        GPUVkBoundState bound;
     } GPUCommandBuffer_Vulkan;
 
     typedef struct GPUBuffer_Vulkan {
@@ -325,8 +455,21 @@ extern "C" {
         GPUDescriptorSet super;
         VkDescriptorSet pSet;
         union VkDescriptorUpdateData* pUpdateData;
+        // descriptor buffer mode
+        VkDeviceSize mHeapOffset;
+        VmaVirtualAllocation pHeapAllocation;
     } GPUDescriptorSet_Vulkan;
 
+    typedef struct GPUBindlessHeap_Vulkan
+    {
+        GPUBindlessHeap super;
+        VkDescriptorPool pPool;
+        VkDescriptorSetLayout pLayout;
+        VkDescriptorSet pSet;
+        uint64_t hash; // of the bindings, like SetLayout_Vulkan::hash
+        struct GPUVkBindlessSlots* pSlots;
+    } GPUBindlessHeap_Vulkan;
+
 #ifdef __cplusplus
 }
 #endif //__cplusplus end extern "C" }
@@ -24,7 +24,6 @@ extern "C" {
     void VulkanUtil_EnumFormatSupport(GPUAdapter_Vulkan* pAdapter);
     void VulkanUtil_RecordAdaptorDetail(GPUAdapter_Vulkan* pAdapter);
 
-    uint32_t VulkanUtil_BitSizeOfBlock(EGPUFormat format);
     VkSampleCountFlagBits VulkanUtil_SampleCountToVk(EGPUSampleCount sampleCount);
     VkPrimitiveTopology VulkanUtil_PrimitiveTopologyToVk(EGPUPrimitiveTopology topology);
     VkCompareOp VulkanUtil_CompareOpToVk(EGPUCompareMode compareMode);
@@ -112,6 +111,15 @@ extern "C" {
         return VK_DESCRIPTOR_TYPE_MAX_ENUM;
     }
 
+    inline static VkDescriptorType VulkanUtil_TranslateShaderResourceType(const GPUShaderResource* resource)
+    {
+        const VkDescriptorType type = VulkanUtil_TranslateResourceType(resource->type);
+        if (!resource->dynamic_offset) return type;
+        if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        if (type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        return type;
+    }
+
     inline static VkAccessFlags VulkanUtil_ResourceStateToVkAccessFlags(EGPUResourceState state)
     {
         VkAccessFlags ret = 0;
@@ -255,6 +263,68 @@ extern "C" {
         return flags;
     }
 
+    // per resource stage mask for synchronization2 barriers, finer than DeterminePipelineStageFlags which works on merged access flags
+    inline static VkPipelineStageFlags2 VulkanUtil_ResourceStateToPipelineStage2(EGPUResourceState state, EGPUQueueType queue_type)
+    {
+        if (state == GPU_RESOURCE_STATE_UNDEFINED) return VK_PIPELINE_STAGE_2_NONE;
+        // must chain with the acquire semaphore wait, whatever stage that waited on
+        if (state == GPU_RESOURCE_STATE_PRESENT) return VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        if (state & GPU_RESOURCE_STATE_COMMON) return VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        // the access mask still follows the state, only copies pair with the transfer stages
+        if (queue_type == GPU_QUEUE_TYPE_TRANSFER)
+        {
+            const bool copyOnly = !(state & ~(GPU_RESOURCE_STATE_COPY_SOURCE | GPU_RESOURCE_STATE_COPY_DEST));
+            return copyOnly ? VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        }
+
+        VkPipelineStageFlags2 flags = 0;
+        if (queue_type == GPU_QUEUE_TYPE_GRAPHICS)
+        {
+            if (state & GPU_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER)
+                flags |= VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+                         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            if (state & GPU_RESOURCE_STATE_INDEX_BUFFER)
+                flags |= VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+            if (state & (GPU_RESOURCE_STATE_RENDER_TARGET | GPU_RESOURCE_STATE_RESOLVE_DEST))
+                flags |= VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            if (state & (GPU_RESOURCE_STATE_DEPTH_WRITE | GPU_RESOURCE_STATE_DEPTH_READ))
+                flags |= VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+            if (state & GPU_RESOURCE_STATE_UNORDERED_ACCESS)
+                flags |= VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            if (state & GPU_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE)
+                flags |= VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            if (state & GPU_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+                flags |= VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+            if (state & GPU_RESOURCE_STATE_SHADING_RATE_SOURCE)
+                flags |= VK_PIPELINE_STAGE_2_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
+        }
+        else
+        {
+            if (state & (GPU_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER | GPU_RESOURCE_STATE_UNORDERED_ACCESS | GPU_RESOURCE_STATE_SHADER_RESOURCE))
+                flags |= VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            if (state & (GPU_RESOURCE_STATE_INDEX_BUFFER | GPU_RESOURCE_STATE_RENDER_TARGET | GPU_RESOURCE_STATE_RESOLVE_DEST |
+                         GPU_RESOURCE_STATE_DEPTH_WRITE | GPU_RESOURCE_STATE_DEPTH_READ | GPU_RESOURCE_STATE_SHADING_RATE_SOURCE))
+                return VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        }
+        if (state & GPU_RESOURCE_STATE_INDIRECT_ARGUMENT)
+            flags |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+        if (state & (GPU_RESOURCE_STATE_COPY_SOURCE | GPU_RESOURCE_STATE_COPY_DEST))
+            flags |= VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+        if (state & GPU_RESOURCE_STATE_ACCELERATION_STRUCTURE)
+            flags |= VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        if (flags == 0)
+            flags = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        return flags;
+    }
+
+    inline static VkPipelineStageFlags2 VulkanUtil_PipelineStagesToVk(GPUPipelineStages stages)
+    {
+        // EGPUPipelineStage mirrors the vulkan bits, which are shared by VkPipelineStageFlags and VkPipelineStageFlags2
+        if (stages == GPU_PIPELINE_STAGE_NONE) return VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        return (VkPipelineStageFlags2)stages;
+    }
+
     inline static VkImageAspectFlags VulkanUtil_DeterminAspectMask(VkFormat format, bool includeStencilBit)
     {
         VkImageAspectFlags result = 0;
@@ -308,6 +378,25 @@ extern "C" {
         //VK_KHR_MAINTENANCE1_EXTENSION_NAME // Vulkan NDC fixed, vk 1.0
 #if VK_KHR_device_group
         , VK_KHR_DEVICE_GROUP_EXTENSION_NAME
+#endif
+#if VK_EXT_descriptor_buffer
+        , VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME
+#endif
+#if VK_KHR_push_descriptor
+        , VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME
+#endif
+#if VK_KHR_pipeline_library && VK_EXT_graphics_pipeline_library
+        , VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME
+        , VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME
+#endif
+#if VK_EXT_extended_dynamic_state
+        , VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME
+#endif
+#if VK_EXT_extended_dynamic_state2
+        , VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME
+#endif
+#if VK_EXT_extended_dynamic_state3
+        , VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME
 #endif
     };
 
@@ -373,7 +462,7 @@ extern "C" {
         { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 8192 },
         { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1024 },
         { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1024 },
-        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1024 },
         { VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1 },
     };
 
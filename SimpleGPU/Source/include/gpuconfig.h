@@ -1,5 +1,13 @@
 #pragma once
 #define GPU_USE_VULKAN
+// the GPU* entry points call the vulkan backend directly instead of through the proc table,
+// vulkan is the only backend then and the runtime backend selection is gone
+// #define GPU_STATIC_BACKEND_VULKAN
+
+#ifndef GPU_STATIC_BACKEND_VULKAN
+    // headless backend without a driver, for tests and cpu side benchmarks
+    #define GPU_USE_NULL
+#endif
 
 #ifndef gpu_max
     #define gpu_max(a, b) (((a) > (b)) ? (a) : (b))
@@ -22,12 +22,24 @@ public:
     void Finalize();
     void ResetOnStart();
     void Commit(GPUQueueID gfxQueue, uint64_t frameIndex);
+    // returns the bundle cached for key, or allocates an empty one and sets recorded to false
+    GPUCommandBufferID FindOrAllocateBundle(uint64_t key, uint64_t frameIndex, bool* recorded);
+    // frees the bundles the last execution did not replay, their last submission has finished
+    void PurgeBundles(uint64_t frameIndex);
 private:
+    struct CachedBundle
+    {
+        GPUCommandBufferID bundle;
+        uint64_t lastFrame;
+    };
+
     GPUCommandPoolID m_pCommandPool = nullptr;
     GPUCommandBufferID m_pCmd       = nullptr;
-    GPUFenceID m_pFence             = nullptr;
+    uint64_t mSubmission            = 0; // value of gfxQueue->submitCount after Commit
     uint64_t mExecFrame             = 0;
     std::unordered_map<GPURootSignatureID, BindTablePool*> mBindTablePools;
+    GPUCommandPoolID m_pBundlePool  = nullptr; // never reset, the bundles outlive the frame
+    std::unordered_map<uint64_t, CachedBundle> mBundles;
 };
 
 class RenderGraphBackend : public RenderGraph
@@ -50,6 +62,9 @@ private:
         std::vector<GPUBufferBarrier>& buffer_barriers, std::vector<std::pair<BufferHandle, GPUBufferID>>& resolved_buffers);
     GPUTextureID Resolve(RenderGraphFrameExecutor& executor, const TextureNode& texture);
     GPUBufferID Resolve(RenderGraphFrameExecutor& executor, const BufferNode& buffer);
+    uint64_t CalculateRecordingKey(RenderPassNode* pass, const GPURenderPassDescriptor& desc, GPUBindTableID bind_table,
+        const std::vector<std::pair<TextureHandle, GPUTextureID>>& resolved_textures,
+        const std::vector<std::pair<BufferHandle, GPUBufferID>>& resolved_buffers) const;
     GPUBindTableID AllocateAndUpdatePassBindTable(RenderGraphFrameExecutor& executor, PassNode* pass, GPURootSignatureID root_sig);
     const GPUShaderResource* FindShaderResource(uint64_t nameHash, GPURootSignatureID rs, EGPUResourceType* type = nullptr) const;
     void DeallocaResources(PassNode* pass);
@@ -2,6 +2,7 @@
 
 #include "render_graph/include/DependencyGraph.hpp"
 #include "api.h"
+#include "GPUDrawList.hpp"
 #include <stdint.h>
 #include <string>
 #include <functional>
@@ -307,7 +308,24 @@ struct PassContext
 struct RenderPassContext : public PassContext
 {
     GPURenderPassEncoderID m_pEncoder;
+    GPURootSignatureID m_pRootSignature;
     const struct GPUBindTable* m_pBindTable;
+
+    // per-draw constants go through the pass root signature instead of a descriptor write
+    void PushConstants(const char8_t* name, const void* data) const
+    {
+        GPURenderEncoderPushConstants(m_pEncoder, m_pRootSignature, name, data);
+    }
+
+    // sorted and instanced replay, draws without a bind table use the one of the pass
+    GPUDrawListStats Submit(GPUDrawListID list, GPUBufferID instance_buffer = nullptr, uint64_t instance_offset = 0) const
+    {
+        GPUDrawListReplayDescriptor desc{};
+        desc.default_bind_table = m_pBindTable;
+        desc.instance_buffer    = instance_buffer;
+        desc.instance_offset    = instance_offset;
+        return GPUDrawListReplay(list, m_pEncoder, &desc);
+    }
 };
 
 struct CopyPassContext : public PassContext
@@ -63,6 +63,7 @@ private:
     EGPULoadAction mStencilLoadAction;
     EGPUStoreAction mStencilStoreAction;
     float mClearDepth;
+    bool mCacheRecording = false;
 };
 
 class PresentPassNode : public PassNode
@@ -49,9 +49,14 @@ public:
         RenderPassBuilder& SetName(const char* name);
         RenderPassBuilder& Write(uint32_t mrtIndex, TextureRTVHandle handle, EGPULoadAction load, EGPUStoreAction store);
         RenderPassBuilder& Read(const char* name, TextureSRVHandle handle);
+        // indirect arguments or draw count consumed by the pass's DrawIndirect calls
+        RenderPassBuilder& ReadIndirect(BufferRangeHandle handle);
         RenderPassBuilder& SetRootSignature(GPURootSignatureID rs);
         RenderPassBuilder& SetPipeline(GPURenderPipelineID pipeline);
         RenderPassBuilder& SetDepthStencil(TextureDSVHandle handle, EGPULoadAction depthLoad, EGPUStoreAction depthStore, EGPULoadAction stencilLoad, EGPUStoreAction stencilStore);
+        // record the pass once into a bundle and replay it while the pipeline, bind table and resolved
+        // resources stay the same. Only for passes that draw the same thing every frame
+        RenderPassBuilder& CacheRecording();
         //pipeline
     private:
         RenderGraph& mGraph;
@@ -111,6 +116,7 @@ public:
         BufferBuilder& AsVertexBuffer();
         BufferBuilder& AsIndexBuffer();
         BufferBuilder& AsUniformBuffer();
+        BufferBuilder& AsIndirectBuffer();
         BufferBuilder& PreferOnDevice();
         BufferBuilder& PreferOnHost();
 
@@ -4,9 +4,11 @@
 #include "render_graph/include/frontend/ResourceNode.hpp"
 #include "render_graph/include/frontend/NodeAndEdgeFactory.hpp"
 #include "Utils.h"
+#include "hash.h"
 #include <iostream>
 #include <stdint.h>
 #include <vector>
+#include <cstring>
 #include <assert.h>
 
 //////////////////RenderGraphFrameExecutor////////////////////////
@@ -16,17 +18,23 @@ void RenderGraphFrameExecutor::Initialize(GPUDeviceID gfxDevice, GPUQueueID gfxQ
     GPUCommandBufferDescriptor desc = {};
     desc.isSecondary                = false;
     m_pCmd                          = GPUCreateCommandBuffer(m_pCommandPool, &desc);
-    m_pFence                        = GPUCreateFence(gfxDevice);
+    m_pBundlePool                   = GPUCreateCommandPool(gfxQueue);
+    mSubmission                     = 0;
 }
 
 void RenderGraphFrameExecutor::Finalize()
 {
     if (m_pCmd) GPUFreeCommandBuffer(m_pCmd);
     if (m_pCommandPool) GPUFreeCommandPool(m_pCommandPool);
-    if (m_pFence) GPUFreeFence(m_pFence);
     m_pCommandPool = nullptr;
     m_pCmd         = nullptr;
-    m_pFence       = nullptr;
+    for (auto& iter : mBundles)
+    {
+        GPUFreeCommandBuffer(iter.second.bundle);
+    }
+    mBundles.clear();
+    if (m_pBundlePool) GPUFreeCommandPool(m_pBundlePool);
+    m_pBundlePool = nullptr;
     for (auto iter : mBindTablePools)
     {
         if (iter.second)
@@ -52,11 +60,45 @@ void RenderGraphFrameExecutor::Commit(GPUQueueID gfxQueue, uint64_t frameIndex)
 {
     // submit
     GPUQueueSubmitDescriptor submitDesc{};
-    submitDesc.cmds         = &m_pCmd;
-    submitDesc.cmds_count   = 1;
-    submitDesc.signal_fence = m_pFence;
+    submitDesc.cmds       = &m_pCmd;
+    submitDesc.cmds_count = 1;
     GPUSubmitQueue(gfxQueue, &submitDesc);
-    mExecFrame = frameIndex;
+    mSubmission = gfxQueue->submitCount;
+    mExecFrame  = frameIndex;
+}
+
+GPUCommandBufferID RenderGraphFrameExecutor::FindOrAllocateBundle(uint64_t key, uint64_t frameIndex, bool* recorded)
+{
+    auto iter = mBundles.find(key);
+    if (iter != mBundles.end())
+    {
+        iter->second.lastFrame = frameIndex;
+        *recorded              = true;
+        return iter->second.bundle;
+    }
+    GPUCommandBufferDescriptor desc = {};
+    desc.isSecondary                = true;
+    GPUCommandBufferID bundle       = GPUCreateCommandBuffer(m_pBundlePool, &desc);
+    mBundles[key]                   = { bundle, frameIndex };
+    *recorded                       = false;
+    return bundle;
+}
+
+void RenderGraphFrameExecutor::PurgeBundles(uint64_t frameIndex)
+{
+    // a stale bundle's bind table may be handed to another pass and rewritten, so it can not be kept
+    for (auto iter = mBundles.begin(); iter != mBundles.end();)
+    {
+        if (iter->second.lastFrame != frameIndex)
+        {
+            GPUFreeCommandBuffer(iter->second.bundle);
+            iter = mBundles.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
 }
 //////////////////RenderGraphFrameExecutor////////////////////////
 
@@ -73,7 +115,7 @@ uint64_t RenderGraphBackend::Execute()
 
     uint32_t frameIndex = mFrameIndex % RG_MAX_FRAME_IN_FLIGHT;
     auto& executor = mExecutors[frameIndex];
-    GPUWaitFences(&executor.m_pFence, 1);
+    GPUWaitQueueSubmission(m_pQueue, executor.mSubmission, UINT64_MAX);
 
     executor.ResetOnStart();
     GPUCmdBegin(executor.m_pCmd);
@@ -97,8 +139,9 @@ uint64_t RenderGraphBackend::Execute()
     GPUCmdEnd(executor.m_pCmd);
     {
         //submit
-        executor.Commit(m_pQueue, frameIndex);
+        executor.Commit(m_pQueue, mFrameIndex);
     }
+    executor.PurgeBundles(mFrameIndex);
 
     //clear
     {
@@ -190,6 +233,7 @@ void RenderGraphBackend::ExecuteRenderPass(RenderPassNode* pass,  RenderGraphFra
     passContext.m_pGraph          = this;
     passContext.mResolvedBuffers  = resolved_buffers;
     passContext.mResolvedTextures = resolved_textures;
+    passContext.m_pRootSignature  = pass->m_pRootSignature;
     passContext.m_pBindTable      = AllocateAndUpdatePassBindTable(executor, pass, pass->m_pRootSignature);
     //call gpu aip
     GPUResourceBarrierDescriptor barrier_desc{};
@@ -198,6 +242,11 @@ void RenderGraphBackend::ExecuteRenderPass(RenderPassNode* pass,  RenderGraphFra
         barrier_desc.texture_barriers = tex_barriers.data();
         barrier_desc.texture_barriers_count = (uint32_t)tex_barriers.size();
     }
+    if (!buffer_barriers.empty())
+    {
+        barrier_desc.buffer_barriers       = buffer_barriers.data();
+        barrier_desc.buffer_barriers_count = (uint32_t)buffer_barriers.size();
+    }
     GPUCmdResourceBarrier(executor.m_pCmd, &barrier_desc);
 
     {
@@ -259,18 +308,68 @@ void RenderGraphBackend::ExecuteRenderPass(RenderPassNode* pass,  RenderGraphFra
         render_pass_desc.color_attachments   = attachments.data();
         render_pass_desc.render_target_count = (uint32_t)attachments.size();
         render_pass_desc.depth_stencil       = &ds_attachment;
-        passContext.m_pEncoder = GPUCmdBeginRenderPass(executor.m_pCmd, &render_pass_desc);
+        if (pass->mCacheRecording)
         {
-            if (pass->m_pPipeline) GPURenderEncoderBindPipeline(passContext.m_pEncoder, pass->m_pPipeline);
-            if (passContext.m_pEncoder) GPURenderEncoderBindBindTable(passContext.m_pEncoder, passContext.m_pBindTable);
-            pass->mExecuteFunc(*this, passContext);
+            const uint64_t key        = CalculateRecordingKey(pass, render_pass_desc, passContext.m_pBindTable, resolved_textures, resolved_buffers);
+            bool recorded             = false;
+            GPUCommandBufferID bundle = executor.FindOrAllocateBundle(key, mFrameIndex, &recorded);
+            if (!recorded)
+            {
+                passContext.m_pCmd     = bundle;
+                passContext.m_pEncoder = GPUCmdBeginRenderBundle(bundle, &render_pass_desc);
+                {
+                    if (pass->m_pPipeline) GPURenderEncoderBindPipeline(passContext.m_pEncoder, pass->m_pPipeline);
+                    if (passContext.m_pEncoder) GPURenderEncoderBindBindTable(passContext.m_pEncoder, passContext.m_pBindTable);
+                    pass->mExecuteFunc(*this, passContext);
+                }
+                GPUCmdEndRenderBundle(bundle, passContext.m_pEncoder);
+            }
+            render_pass_desc.bundled       = true;
+            GPURenderPassEncoderID encoder = GPUCmdBeginRenderPass(executor.m_pCmd, &render_pass_desc);
+            GPURenderEncoderExecuteBundles(encoder, &bundle, 1);
+            GPUCmdEndRenderPass(executor.m_pCmd, encoder);
+        }
+        else
+        {
+            passContext.m_pEncoder = GPUCmdBeginRenderPass(executor.m_pCmd, &render_pass_desc);
+            {
+                if (pass->m_pPipeline) GPURenderEncoderBindPipeline(passContext.m_pEncoder, pass->m_pPipeline);
+                if (passContext.m_pEncoder) GPURenderEncoderBindBindTable(passContext.m_pEncoder, passContext.m_pBindTable);
+                pass->mExecuteFunc(*this, passContext);
+            }
+            GPUCmdEndRenderPass(executor.m_pCmd, passContext.m_pEncoder);
         }
-        GPUCmdEndRenderPass(executor.m_pCmd, passContext.m_pEncoder);
     }
     //deallace resource
     DeallocaResources(pass);
 }
 
+uint64_t RenderGraphBackend::CalculateRecordingKey(RenderPassNode* pass, const GPURenderPassDescriptor& desc, GPUBindTableID bind_table,
+    const std::vector<std::pair<TextureHandle, GPUTextureID>>& resolved_textures,
+    const std::vector<std::pair<BufferHandle, GPUBufferID>>& resolved_buffers) const
+{
+    // pooled views and bind tables come back the same while the resources do, so the ids identify the recording
+    std::vector<uint64_t> ids;
+    ids.reserve(3 + desc.render_target_count + resolved_textures.size() + resolved_buffers.size());
+    ids.emplace_back((uint64_t)pass->m_pPipeline);
+    ids.emplace_back((uint64_t)bind_table);
+    ids.emplace_back((uint64_t)desc.depth_stencil->view);
+    for (uint32_t i = 0; i < desc.render_target_count; i++)
+    {
+        ids.emplace_back((uint64_t)desc.color_attachments[i].view);
+    }
+    for (const auto& iter : resolved_textures)
+    {
+        ids.emplace_back((uint64_t)iter.second);
+    }
+    for (const auto& iter : resolved_buffers)
+    {
+        ids.emplace_back((uint64_t)iter.second);
+    }
+    const char* name = pass->GetName();
+    return Hash64(ids.data(), ids.size() * sizeof(uint64_t), Hash64(name, strlen(name), (size_t)m_pDevice));
+}
+
 void RenderGraphBackend::ExectuePresentPass(PresentPassNode* pass, RenderGraphFrameExecutor& executor)
 {
     auto edges = pass->GetTextureReadEdges();
@@ -342,47 +441,90 @@ void RenderGraphBackend::ExectueCopyPass(CopyPassNode* pass, RenderGraphFrameExe
         }
     }
     GPUCmdResourceBarrier(executor.m_pCmd, &barriers);
+    // one copy command per (src, dst) pair, regions keep their recording order
+    std::vector<GPUTextureToTextureRegions> t2ts;
+    std::vector<std::vector<GPUTextureToTextureRegion>> t2tRegions;
     for (uint32_t i = 0; i < pass->mT2Ts.size(); i++)
     {
         auto src_node = RenderGraph::Resolve(pass->mT2Ts[i].first);
         auto dst_node = RenderGraph::Resolve(pass->mT2Ts[i].second);
-        GPUTextureToTextureTransfer t2t      = {};
-        t2t.src                              = Resolve(executor, *src_node);
-        t2t.src_subresource.aspects          = pass->mT2Ts[i].first.aspects;
-        t2t.src_subresource.mip_level        = pass->mT2Ts[i].first.mip_level;
-        t2t.src_subresource.base_array_layer = pass->mT2Ts[i].first.array_base;
-        t2t.src_subresource.layer_count      = pass->mT2Ts[i].first.array_count;
-        t2t.dst                              = Resolve(executor, *dst_node);
-        t2t.dst_subresource.aspects          = pass->mT2Ts[i].second.aspects;
-        t2t.dst_subresource.mip_level        = pass->mT2Ts[i].second.mip_level;
-        t2t.dst_subresource.base_array_layer = pass->mT2Ts[i].second.array_base;
-        t2t.dst_subresource.layer_count      = pass->mT2Ts[i].second.array_count;
-        GPUCmdTransferTextureToTexture(executor.m_pCmd, &t2t);
+        GPUTextureID src = Resolve(executor, *src_node);
+        GPUTextureID dst = Resolve(executor, *dst_node);
+        uint32_t batch   = 0;
+        while (batch < t2ts.size() && (t2ts[batch].src != src || t2ts[batch].dst != dst)) batch++;
+        if (batch == t2ts.size())
+        {
+            t2ts.push_back({ src, dst, nullptr, 0 });
+            t2tRegions.emplace_back();
+        }
+        GPUTextureToTextureRegion& region       = t2tRegions[batch].emplace_back();
+        region.src_subresource.aspects          = pass->mT2Ts[i].first.aspects;
+        region.src_subresource.mip_level        = pass->mT2Ts[i].first.mip_level;
+        region.src_subresource.base_array_layer = pass->mT2Ts[i].first.array_base;
+        region.src_subresource.layer_count      = pass->mT2Ts[i].first.array_count;
+        region.dst_subresource.aspects          = pass->mT2Ts[i].second.aspects;
+        region.dst_subresource.mip_level        = pass->mT2Ts[i].second.mip_level;
+        region.dst_subresource.base_array_layer = pass->mT2Ts[i].second.array_base;
+        region.dst_subresource.layer_count      = pass->mT2Ts[i].second.array_count;
+    }
+    for (uint32_t i = 0; i < t2ts.size(); i++)
+    {
+        t2ts[i].regions       = t2tRegions[i].data();
+        t2ts[i].regions_count = (uint32_t)t2tRegions[i].size();
+        GPUCmdTransferTextureToTextureRegions(executor.m_pCmd, &t2ts[i]);
     }
+    std::vector<GPUBufferToBufferRegions> b2bs;
+    std::vector<std::vector<GPUBufferToBufferRegion>> b2bRegions;
     for (uint32_t i = 0; i < pass->mB2Bs.size(); i++)
     {
         auto src_node = RenderGraph::Resolve(pass->mB2Bs[i].first);
         auto dst_node = RenderGraph::Resolve(pass->mB2Bs[i].second);
-        GPUBufferToBufferTransfer b2b = {};
-        b2b.src                       = Resolve(executor, *src_node);
-        b2b.src_offset                = pass->mB2Bs[i].first.mFrom;
-        b2b.dst                       = Resolve(executor, *dst_node);
-        b2b.dst_offset                = pass->mB2Bs[i].second.mFrom;
-        b2b.size                      = pass->mB2Bs[i].first.mTo - b2b.src_offset;
-        GPUCmdTransferBufferToBuffer(executor.m_pCmd, &b2b);
+        GPUBufferID src = Resolve(executor, *src_node);
+        GPUBufferID dst = Resolve(executor, *dst_node);
+        uint32_t batch  = 0;
+        while (batch < b2bs.size() && (b2bs[batch].src != src || b2bs[batch].dst != dst)) batch++;
+        if (batch == b2bs.size())
+        {
+            b2bs.push_back({ dst, src, nullptr, 0 });
+            b2bRegions.emplace_back();
+        }
+        GPUBufferToBufferRegion& region = b2bRegions[batch].emplace_back();
+        region.src_offset               = pass->mB2Bs[i].first.mFrom;
+        region.dst_offset               = pass->mB2Bs[i].second.mFrom;
+        region.size                     = pass->mB2Bs[i].first.mTo - region.src_offset;
     }
+    for (uint32_t i = 0; i < b2bs.size(); i++)
+    {
+        b2bs[i].regions       = b2bRegions[i].data();
+        b2bs[i].regions_count = (uint32_t)b2bRegions[i].size();
+        GPUCmdTransferBufferToBufferRegions(executor.m_pCmd, &b2bs[i]);
+    }
+    std::vector<GPUBufferToTextureRegions> b2ts;
+    std::vector<std::vector<GPUBufferToTextureRegion>> b2tRegions;
     for (uint32_t i = 0; i < pass->mB2Ts.size(); i++)
     {
-        auto src_node                        = RenderGraph::Resolve(pass->mB2Ts[i].first);
-        auto dst_node                        = RenderGraph::Resolve(pass->mB2Ts[i].second);
-        GPUBufferToTextureTransfer b2t       = {};
-        b2t.src                              = Resolve(executor, *src_node);
-        b2t.src_offset                       = pass->mB2Ts[i].first.mFrom;
-        b2t.dst                              = Resolve(executor, *dst_node);
-        b2t.dst_subresource.mip_level        = pass->mB2Ts[i].second.mip_level;
-        b2t.dst_subresource.base_array_layer = pass->mB2Ts[i].second.array_base;
-        b2t.dst_subresource.layer_count      = pass->mB2Ts[i].second.array_count;
-        GPUCmdTransferBufferToTexture(executor.m_pCmd, &b2t);
+        auto src_node    = RenderGraph::Resolve(pass->mB2Ts[i].first);
+        auto dst_node    = RenderGraph::Resolve(pass->mB2Ts[i].second);
+        GPUBufferID src  = Resolve(executor, *src_node);
+        GPUTextureID dst = Resolve(executor, *dst_node);
+        uint32_t batch   = 0;
+        while (batch < b2ts.size() && (b2ts[batch].src != src || b2ts[batch].dst != dst)) batch++;
+        if (batch == b2ts.size())
+        {
+            b2ts.push_back({ dst, src, nullptr, 0 });
+            b2tRegions.emplace_back();
+        }
+        GPUBufferToTextureRegion& region        = b2tRegions[batch].emplace_back();
+        region.src_offset                       = pass->mB2Ts[i].first.mFrom;
+        region.dst_subresource.mip_level        = pass->mB2Ts[i].second.mip_level;
+        region.dst_subresource.base_array_layer = pass->mB2Ts[i].second.array_base;
+        region.dst_subresource.layer_count      = pass->mB2Ts[i].second.array_count;
+    }
+    for (uint32_t i = 0; i < b2ts.size(); i++)
+    {
+        b2ts[i].regions       = b2tRegions[i].data();
+        b2ts[i].regions_count = (uint32_t)b2tRegions[i].size();
+        GPUCmdTransferBufferToTextureRegions(executor.m_pCmd, &b2ts[i]);
     }
     GPUCmdResourceBarrier(executor.m_pCmd, &late_barriers);
     DeallocaResources(pass);
@@ -573,11 +715,12 @@ uint64_t RenderGraphBackend::GetLatestFinishedFrame()
 {
     if (mFrameIndex < RG_MAX_FRAME_IN_FLIGHT) return 0;
 
-    uint64_t result = mFrameIndex - RG_MAX_FRAME_IN_FLIGHT;
+    uint64_t result    = mFrameIndex - RG_MAX_FRAME_IN_FLIGHT;
+    uint64_t completed = GPUQueueCompletedSubmission(m_pQueue);
     for (auto&& executor : mExecutors)
     {
-        if (!executor.m_pFence) continue;
-        if (GPUQueryFenceStatus(executor.m_pFence) == GPU_FENCE_STATUS_COMPLETE)
+        if (executor.mSubmission == 0) continue;
+        if (executor.mSubmission <= completed)
         {
             result = std::max(result, executor.mExecFrame);
         }
@@ -185,6 +185,14 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::Read(const char*
     return *this;
 }
 
+RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::ReadIndirect(BufferRangeHandle handle)
+{
+    BufferReadEdge* edge = mGraph.m_pNAEFactory->Allocate<BufferReadEdge>("indirect_args", handle, GPU_RESOURCE_STATE_INDIRECT_ARGUMENT);
+    mPassNode.mInBufferEdges.emplace_back(edge);
+    mGraph.m_pGraph->Link(mGraph.m_pGraph->AccessNode(handle.mThis), &mPassNode, edge);
+    return *this;
+}
+
 RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::SetRootSignature(GPURootSignatureID rs)
 {
     mPassNode.m_pRootSignature = rs;
@@ -213,6 +221,12 @@ RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::SetDepthStencil(
     return *this;
 }
 
+RenderGraph::RenderPassBuilder& RenderGraph::RenderPassBuilder::CacheRecording()
+{
+    mPassNode.mCacheRecording = true;
+    return *this;
+}
+
 PassHandle RenderGraph::AddRenderPass(const RenderPassSetupFunc& setup, const RenderPassExecuteFunction& execute)
 {
     uint32_t order          = (uint32_t)mPasses.size();
@@ -408,6 +422,14 @@ RenderGraph::BufferBuilder& RenderGraph::BufferBuilder::AsUniformBuffer()
     return *this;
 }
 
+RenderGraph::BufferBuilder& RenderGraph::BufferBuilder::AsIndirectBuffer()
+{
+    mNode.mDesc.descriptors |= GPU_RESOURCE_TYPE_INDIRECT_BUFFER;
+    // imported buffers keep the state they were handed over in
+    if (!mNode.InImported()) mNode.mDesc.start_state = GPU_RESOURCE_STATE_INDIRECT_ARGUMENT;
+    return *this;
+}
+
 RenderGraph::BufferBuilder& RenderGraph::BufferBuilder::PreferOnDevice()
 {
     mNode.mDesc.prefer_on_device = true;
@@ -1,3 +1,6 @@
 #include "gpuconfig.h"
 
-#include "common/GPUBindTable.cpp"
\ No newline at end of file
+#include "common/GPUBindTable.cpp"
+#include "common/GPUUploader.cpp"
+#include "common/GPUDrawList.cpp"
+#include "common/GPUReflectionBlob.cpp"
\ No newline at end of file
@@ -9,4 +9,8 @@
     #include "d3d12/ProcTable.cpp"
 #endif
 
+#ifdef GPU_USE_NULL
+    #include "null/ProcTable.cpp"
+#endif
+
 #include "common/GPU.cpp"
\ No newline at end of file
@@ -0,0 +1,4 @@
+#include "gpuconfig.h"
+#ifdef GPU_USE_NULL
+    #include "null/GPUNull.cpp"
+#endif
\ No newline at end of file
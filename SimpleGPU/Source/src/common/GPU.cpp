@@ -8,13 +8,27 @@
     #include "backend/d3d12/GPUD3D12.h"
 #endif
 
+#ifdef GPU_USE_NULL
+    #include "backend/null/GPUNull.h"
+#endif
+
 #include <assert.h>
 #include <cstring>
 #include <memory>
 
+#ifdef GPU_STATIC_BACKEND_VULKAN
+    #if defined(GPU_USE_D3D12) || defined(GPU_USE_NULL)
+        #error "GPU_STATIC_BACKEND_VULKAN needs vulkan to be the only backend"
+    #endif
+    // vkTable is a constant of this translation unit, the calls fold into direct calls of the _Vulkan functions
+    #define GPU_PROC(table, name) vkTable.name
+#else
+    #define GPU_PROC(table, name) (table)->name
+#endif
+
 GPUInstanceID GPUCreateInstance(const GPUInstanceDescriptor* pDesc)
 {
-    assert(pDesc->backend == EGPUBackend::GPUBackend_Vulkan);
+    assert(pDesc->backend == EGPUBackend::GPUBackend_Vulkan || pDesc->backend == EGPUBackend::GPUBackend_Null);
 
     const GPUProcTable* pProcTable             = nullptr;
     const GPUSurfacesProcTable* pSurfacesTable = nullptr;
@@ -35,6 +49,12 @@ GPUInstanceID GPUCreateInstance(const GPUInstanceDescriptor* pDesc)
         pProcTable = GPUD3D12ProcTable();
     }
 #endif
+#ifdef GPU_USE_NULL
+    else if (pDesc->backend == GPUBackend_Null)
+    {
+        pProcTable = GPUNullProcTable();
+    }
+#endif
 
     GPUInstance* pInstance       = (GPUInstance*)pProcTable->CreateInstance(pDesc);
     pInstance->pProcTable        = pProcTable;
@@ -46,10 +66,9 @@ GPUInstanceID GPUCreateInstance(const GPUInstanceDescriptor* pDesc)
 
 void GPUFreeInstance(GPUInstanceID instance)
 {
-    assert(instance->backend == EGPUBackend::GPUBackend_Vulkan);
     assert(instance->pProcTable->FreeInstance);
 
-    instance->pProcTable->FreeInstance(instance);
+    GPU_PROC(instance->pProcTable, FreeInstance)(instance);
 }
 
 void GPUEnumerateAdapters(GPUInstanceID pInstance, GPUAdapterID* const ppAdapters, uint32_t* adapterCount)
@@ -57,7 +76,7 @@ void GPUEnumerateAdapters(GPUInstanceID pInstance, GPUAdapterID* const ppAdapter
     assert(pInstance != NULL);
     assert(pInstance->pProcTable->EnumerateAdapters != NULL);
 
-    pInstance->pProcTable->EnumerateAdapters(pInstance, ppAdapters, adapterCount);
+    GPU_PROC(pInstance->pProcTable, EnumerateAdapters)(pInstance, ppAdapters, adapterCount);
 
     if (ppAdapters != NULL)
     {
@@ -74,7 +93,7 @@ GPUDeviceID GPUCreateDevice(GPUAdapterID pAdapter, const GPUDeviceDescriptor* pD
     assert(pAdapter->pProcTableCache);
     assert(pAdapter->pProcTableCache->CreateDevice);
 
-    GPUDeviceID pDevice = pAdapter->pProcTableCache->CreateDevice(pAdapter, pDesc);
+    GPUDeviceID pDevice = GPU_PROC(pAdapter->pProcTableCache, CreateDevice)(pAdapter, pDesc);
     if (pDevice != nullptr)
     {
         *(const GPUProcTable**)&pDevice->pProcTableCache = pAdapter->pProcTableCache;
@@ -87,7 +106,7 @@ void GPUFreeDevice(GPUDeviceID pDevice)
 {
     assert(pDevice->pProcTableCache);
     assert(pDevice->pProcTableCache->FreeDevice);
-    pDevice->pProcTableCache->FreeDevice(pDevice);
+    GPU_PROC(pDevice->pProcTableCache, FreeDevice)(pDevice);
 }
 
 GPUQueueID GPUGetQueue(GPUDeviceID pDevice, EGPUQueueType queueType, uint32_t queueIndex)
@@ -99,10 +118,11 @@ GPUQueueID GPUGetQueue(GPUDeviceID pDevice, EGPUQueueType queueType, uint32_t qu
     // try find queue
     // if (q) {warning();return q;}
 
-    GPUQueue* pQueue   = (GPUQueue*)pDevice->pProcTableCache->GetQueue(pDevice, queueType, queueIndex);
-    pQueue->pDevice    = pDevice;
-    pQueue->queueType  = queueType;
-    pQueue->queueIndex = queueIndex;
+    GPUQueue* pQueue    = (GPUQueue*)GPU_PROC(pDevice->pProcTableCache, GetQueue)(pDevice, queueType, queueIndex);
+    pQueue->pDevice     = pDevice;
+    pQueue->queueType   = queueType;
+    pQueue->queueIndex  = queueIndex;
+    pQueue->submitCount = 0;
 
     return pQueue;
 }
@@ -112,7 +132,7 @@ void GPUFreeQueue(GPUQueueID queue)
     assert(queue);
     assert(queue->pDevice);
     assert(queue->pDevice->pProcTableCache->FreeQueue);
-    queue->pDevice->pProcTableCache->FreeQueue(queue);
+    GPU_PROC(queue->pDevice->pProcTableCache, FreeQueue)(queue);
 }
 
 void GPUSubmitQueue(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* desc)
@@ -120,7 +140,34 @@ void GPUSubmitQueue(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* des
     assert(queue);
     assert(queue->pDevice);
     assert(queue->pDevice->pProcTableCache->SubmitQueue);
-    queue->pDevice->pProcTableCache->SubmitQueue(queue, desc);
+    // backend signals queue->timeline with the new value
+    ((GPUQueue*)queue)->submitCount++;
+    GPU_PROC(queue->pDevice->pProcTableCache, SubmitQueue)(queue, desc);
+}
+
+void GPUSubmitQueueBatches(GPUQueueID queue, const struct GPUQueueBatchSubmitDescriptor* desc)
+{
+    assert(queue);
+    assert(queue->pDevice);
+    assert(desc && desc->batch_count > 0);
+    assert(queue->pDevice->pProcTableCache->SubmitQueueBatches);
+    ((GPUQueue*)queue)->submitCount++;
+    GPU_PROC(queue->pDevice->pProcTableCache, SubmitQueueBatches)(queue, desc);
+}
+
+uint64_t GPUFlushQueueTransitions(GPUQueueID queue)
+{
+    assert(queue);
+    assert(queue->pDevice);
+    assert(queue->pDevice->pProcTableCache->FlushQueueTransitions);
+    // backends submit against submitCount + 1 and return it, or 0 if nothing was pending
+    const uint64_t submission = GPU_PROC(queue->pDevice->pProcTableCache, FlushQueueTransitions)(queue);
+    if (submission)
+    {
+        assert(submission == queue->submitCount + 1);
+        ((GPUQueue*)queue)->submitCount = submission;
+    }
+    return submission;
 }
 
 void GPUWaitQueueIdle(GPUQueueID queue)
@@ -128,7 +175,7 @@ void GPUWaitQueueIdle(GPUQueueID queue)
     assert(queue);
     assert(queue->pDevice);
     assert(queue->pDevice->pProcTableCache->WaitQueueIdle);
-    queue->pDevice->pProcTableCache->WaitQueueIdle(queue);
+    GPU_PROC(queue->pDevice->pProcTableCache, WaitQueueIdle)(queue);
 }
 
 void GPUQueuePresent(GPUQueueID queue, const struct GPUQueuePresentDescriptor* desc)
@@ -136,7 +183,23 @@ void GPUQueuePresent(GPUQueueID queue, const struct GPUQueuePresentDescriptor* d
     assert(queue);
     assert(queue->pDevice);
     assert(queue->pDevice->pProcTableCache->QueuePresent);
-    queue->pDevice->pProcTableCache->QueuePresent(queue, desc);
+    GPU_PROC(queue->pDevice->pProcTableCache, QueuePresent)(queue, desc);
+}
+
+uint64_t GPUQueueCompletedSubmission(GPUQueueID queue)
+{
+    assert(queue);
+    assert(queue->timeline);
+    return GPUQuerySemaphoreValue(queue->timeline);
+}
+
+bool GPUWaitQueueSubmission(GPUQueueID queue, uint64_t submission, uint64_t timeout)
+{
+    assert(queue);
+    assert(queue->timeline);
+    assert(submission <= queue->submitCount);
+    if (submission == 0) return true;
+    return GPUWaitSemaphores(&queue->timeline, &submission, 1, timeout);
 }
 
 GPUSurfaceID GPUCreateSurfaceFromNativeView(GPUInstanceID pInstance, void* view)
@@ -171,7 +234,7 @@ GPUSwapchainID GPUCreateSwapchain(GPUDeviceID pDevice, GPUSwapchainDescriptor* p
     assert(pDevice);
     assert(pDevice->pProcTableCache->CreateSwapchain);
 
-    GPUSwapchain* pSwapchain = (GPUSwapchain*)pDevice->pProcTableCache->CreateSwapchain(pDevice, pDesc);
+    GPUSwapchain* pSwapchain = (GPUSwapchain*)GPU_PROC(pDevice->pProcTableCache, CreateSwapchain)(pDevice, pDesc);
     pSwapchain->pDevice      = pDevice;
     for (uint32_t i = 0; i < pSwapchain->backBuffersCount; i++)
     {
@@ -186,7 +249,7 @@ void GPUFreeSwapchain(GPUSwapchainID pSwapchain)
     assert(pSwapchain);
     GPUDeviceID pDevice = pSwapchain->pDevice;
     assert(pDevice->pProcTableCache->FreeSwapchain);
-    pDevice->pProcTableCache->FreeSwapchain(pSwapchain);
+    GPU_PROC(pDevice->pProcTableCache, FreeSwapchain)(pSwapchain);
 }
 
 uint32_t GPUAcquireNextImage(GPUSwapchainID swapchain, const struct GPUAcquireNextDescriptor* desc)
@@ -194,7 +257,7 @@ uint32_t GPUAcquireNextImage(GPUSwapchainID swapchain, const struct GPUAcquireNe
     assert(swapchain);
     assert(swapchain->pDevice);
     assert(swapchain->pDevice->pProcTableCache->AcquireNextImage);
-    return swapchain->pDevice->pProcTableCache->AcquireNextImage(swapchain, desc);
+    return GPU_PROC(swapchain->pDevice->pProcTableCache, AcquireNextImage)(swapchain, desc);
 }
 
 GPUTextureViewID GPUCreateTextureView(GPUDeviceID pDevice, const struct GPUTextureViewDescriptor* pDesc)
@@ -203,7 +266,7 @@ GPUTextureViewID GPUCreateTextureView(GPUDeviceID pDevice, const struct GPUTextu
     assert(pDesc);
     assert(pDevice->pProcTableCache->CreateTextureView);
 
-    GPUTextureView* pView = (GPUTextureView*)pDevice->pProcTableCache->CreateTextureView(pDevice, pDesc);
+    GPUTextureView* pView = (GPUTextureView*)GPU_PROC(pDevice->pProcTableCache, CreateTextureView)(pDevice, pDesc);
     pView->pDevice        = pDevice;
     pView->desc           = *pDesc;
 
@@ -215,7 +278,7 @@ void GPUFreeTextureView(GPUTextureViewID pTextureView)
     assert(pTextureView);
     assert(pTextureView->pDevice);
     assert(pTextureView->pDevice->pProcTableCache->FreeTextureView);
-    pTextureView->pDevice->pProcTableCache->FreeTextureView(pTextureView);
+    GPU_PROC(pTextureView->pDevice->pProcTableCache, FreeTextureView)(pTextureView);
 }
 
 GPUTextureID GPUCreateTexture(GPUDeviceID device, const GPUTextureDescriptor* desc)
@@ -228,7 +291,7 @@ GPUTextureID GPUCreateTexture(GPUDeviceID device, const GPUTextureDescriptor* de
     if (desc->mip_levels == 0) new_desc.mip_levels = 1;
     if (desc->depth == 0) new_desc.depth = 1;
     if (desc->sample_count == 0) new_desc.sample_count = (EGPUSampleCount)1;
-    GPUTexture* T  = (GPUTexture*)device->pProcTableCache->CreateTexture(device, &new_desc);
+    GPUTexture* T  = (GPUTexture*)GPU_PROC(device->pProcTableCache, CreateTexture)(device, &new_desc);
     T->pDevice     = device;
     T->sampleCount = desc->sample_count;
     return T;
@@ -239,14 +302,14 @@ void GPUFreeTexture(GPUTextureID texture)
     assert(texture);
     assert(texture->pDevice);
     assert(texture->pDevice->pProcTableCache->FreeTexture);
-    texture->pDevice->pProcTableCache->FreeTexture(texture);
+    GPU_PROC(texture->pDevice->pProcTableCache, FreeTexture)(texture);
 }
 
 GPUShaderLibraryID GPUCreateShaderLibrary(GPUDeviceID pDevice, const GPUShaderLibraryDescriptor* pDesc)
 {
     assert(pDevice);
     assert(pDevice->pProcTableCache->CreateShaderLibrary);
-    GPUShaderLibrary* pShader = (GPUShaderLibrary*)pDevice->pProcTableCache->CreateShaderLibrary(pDevice, pDesc);
+    GPUShaderLibrary* pShader = (GPUShaderLibrary*)GPU_PROC(pDevice->pProcTableCache, CreateShaderLibrary)(pDevice, pDesc);
     pShader->pDevice          = pDevice;
     const size_t str_len      = strlen((const char*)pDesc->pName);
     const size_t str_size     = str_len + 1;
@@ -261,7 +324,7 @@ void GPUFreeShaderLibrary(GPUShaderLibraryID pShader)
     assert(pShader->pDevice);
     assert(pShader->pDevice->pProcTableCache->FreeShaderLibrary);
     free(pShader->name);
-    pShader->pDevice->pProcTableCache->FreeShaderLibrary(pShader);
+    GPU_PROC(pShader->pDevice->pProcTableCache, FreeShaderLibrary)(pShader);
 }
 
 static const GPUDepthStateDesc sDefaultDepthState = {
@@ -301,7 +364,7 @@ GPURenderPipelineID GPUCreateRenderPipeline(GPUDeviceID pDevice, const GPURender
     if (pDesc->pDepthState == NULL) newDesc.pDepthState = &sDefaultDepthState;
     if (pDesc->pRasterizerState == NULL) newDesc.pRasterizerState = &sDefaultRasterizerState;
     GPURenderPipeline* pPipeline = NULL;
-    pPipeline                    = (GPURenderPipeline*)pDevice->pProcTableCache->CreateRenderPipeline(pDevice, &newDesc);
+    pPipeline                    = (GPURenderPipeline*)GPU_PROC(pDevice->pProcTableCache, CreateRenderPipeline)(pDevice, &newDesc);
     pPipeline->pDevice           = pDevice;
     pPipeline->pRootSignature    = pDesc->pRootSignature;
     return pPipeline;
@@ -311,12 +374,32 @@ void GPUFreeRenderPipeline(GPURenderPipelineID pPipeline)
 {
     assert(pPipeline);
     assert(pPipeline->pDevice->pProcTableCache->FreeRenderPipeline);
-    pPipeline->pDevice->pProcTableCache->FreeRenderPipeline(pPipeline);
+    GPU_PROC(pPipeline->pDevice->pProcTableCache, FreeRenderPipeline)(pPipeline);
+}
+
+GPUComputePipelineID GPUCreateComputePipeline(GPUDeviceID pDevice, const GPUComputePipelineDescriptor* pDesc)
+{
+    assert(pDevice);
+    assert(pDesc->pRootSignature);
+    assert(pDesc->pComputeShader);
+    assert(pDesc->pRootSignature->pipeline_type == GPU_PIPELINE_TYPE_COMPUTE);
+    assert(pDevice->pProcTableCache->CreateComputePipeline);
+    GPUComputePipeline* pPipeline = (GPUComputePipeline*)GPU_PROC(pDevice->pProcTableCache, CreateComputePipeline)(pDevice, pDesc);
+    pPipeline->pDevice            = pDevice;
+    pPipeline->pRootSignature     = pDesc->pRootSignature;
+    return pPipeline;
+}
+
+void GPUFreeComputePipeline(GPUComputePipelineID pPipeline)
+{
+    assert(pPipeline);
+    assert(pPipeline->pDevice->pProcTableCache->FreeComputePipeline);
+    GPU_PROC(pPipeline->pDevice->pProcTableCache, FreeComputePipeline)(pPipeline);
 }
 
 GPURootSignatureID GPUCreateRootSignature(GPUDeviceID device, const struct GPURootSignatureDescriptor* desc)
 {
-    GPURootSignature* pRST = (GPURootSignature*)device->pProcTableCache->CreateRootSignature(device, desc);
+    GPURootSignature* pRST = (GPURootSignature*)GPU_PROC(device->pProcTableCache, CreateRootSignature)(device, desc);
     pRST->device           = device;
     return pRST;
 }
@@ -326,7 +409,25 @@ void GPUFreeRootSignature(GPURootSignatureID RS)
     assert(RS);
     assert(RS->device);
     assert(RS->device->pProcTableCache->FreeRootSignature);
-    RS->device->pProcTableCache->FreeRootSignature(RS);
+    GPU_PROC(RS->device->pProcTableCache, FreeRootSignature)(RS);
+}
+
+GPURootSignaturePoolID GPUCreateRootSignaturePool(GPUDeviceID device, const struct GPURootSignaturePoolDescriptor* desc)
+{
+    assert(device);
+    assert(device->pProcTableCache->CreateRootSignaturePool);
+    GPURootSignaturePool* pool = (GPURootSignaturePool*)GPU_PROC(device->pProcTableCache, CreateRootSignaturePool)(device, desc);
+    pool->device               = device;
+    pool->pipeline_type        = desc->pipeline_type;
+    return pool;
+}
+
+void GPUFreeRootSignaturePool(GPURootSignaturePoolID pool)
+{
+    assert(pool);
+    assert(pool->device);
+    assert(pool->device->pProcTableCache->FreeRootSignaturePool);
+    GPU_PROC(pool->device->pProcTableCache, FreeRootSignaturePool)(pool);
 }
 
 GPUCommandPoolID GPUCreateCommandPool(GPUQueueID queue)
@@ -334,7 +435,7 @@ GPUCommandPoolID GPUCreateCommandPool(GPUQueueID queue)
     assert(queue);
     assert(queue->pDevice);
     assert(queue->pDevice->pProcTableCache->CreateCommandPool);
-    GPUCommandPool* P = (GPUCommandPool*)queue->pDevice->pProcTableCache->CreateCommandPool(queue);
+    GPUCommandPool* P = (GPUCommandPool*)GPU_PROC(queue->pDevice->pProcTableCache, CreateCommandPool)(queue);
     P->queue          = queue;
     return P;
 }
@@ -345,7 +446,7 @@ void GPUFreeCommandPool(GPUCommandPoolID pool)
     assert(pool->queue);
     assert(pool->queue->pDevice);
     assert(pool->queue->pDevice->pProcTableCache->FreeCommandPool);
-    pool->queue->pDevice->pProcTableCache->FreeCommandPool(pool);
+    GPU_PROC(pool->queue->pDevice->pProcTableCache, FreeCommandPool)(pool);
 }
 
 void GPUResetCommandPool(GPUCommandPoolID pool)
@@ -354,7 +455,7 @@ void GPUResetCommandPool(GPUCommandPoolID pool)
     assert(pool->queue);
     assert(pool->queue->pDevice);
     assert(pool->queue->pDevice->pProcTableCache->ResetCommandPool);
-    pool->queue->pDevice->pProcTableCache->ResetCommandPool(pool);
+    GPU_PROC(pool->queue->pDevice->pProcTableCache, ResetCommandPool)(pool);
 }
 
 GPUCommandBufferID GPUCreateCommandBuffer(GPUCommandPoolID pool, const GPUCommandBufferDescriptor* desc)
@@ -363,7 +464,7 @@ GPUCommandBufferID GPUCreateCommandBuffer(GPUCommandPoolID pool, const GPUComman
     assert(pool->queue);
     assert(pool->queue->pDevice);
     assert(pool->queue->pDevice->pProcTableCache->CreateCommandBuffer);
-    GPUCommandBuffer* CMD = (GPUCommandBuffer*)pool->queue->pDevice->pProcTableCache->CreateCommandBuffer(pool, desc);
+    GPUCommandBuffer* CMD = (GPUCommandBuffer*)GPU_PROC(pool->queue->pDevice->pProcTableCache, CreateCommandBuffer)(pool, desc);
     CMD->device           = pool->queue->pDevice;
     CMD->pool             = pool;
     return CMD;
@@ -374,7 +475,7 @@ void GPUFreeCommandBuffer(GPUCommandBufferID cmd)
     assert(cmd);
     assert(cmd->device);
     assert(cmd->device->pProcTableCache->FreeCommandBuffer);
-    cmd->device->pProcTableCache->FreeCommandBuffer(cmd);
+    GPU_PROC(cmd->device->pProcTableCache, FreeCommandBuffer)(cmd);
 }
 
 void GPUCmdBegin(GPUCommandBufferID cmdBuffer)
@@ -382,7 +483,7 @@ void GPUCmdBegin(GPUCommandBufferID cmdBuffer)
     assert(cmdBuffer);
     assert(cmdBuffer->device);
     assert(cmdBuffer->device->pProcTableCache->CmdBegin);
-    cmdBuffer->device->pProcTableCache->CmdBegin(cmdBuffer);
+    GPU_PROC(cmdBuffer->device->pProcTableCache, CmdBegin)(cmdBuffer);
 }
 
 void GPUCmdEnd(GPUCommandBufferID cmdBuffer)
@@ -390,7 +491,7 @@ void GPUCmdEnd(GPUCommandBufferID cmdBuffer)
     assert(cmdBuffer);
     assert(cmdBuffer->device);
     assert(cmdBuffer->device->pProcTableCache->CmdEnd);
-    cmdBuffer->device->pProcTableCache->CmdEnd(cmdBuffer);
+    GPU_PROC(cmdBuffer->device->pProcTableCache, CmdEnd)(cmdBuffer);
 }
 
 void GPUCmdResourceBarrier(GPUCommandBufferID cmd, const struct GPUResourceBarrierDescriptor* desc)
@@ -398,7 +499,7 @@ void GPUCmdResourceBarrier(GPUCommandBufferID cmd, const struct GPUResourceBarri
     assert(cmd);
     assert(cmd->device);
     assert(cmd->device->pProcTableCache->CmdResourceBarrier);
-    cmd->device->pProcTableCache->CmdResourceBarrier(cmd, desc);
+    GPU_PROC(cmd->device->pProcTableCache, CmdResourceBarrier)(cmd, desc);
 }
 
 void GPUCmdTransferBufferToTexture(GPUCommandBufferID cmd, const struct GPUBufferToTextureTransfer* desc)
@@ -409,7 +510,7 @@ void GPUCmdTransferBufferToTexture(GPUCommandBufferID cmd, const struct GPUBuffe
     assert(desc->src != nullptr);
     assert(desc->dst != nullptr);
     assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_NONE);
-    cmd->device->pProcTableCache->CmdTransferBufferToTexture(cmd, desc);
+    GPU_PROC(cmd->device->pProcTableCache, CmdTransferBufferToTexture)(cmd, desc);
 }
 
 void GPUCmdTransferBufferToBuffer(GPUCommandBufferID cmd, const struct GPUBufferToBufferTransfer* desc)
@@ -420,7 +521,7 @@ void GPUCmdTransferBufferToBuffer(GPUCommandBufferID cmd, const struct GPUBuffer
     assert(desc->src != nullptr);
     assert(desc->dst != nullptr);
     assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_NONE);
-    cmd->device->pProcTableCache->TransferBufferToBuffer(cmd, desc);
+    GPU_PROC(cmd->device->pProcTableCache, TransferBufferToBuffer)(cmd, desc);
 }
 
 void GPUCmdTransferTextureToTexture(GPUCommandBufferID cmd, const struct GPUTextureToTextureTransfer* desc)
@@ -431,14 +532,50 @@ void GPUCmdTransferTextureToTexture(GPUCommandBufferID cmd, const struct GPUText
     assert(desc->src != nullptr);
     assert(desc->dst != nullptr);
     assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_NONE);
-    cmd->device->pProcTableCache->CmdTransferTextureToTexture(cmd, desc);
+    GPU_PROC(cmd->device->pProcTableCache, CmdTransferTextureToTexture)(cmd, desc);
+}
+
+void GPUCmdTransferBufferToTextureRegions(GPUCommandBufferID cmd, const struct GPUBufferToTextureRegions* desc)
+{
+    assert(cmd);
+    assert(cmd->device);
+    assert(cmd->device->pProcTableCache->CmdTransferBufferToTextureRegions);
+    assert(desc->src != nullptr);
+    assert(desc->dst != nullptr);
+    assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_NONE);
+    if (desc->regions_count == 0) return;
+    GPU_PROC(cmd->device->pProcTableCache, CmdTransferBufferToTextureRegions)(cmd, desc);
+}
+
+void GPUCmdTransferBufferToBufferRegions(GPUCommandBufferID cmd, const struct GPUBufferToBufferRegions* desc)
+{
+    assert(cmd);
+    assert(cmd->device);
+    assert(cmd->device->pProcTableCache->CmdTransferBufferToBufferRegions);
+    assert(desc->src != nullptr);
+    assert(desc->dst != nullptr);
+    assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_NONE);
+    if (desc->regions_count == 0) return;
+    GPU_PROC(cmd->device->pProcTableCache, CmdTransferBufferToBufferRegions)(cmd, desc);
+}
+
+void GPUCmdTransferTextureToTextureRegions(GPUCommandBufferID cmd, const struct GPUTextureToTextureRegions* desc)
+{
+    assert(cmd);
+    assert(cmd->device);
+    assert(cmd->device->pProcTableCache->CmdTransferTextureToTextureRegions);
+    assert(desc->src != nullptr);
+    assert(desc->dst != nullptr);
+    assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_NONE);
+    if (desc->regions_count == 0) return;
+    GPU_PROC(cmd->device->pProcTableCache, CmdTransferTextureToTextureRegions)(cmd, desc);
 }
 
 GPUFenceID GPUCreateFence(GPUDeviceID device)
 {
     assert(device);
     assert(device->pProcTableCache->CreateFence);
-    GPUFence* F = (GPUFence*)device->pProcTableCache->CreateFence(device);
+    GPUFence* F = (GPUFence*)GPU_PROC(device->pProcTableCache, CreateFence)(device);
     F->device   = device;
     return F;
 }
@@ -448,7 +585,7 @@ void GPUFreeFence(GPUFenceID fence)
     assert(fence);
     assert(fence->device);
     assert(fence->device->pProcTableCache->FreeFence);
-    fence->device->pProcTableCache->FreeFence(fence);
+    GPU_PROC(fence->device->pProcTableCache, FreeFence)(fence);
 }
 
 void GPUWaitFences(const GPUFenceID* fences, uint32_t fenceCount)
@@ -458,7 +595,7 @@ void GPUWaitFences(const GPUFenceID* fences, uint32_t fenceCount)
     assert(fence);
     assert(fence->device);
     assert(fence->device->pProcTableCache->WaitFences);
-    fence->device->pProcTableCache->WaitFences(fences, fenceCount);
+    GPU_PROC(fence->device->pProcTableCache, WaitFences)(fences, fenceCount);
 }
 
 EGPUFenceStatus GPUQueryFenceStatus(GPUFenceID fence)
@@ -466,15 +603,16 @@ EGPUFenceStatus GPUQueryFenceStatus(GPUFenceID fence)
     assert(fence);
     assert(fence->device);
     assert(fence->device->pProcTableCache->QueryFenceStatus);
-    return fence->device->pProcTableCache->QueryFenceStatus(fence);
+    return GPU_PROC(fence->device->pProcTableCache, QueryFenceStatus)(fence);
 }
 
 GPUSemaphoreID GPUCreateSemaphore(GPUDeviceID device)
 {
     assert(device);
     assert(device->pProcTableCache->GpuCreateSemaphore);
-    GPUSemaphore* s = (GPUSemaphore*)device->pProcTableCache->GpuCreateSemaphore(device);
+    GPUSemaphore* s = (GPUSemaphore*)GPU_PROC(device->pProcTableCache, GpuCreateSemaphore)(device);
     s->device       = device;
+    s->timeline     = false;
     return s;
 }
 
@@ -483,7 +621,46 @@ void GPUFreeSemaphore(GPUSemaphoreID semaphore)
     assert(semaphore);
     assert(semaphore->device);
     assert(semaphore->device->pProcTableCache->GpuFreeSemaphore);
-    semaphore->device->pProcTableCache->GpuFreeSemaphore(semaphore);
+    GPU_PROC(semaphore->device->pProcTableCache, GpuFreeSemaphore)(semaphore);
+}
+
+GPUSemaphoreID GPUCreateTimelineSemaphore(GPUDeviceID device, uint64_t initialValue)
+{
+    assert(device);
+    assert(device->pProcTableCache->CreateTimelineSemaphore);
+    GPUSemaphore* s = (GPUSemaphore*)GPU_PROC(device->pProcTableCache, CreateTimelineSemaphore)(device, initialValue);
+    s->device       = device;
+    s->timeline     = true;
+    return s;
+}
+
+void GPUSignalSemaphore(GPUSemaphoreID semaphore, uint64_t value)
+{
+    assert(semaphore);
+    assert(semaphore->device);
+    assert(semaphore->timeline);
+    assert(semaphore->device->pProcTableCache->SignalSemaphore);
+    GPU_PROC(semaphore->device->pProcTableCache, SignalSemaphore)(semaphore, value);
+}
+
+bool GPUWaitSemaphores(const GPUSemaphoreID* semaphores, const uint64_t* values, uint32_t count, uint64_t timeout)
+{
+    if (semaphores == NULL || count == 0) return true;
+    GPUSemaphoreID semaphore = semaphores[0];
+    assert(semaphore);
+    assert(semaphore->device);
+    assert(values);
+    assert(semaphore->device->pProcTableCache->WaitSemaphores);
+    return GPU_PROC(semaphore->device->pProcTableCache, WaitSemaphores)(semaphores, values, count, timeout);
+}
+
+uint64_t GPUQuerySemaphoreValue(GPUSemaphoreID semaphore)
+{
+    assert(semaphore);
+    assert(semaphore->device);
+    assert(semaphore->timeline);
+    assert(semaphore->device->pProcTableCache->QuerySemaphoreValue);
+    return GPU_PROC(semaphore->device->pProcTableCache, QuerySemaphoreValue)(semaphore);
 }
 
 GPURenderPassEncoderID GPUCmdBeginRenderPass(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc)
@@ -491,7 +668,7 @@ GPURenderPassEncoderID GPUCmdBeginRenderPass(GPUCommandBufferID cmd, const struc
     assert(cmd);
     assert(cmd->device);
     assert(cmd->device->pProcTableCache->CmdBeginRenderPass);
-    GPURenderPassEncoderID id = cmd->device->pProcTableCache->CmdBeginRenderPass(cmd, desc);
+    GPURenderPassEncoderID id = GPU_PROC(cmd->device->pProcTableCache, CmdBeginRenderPass)(cmd, desc);
     GPUCommandBuffer* b       = (GPUCommandBuffer*)cmd;
     b->currentDispatch        = GPU_PIPELINE_TYPE_GRAPHICS;
     return id;
@@ -503,17 +680,47 @@ void GPUCmdEndRenderPass(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder)
     assert(cmd->device);
     assert(cmd->device->pProcTableCache->CmdEndRenderPass);
     assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_GRAPHICS);
-    cmd->device->pProcTableCache->CmdEndRenderPass(cmd, encoder);
+    GPU_PROC(cmd->device->pProcTableCache, CmdEndRenderPass)(cmd, encoder);
+    GPUCommandBuffer* b = (GPUCommandBuffer*)cmd;
+    b->currentDispatch  = GPU_PIPELINE_TYPE_NONE;
+}
+
+GPURenderPassEncoderID GPUCmdBeginRenderBundle(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc)
+{
+    assert(cmd);
+    assert(cmd->device);
+    assert(cmd->device->pProcTableCache->CmdBeginRenderBundle);
+    GPURenderPassEncoderID id = GPU_PROC(cmd->device->pProcTableCache, CmdBeginRenderBundle)(cmd, desc);
+    GPUCommandBuffer* b       = (GPUCommandBuffer*)cmd;
+    b->currentDispatch        = GPU_PIPELINE_TYPE_GRAPHICS;
+    return id;
+}
+
+void GPUCmdEndRenderBundle(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder)
+{
+    assert(cmd);
+    assert(cmd->device);
+    assert(cmd->device->pProcTableCache->CmdEndRenderBundle);
+    assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_GRAPHICS);
+    GPU_PROC(cmd->device->pProcTableCache, CmdEndRenderBundle)(cmd, encoder);
     GPUCommandBuffer* b = (GPUCommandBuffer*)cmd;
     b->currentDispatch  = GPU_PIPELINE_TYPE_NONE;
 }
 
+void GPURenderEncoderExecuteBundles(GPURenderPassEncoderID encoder, const GPUCommandBufferID* bundles, uint32_t count)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(D->pProcTableCache->RenderEncoderExecuteBundles);
+    GPU_PROC(D->pProcTableCache, RenderEncoderExecuteBundles)(encoder, bundles, count);
+}
+
 void GPURenderEncoderSetViewport(GPURenderPassEncoderID encoder, float x, float y, float width, float height, float min_depth, float max_depth)
 {
     GPUDeviceID D = encoder->device;
     assert(D);
     assert(D->pProcTableCache->RenderEncoderSetViewport);
-    D->pProcTableCache->RenderEncoderSetViewport(encoder, x, y, width, height, min_depth, max_depth);
+    GPU_PROC(D->pProcTableCache, RenderEncoderSetViewport)(encoder, x, y, width, height, min_depth, max_depth);
 }
 
 void GPURenderEncoderSetScissor(GPURenderPassEncoderID encoder, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
@@ -521,7 +728,7 @@ void GPURenderEncoderSetScissor(GPURenderPassEncoderID encoder, uint32_t x, uint
     GPUDeviceID D = encoder->device;
     assert(D);
     assert(D->pProcTableCache->RenderEncoderSetScissor);
-    D->pProcTableCache->RenderEncoderSetScissor(encoder, x, y, width, height);
+    GPU_PROC(D->pProcTableCache, RenderEncoderSetScissor)(encoder, x, y, width, height);
 }
 
 void GPURenderEncoderBindPipeline(GPURenderPassEncoderID encoder, GPURenderPipelineID pipeline)
@@ -529,7 +736,33 @@ void GPURenderEncoderBindPipeline(GPURenderPassEncoderID encoder, GPURenderPipel
     GPUDeviceID D = encoder->device;
     assert(D);
     assert(D->pProcTableCache->RenderEncoderBindPipeline);
-    D->pProcTableCache->RenderEncoderBindPipeline(encoder, pipeline);
+    GPU_PROC(D->pProcTableCache, RenderEncoderBindPipeline)(encoder, pipeline);
+}
+
+void GPURenderEncoderSetRasterizerState(GPURenderPassEncoderID encoder, const GPURasterizerStateDescriptor* state)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(state);
+    assert(D->pProcTableCache->RenderEncoderSetRasterizerState);
+    GPU_PROC(D->pProcTableCache, RenderEncoderSetRasterizerState)(encoder, state);
+}
+
+void GPURenderEncoderSetDepthState(GPURenderPassEncoderID encoder, const GPUDepthStateDesc* state)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(state);
+    assert(D->pProcTableCache->RenderEncoderSetDepthState);
+    GPU_PROC(D->pProcTableCache, RenderEncoderSetDepthState)(encoder, state);
+}
+
+void GPURenderEncoderSetPrimitiveTopology(GPURenderPassEncoderID encoder, EGPUPrimitiveTopology topology)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(D->pProcTableCache->RenderEncoderSetPrimitiveTopology);
+    GPU_PROC(D->pProcTableCache, RenderEncoderSetPrimitiveTopology)(encoder, topology);
 }
 
 void GPURenderEncoderDraw(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t first_vertex)
@@ -537,7 +770,15 @@ void GPURenderEncoderDraw(GPURenderPassEncoderID encoder, uint32_t vertex_count,
     GPUDeviceID D = encoder->device;
     assert(D);
     assert(D->pProcTableCache->RenderEncoderDraw);
-    D->pProcTableCache->RenderEncoderDraw(encoder, vertex_count, first_vertex);
+    GPU_PROC(D->pProcTableCache, RenderEncoderDraw)(encoder, vertex_count, first_vertex);
+}
+
+void GPURenderEncoderDrawInstanced(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(D->pProcTableCache->RenderEncoderDrawInstanced);
+    GPU_PROC(D->pProcTableCache, RenderEncoderDrawInstanced)(encoder, vertex_count, instance_count, first_vertex, first_instance);
 }
 
 void GPURenderEncoderDrawIndexed(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t firstIndex, uint32_t vertexOffset)
@@ -545,7 +786,7 @@ void GPURenderEncoderDrawIndexed(GPURenderPassEncoderID encoder, uint32_t indexC
     GPUDeviceID D = encoder->device;
     assert(D);
     assert(D->pProcTableCache->RenderEncoderDrawIndexed);
-    D->pProcTableCache->RenderEncoderDrawIndexed(encoder, indexCount, firstIndex, vertexOffset);
+    GPU_PROC(D->pProcTableCache, RenderEncoderDrawIndexed)(encoder, indexCount, firstIndex, vertexOffset);
 }
 
 void GPURenderEncoderDrawIndexedInstanced(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
@@ -553,7 +794,49 @@ void GPURenderEncoderDrawIndexedInstanced(GPURenderPassEncoderID encoder, uint32
     GPUDeviceID D = encoder->device;
     assert(D);
     assert(D->pProcTableCache->RenderEncoderDrawIndexedInstanced);
-    D->pProcTableCache->RenderEncoderDrawIndexedInstanced(encoder, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    GPU_PROC(D->pProcTableCache, RenderEncoderDrawIndexedInstanced)(encoder, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+}
+
+void GPURenderEncoderDrawIndirect(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(buffer);
+    assert(buffer->descriptors & GPU_RESOURCE_TYPE_INDIRECT_BUFFER);
+    assert(D->pProcTableCache->RenderEncoderDrawIndirect);
+    GPU_PROC(D->pProcTableCache, RenderEncoderDrawIndirect)(encoder, buffer, offset, drawCount, stride ? stride : sizeof(GPUDrawIndirectArguments));
+}
+
+void GPURenderEncoderDrawIndexedIndirect(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(buffer);
+    assert(buffer->descriptors & GPU_RESOURCE_TYPE_INDIRECT_BUFFER);
+    assert(D->pProcTableCache->RenderEncoderDrawIndexedIndirect);
+    GPU_PROC(D->pProcTableCache, RenderEncoderDrawIndexedIndirect)(encoder, buffer, offset, drawCount, stride ? stride : sizeof(GPUDrawIndexedIndirectArguments));
+}
+
+void GPURenderEncoderDrawIndirectCount(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(buffer && countBuffer);
+    assert(buffer->descriptors & GPU_RESOURCE_TYPE_INDIRECT_BUFFER);
+    assert(countBuffer->descriptors & GPU_RESOURCE_TYPE_INDIRECT_BUFFER);
+    assert(D->pProcTableCache->RenderEncoderDrawIndirectCount);
+    GPU_PROC(D->pProcTableCache, RenderEncoderDrawIndirectCount)(encoder, buffer, offset, countBuffer, countOffset, maxDrawCount, stride ? stride : sizeof(GPUDrawIndirectArguments));
+}
+
+void GPURenderEncoderDrawIndexedIndirectCount(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(buffer && countBuffer);
+    assert(buffer->descriptors & GPU_RESOURCE_TYPE_INDIRECT_BUFFER);
+    assert(countBuffer->descriptors & GPU_RESOURCE_TYPE_INDIRECT_BUFFER);
+    assert(D->pProcTableCache->RenderEncoderDrawIndexedIndirectCount);
+    GPU_PROC(D->pProcTableCache, RenderEncoderDrawIndexedIndirectCount)(encoder, buffer, offset, countBuffer, countOffset, maxDrawCount, stride ? stride : sizeof(GPUDrawIndexedIndirectArguments));
 }
 
 void GPURenderEncoderBindVertexBuffers(GPURenderPassEncoderID encoder, uint32_t buffer_count,
@@ -563,7 +846,7 @@ void GPURenderEncoderBindVertexBuffers(GPURenderPassEncoderID encoder, uint32_t
     assert(encoder->device);
     assert(encoder->device->pProcTableCache->RenderEncoderBindVertexBuffers);
     assert(buffers);
-    encoder->device->pProcTableCache->RenderEncoderBindVertexBuffers(encoder, buffer_count, buffers, strides, offsets);
+    GPU_PROC(encoder->device->pProcTableCache, RenderEncoderBindVertexBuffers)(encoder, buffer_count, buffers, strides, offsets);
 }
 
 void GPURenderEncoderBindIndexBuffer(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint32_t offset, uint64_t indexStride)
@@ -572,7 +855,7 @@ void GPURenderEncoderBindIndexBuffer(GPURenderPassEncoderID encoder, GPUBufferID
     assert(encoder->device);
     assert(encoder->device->pProcTableCache->RenderEncoderBindIndexBuffer);
     assert(buffer);
-    encoder->device->pProcTableCache->RenderEncoderBindIndexBuffer(encoder, buffer, offset, indexStride);
+    GPU_PROC(encoder->device->pProcTableCache, RenderEncoderBindIndexBuffer)(encoder, buffer, offset, indexStride);
 }
 
 void GPURenderEncoderBindDescriptorSet(GPURenderPassEncoderID encoder, GPUDescriptorSetID set)
@@ -581,7 +864,124 @@ void GPURenderEncoderBindDescriptorSet(GPURenderPassEncoderID encoder, GPUDescri
     assert(encoder->device);
     assert(set);
     assert(encoder->device->pProcTableCache->RenderEncoderBindDescriptorSet);
-    encoder->device->pProcTableCache->RenderEncoderBindDescriptorSet(encoder, set);
+    GPU_PROC(encoder->device->pProcTableCache, RenderEncoderBindDescriptorSet)(encoder, set);
+}
+
+void GPURenderEncoderBindDescriptorSetWithOffsets(GPURenderPassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count)
+{
+    assert(encoder);
+    assert(encoder->device);
+    assert(set);
+    assert(dynamic_offsets || !dynamic_offset_count);
+    assert(encoder->device->pProcTableCache->RenderEncoderBindDescriptorSetWithOffsets);
+    GPU_PROC(encoder->device->pProcTableCache, RenderEncoderBindDescriptorSetWithOffsets)(encoder, set, dynamic_offsets, dynamic_offset_count);
+}
+
+void GPURenderEncoderPushConstants(GPURenderPassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(rs && name && data);
+    assert(D->pProcTableCache->RenderEncoderPushConstants);
+    GPU_PROC(D->pProcTableCache, RenderEncoderPushConstants)(encoder, rs, name, data);
+}
+
+void GPURenderEncoderPushDescriptorSet(GPURenderPassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(rs && datas);
+    assert((rs->transient_set_mask & (1u << set_index)) && "only transient sets can be pushed!");
+    assert(D->pProcTableCache->RenderEncoderPushDescriptorSet);
+    GPU_PROC(D->pProcTableCache, RenderEncoderPushDescriptorSet)(encoder, rs, set_index, datas, count);
+}
+
+GPUComputePassEncoderID GPUCmdBeginComputePass(GPUCommandBufferID cmd, const struct GPUComputePassDescriptor* desc)
+{
+    assert(cmd);
+    assert(cmd->device);
+    assert(cmd->device->pProcTableCache->CmdBeginComputePass);
+    assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_NONE);
+    GPUComputePassEncoderID id = GPU_PROC(cmd->device->pProcTableCache, CmdBeginComputePass)(cmd, desc);
+    GPUCommandBuffer* b        = (GPUCommandBuffer*)cmd;
+    b->currentDispatch         = GPU_PIPELINE_TYPE_COMPUTE;
+    return id;
+}
+
+void GPUCmdEndComputePass(GPUCommandBufferID cmd, GPUComputePassEncoderID encoder)
+{
+    assert(cmd);
+    assert(cmd->device);
+    assert(cmd->device->pProcTableCache->CmdEndComputePass);
+    assert(cmd->currentDispatch == GPU_PIPELINE_TYPE_COMPUTE);
+    GPU_PROC(cmd->device->pProcTableCache, CmdEndComputePass)(cmd, encoder);
+    GPUCommandBuffer* b = (GPUCommandBuffer*)cmd;
+    b->currentDispatch  = GPU_PIPELINE_TYPE_NONE;
+}
+
+void GPUComputeEncoderBindPipeline(GPUComputePassEncoderID encoder, GPUComputePipelineID pipeline)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(pipeline);
+    assert(D->pProcTableCache->ComputeEncoderBindPipeline);
+    GPU_PROC(D->pProcTableCache, ComputeEncoderBindPipeline)(encoder, pipeline);
+}
+
+void GPUComputeEncoderBindDescriptorSet(GPUComputePassEncoderID encoder, GPUDescriptorSetID set)
+{
+    assert(encoder);
+    assert(encoder->device);
+    assert(set);
+    assert(encoder->device->pProcTableCache->ComputeEncoderBindDescriptorSet);
+    GPU_PROC(encoder->device->pProcTableCache, ComputeEncoderBindDescriptorSet)(encoder, set);
+}
+
+void GPUComputeEncoderBindDescriptorSetWithOffsets(GPUComputePassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count)
+{
+    assert(encoder);
+    assert(encoder->device);
+    assert(set);
+    assert(dynamic_offsets || !dynamic_offset_count);
+    assert(encoder->device->pProcTableCache->ComputeEncoderBindDescriptorSetWithOffsets);
+    GPU_PROC(encoder->device->pProcTableCache, ComputeEncoderBindDescriptorSetWithOffsets)(encoder, set, dynamic_offsets, dynamic_offset_count);
+}
+
+void GPUComputeEncoderPushConstants(GPUComputePassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(rs && name && data);
+    assert(D->pProcTableCache->ComputeEncoderPushConstants);
+    GPU_PROC(D->pProcTableCache, ComputeEncoderPushConstants)(encoder, rs, name, data);
+}
+
+void GPUComputeEncoderPushDescriptorSet(GPUComputePassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(rs && datas);
+    assert((rs->transient_set_mask & (1u << set_index)) && "only transient sets can be pushed!");
+    assert(D->pProcTableCache->ComputeEncoderPushDescriptorSet);
+    GPU_PROC(D->pProcTableCache, ComputeEncoderPushDescriptorSet)(encoder, rs, set_index, datas, count);
+}
+
+void GPUComputeEncoderDispatch(GPUComputePassEncoderID encoder, uint32_t x, uint32_t y, uint32_t z)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(D->pProcTableCache->ComputeEncoderDispatch);
+    GPU_PROC(D->pProcTableCache, ComputeEncoderDispatch)(encoder, x, y, z);
+}
+
+void GPUComputeEncoderDispatchIndirect(GPUComputePassEncoderID encoder, GPUBufferID buffer, uint64_t offset)
+{
+    GPUDeviceID D = encoder->device;
+    assert(D);
+    assert(buffer);
+    assert(buffer->descriptors & GPU_RESOURCE_TYPE_INDIRECT_BUFFER);
+    assert(D->pProcTableCache->ComputeEncoderDispatchIndirect);
+    GPU_PROC(D->pProcTableCache, ComputeEncoderDispatchIndirect)(encoder, buffer, offset);
 }
 
 GPUBufferID GPUCreateBuffer(GPUDeviceID device, const GPUBufferDescriptor* desc)
@@ -594,7 +994,7 @@ GPUBufferID GPUCreateBuffer(GPUDeviceID device, const GPUBufferDescriptor* desc)
     {
         new_desc.flags |= GPU_BCF_NONE;
     }
-    GPUBuffer* B = (GPUBuffer*)device->pProcTableCache->CreateBuffer(device, &new_desc);
+    GPUBuffer* B = (GPUBuffer*)GPU_PROC(device->pProcTableCache, CreateBuffer)(device, &new_desc);
     B->device    = device;
     return B;
 }
@@ -604,7 +1004,7 @@ void GPUFreeBuffer(GPUBufferID buffer)
     assert(buffer);
     assert(buffer->device);
     assert(buffer->device->pProcTableCache->FreeBuffer);
-    buffer->device->pProcTableCache->FreeBuffer(buffer);
+    GPU_PROC(buffer->device->pProcTableCache, FreeBuffer)(buffer);
 }
 
 void GPUTransferBufferToBuffer(GPUCommandBufferID cmd, const struct GPUBufferToBufferTransfer* desc)
@@ -615,7 +1015,7 @@ void GPUTransferBufferToBuffer(GPUCommandBufferID cmd, const struct GPUBufferToB
     assert(desc);
     assert(desc->src);
     assert(desc->dst);
-    cmd->device->pProcTableCache->TransferBufferToBuffer(cmd, desc);
+    GPU_PROC(cmd->device->pProcTableCache, TransferBufferToBuffer)(cmd, desc);
 }
 
 GPUSamplerID GPUCreateSampler(GPUDeviceID device, const struct GPUSamplerDescriptor* desc)
@@ -623,7 +1023,7 @@ GPUSamplerID GPUCreateSampler(GPUDeviceID device, const struct GPUSamplerDescrip
     assert(device);
     assert(desc);
     assert(device->pProcTableCache->CreateSampler);
-    GPUSampler* sampler = (GPUSampler*)device->pProcTableCache->CreateSampler(device, desc);
+    GPUSampler* sampler = (GPUSampler*)GPU_PROC(device->pProcTableCache, CreateSampler)(device, desc);
     sampler->device     = device;
     return sampler;
 }
@@ -633,14 +1033,16 @@ void GPUFreeSampler(GPUSamplerID sampler)
     assert(sampler);
     assert(sampler->device);
     assert(sampler->device->pProcTableCache->FreeSampler);
-    sampler->device->pProcTableCache->FreeSampler(sampler);
+    GPU_PROC(sampler->device->pProcTableCache, FreeSampler)(sampler);
 }
 
 GPUDescriptorSetID GPUCreateDescriptorSet(GPUDeviceID device, const struct GPUDescriptorSetDescriptor* desc)
 {
     assert(device);
     assert(device->pProcTableCache->CreateDescriptorSet);
-    GPUDescriptorSet* set = (GPUDescriptorSet*)device->pProcTableCache->CreateDescriptorSet(device, desc);
+    assert(!(desc->root_signature->bindless_heap && desc->root_signature->bindless_set == desc->set_index) && "the bindless set belongs to the heap!");
+    assert(!(desc->root_signature->transient_set_mask & (1u << desc->set_index)) && "transient sets are pushed, not allocated!");
+    GPUDescriptorSet* set = (GPUDescriptorSet*)GPU_PROC(device->pProcTableCache, CreateDescriptorSet)(device, desc);
     set->root_signature   = desc->root_signature;
     set->index            = desc->set_index;
     return set;
@@ -651,7 +1053,7 @@ void GPUFreeDescriptorSet(GPUDescriptorSetID set)
     assert(set->root_signature);
     assert(set->root_signature->device);
     assert(set->root_signature->device->pProcTableCache->FreeDescriptorSet);
-    set->root_signature->device->pProcTableCache->FreeDescriptorSet(set);
+    GPU_PROC(set->root_signature->device->pProcTableCache, FreeDescriptorSet)(set);
 }
 void GPUUpdateDescriptorSet(GPUDescriptorSetID set, const GPUDescriptorData* datas, uint32_t count)
 {
@@ -660,5 +1062,54 @@ void GPUUpdateDescriptorSet(GPUDescriptorSetID set, const GPUDescriptorData* dat
     assert(set->root_signature->device);
     assert(set->root_signature->device->pProcTableCache->UpdateDescriptorSet);
     assert(datas);
-    set->root_signature->device->pProcTableCache->UpdateDescriptorSet(set, datas, count);
-}
\ No newline at end of file
+    GPU_PROC(set->root_signature->device->pProcTableCache, UpdateDescriptorSet)(set, datas, count);
+}
+
+GPUBindlessHeapID GPUCreateBindlessHeap(GPUDeviceID device, const struct GPUBindlessHeapDescriptor* desc)
+{
+    assert(device);
+    assert(device->pProcTableCache->CreateBindlessHeap);
+    GPUBindlessHeap* heap = (GPUBindlessHeap*)GPU_PROC(device->pProcTableCache, CreateBindlessHeap)(device, desc);
+    heap->device          = device;
+    return heap;
+}
+
+void GPUFreeBindlessHeap(GPUBindlessHeapID heap)
+{
+    assert(heap);
+    assert(heap->device);
+    assert(heap->device->pProcTableCache->FreeBindlessHeap);
+    GPU_PROC(heap->device->pProcTableCache, FreeBindlessHeap)(heap);
+}
+
+uint32_t GPUBindlessHeapAddTexture(GPUBindlessHeapID heap, GPUTextureViewID view, bool writable)
+{
+    assert(heap);
+    assert(view);
+    assert(heap->device->pProcTableCache->BindlessHeapAddTexture);
+    return GPU_PROC(heap->device->pProcTableCache, BindlessHeapAddTexture)(heap, view, writable);
+}
+
+uint32_t GPUBindlessHeapAddBuffer(GPUBindlessHeapID heap, GPUBufferID buffer)
+{
+    assert(heap);
+    assert(buffer);
+    assert(heap->device->pProcTableCache->BindlessHeapAddBuffer);
+    return GPU_PROC(heap->device->pProcTableCache, BindlessHeapAddBuffer)(heap, buffer);
+}
+
+uint32_t GPUBindlessHeapAddSampler(GPUBindlessHeapID heap, GPUSamplerID sampler)
+{
+    assert(heap);
+    assert(sampler);
+    assert(heap->device->pProcTableCache->BindlessHeapAddSampler);
+    return GPU_PROC(heap->device->pProcTableCache, BindlessHeapAddSampler)(heap, sampler);
+}
+
+void GPUBindlessHeapRemove(GPUBindlessHeapID heap, EGPUBindlessRange range, uint32_t index)
+{
+    assert(heap);
+    assert(range < GPU_BINDLESS_RANGE_COUNT);
+    assert(heap->device->pProcTableCache->BindlessHeapRemove);
+    GPU_PROC(heap->device->pProcTableCache, BindlessHeapRemove)(heap, range, index);
+}
@@ -1,6 +1,7 @@
 #include "GPUBindTable.hpp"
 #include "Utils.h"
 #include <set>
+#include <assert.h>
 
 void GPUBindTableValue::Initialize(const GPUBindTableLocation& loc, const GPUDescriptorData& rhs)
 {
@@ -21,20 +22,31 @@ GPUBindTableID GPUBindTable::Create(GPUDeviceID device, const GPUBindTableDescri
     uint64_t hashsSize     = desc->namesCount * sizeof(uint64_t);
     uint64_t locationsSize = desc->namesCount * sizeof(GPUBindTableLocation);
     uint64_t setsSize      = rs->table_count * sizeof(GPUDescriptorSetID);
-    uint64_t totalSize     = hashsSize + locationsSize + setsSize + sizeof(GPUBindTable);
+    // every binding of the transient set can be pushed at most once
+    uint32_t transientCount = 0;
+    for (uint32_t setIdx = 0; setIdx < rs->table_count; setIdx++)
+    {
+        if (rs->transient_set_mask & (1u << rs->tables[setIdx].set_index)) transientCount += rs->tables[setIdx].resources_count;
+    }
+    uint64_t transientSize = transientCount * sizeof(GPUDescriptorData);
+    uint64_t totalSize     = hashsSize + locationsSize + setsSize + transientSize + sizeof(GPUBindTable);
 
     GPUBindTable* pBindTable = (GPUBindTable*)_aligned_malloc(totalSize, _alignof(GPUBindTable));
     memset(pBindTable, 0, totalSize);
     uint64_t* pHash                  = (uint64_t*)(pBindTable + 1);
     GPUBindTableLocation* pLocations = (GPUBindTableLocation*)(pHash + desc->namesCount);
     GPUDescriptorSetID* ppSets       = (GPUDescriptorSetID*)(pLocations + desc->namesCount);
-
-    pBindTable->m_pRS            = rs;
-    pBindTable->m_pNamesHash     = pHash;
-    pBindTable->m_pNamesLocation = pLocations;
-    pBindTable->mNamesCount      = desc->namesCount;
-    pBindTable->mSetsCount       = rs->table_count;
-    pBindTable->m_ppSets         = ppSets;
+    GPUDescriptorData* pTransients   = (GPUDescriptorData*)(ppSets + rs->table_count);
+
+    pBindTable->m_pRS                = rs;
+    pBindTable->m_pNamesHash         = pHash;
+    pBindTable->m_pNamesLocation     = pLocations;
+    pBindTable->mNamesCount          = desc->namesCount;
+    pBindTable->mSetsCount           = rs->table_count;
+    pBindTable->m_ppSets             = ppSets;
+    pBindTable->m_pTransientDatas    = pTransients;
+    pBindTable->mTransientCapacity   = transientCount;
+    pBindTable->mTransientTableIndex = UINT32_MAX;
 
     for (uint32_t i = 0; i < pBindTable->mNamesCount; i++)
     {
@@ -55,12 +67,14 @@ GPUBindTableID GPUBindTable::Create(GPUDeviceID device, const GPUBindTableDescri
                     const_cast<uint32_t&>(pBindTable->m_pNamesLocation[i].tableIndex) = setIdx;
                     const_cast<uint32_t&>(pBindTable->m_pNamesLocation[i].binding)    = bindIdx;
 
+                    // transient sets are pushed on bind, nothing to allocate
+                    if (rs->transient_set_mask & (1u << table.set_index)) break;
                     GPUDescriptorSetDescriptor set_desc {};
                     set_desc.root_signature = rs;
                     set_desc.set_index      = setIdx;
-                    if (!ppSets[i])
+                    if (!ppSets[setIdx])
                     {
-                        ppSets[i] = GPUCreateDescriptorSet(device, &set_desc);
+                        ppSets[setIdx] = GPUCreateDescriptorSet(device, &set_desc);
                     }
                     break;
                 }
@@ -95,6 +109,42 @@ void GPUBindTable::Bind(GPURenderPassEncoderID encoder) const
     {
         if (m_ppSets[i]) GPURenderEncoderBindDescriptorSet(encoder, m_ppSets[i]);
     }
+    if (mTransientDatasCount)
+    {
+        GPURenderEncoderPushDescriptorSet(encoder, m_pRS, m_pRS->tables[mTransientTableIndex].set_index, m_pTransientDatas, mTransientDatasCount);
+    }
+}
+
+void GPUBindTable::Bind(GPUComputePassEncoderID encoder) const
+{
+    for (uint32_t i = 0; i < mSetsCount; i++)
+    {
+        if (m_ppSets[i]) GPUComputeEncoderBindDescriptorSet(encoder, m_ppSets[i]);
+    }
+    if (mTransientDatasCount)
+    {
+        GPUComputeEncoderPushDescriptorSet(encoder, m_pRS, m_pRS->tables[mTransientTableIndex].set_index, m_pTransientDatas, mTransientDatasCount);
+    }
+}
+
+// gathers the values of the transient set once per update, binding only pushes them
+void GPUBindTable::CollectTransientData()
+{
+    mTransientDatasCount = 0;
+    mTransientTableIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < mNamesCount; i++)
+    {
+        const GPUBindTableLocation& location = m_pNamesLocation[i];
+        if (!(m_pRS->transient_set_mask & (1u << m_pRS->tables[location.tableIndex].set_index))) continue;
+        if (!location.mValue.mData.count) continue;
+        assert(mTransientDatasCount < mTransientCapacity);
+        // the caller's name may be gone by now, address the slot by its binding
+        GPUDescriptorData& data = m_pTransientDatas[mTransientDatasCount++];
+        data                    = location.mValue.mData;
+        data.name               = nullptr;
+        data.binding            = m_pRS->tables[location.tableIndex].resources[location.binding].binding;
+        mTransientTableIndex    = location.tableIndex;
+    }
 }
 
 void GPUBindTable::Update(const GPUDescriptorData* pData, uint32_t count)
@@ -124,6 +174,7 @@ void GPUBindTable::Update(const GPUDescriptorData* pData, uint32_t count)
         }
     }
     UpdateSelfIfDirty();
+    CollectTransientData();
 }
 
 void GPUBindTable::UpdateSelfIfDirty()
@@ -131,6 +182,8 @@ void GPUBindTable::UpdateSelfIfDirty()
     std::set<uint32_t> needUpdateIdxSet;
     for (uint32_t i = 0; i < mNamesCount; i++)
     {
+        // transient values stay in the table until they are pushed
+        if (m_pRS->transient_set_mask & (1u << m_pRS->tables[m_pNamesLocation[i].tableIndex].set_index)) continue;
         if (!m_pNamesLocation[i].mValue.mBinded) needUpdateIdxSet.insert(m_pNamesLocation[i].tableIndex);
     }
 
@@ -180,6 +233,11 @@ void GPUBindTableUpdate(GPUBindTableID table, const GPUDescriptorData* datas, ui
 }
 
 void GPURenderEncoderBindBindTable(GPURenderPassEncoderID encoder, GPUBindTableID table)
+{
+    table->Bind(encoder);
+}
+
+void GPUComputeEncoderBindBindTable(GPUComputePassEncoderID encoder, GPUBindTableID table)
 {
     table->Bind(encoder);
 }
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include "GPUDrawList.hpp"
+#include "Utils.h"
+#include "hash.h"
+#include <cstring>
+#include <assert.h>
+
+#define GPU_DRAW_LIST_LAYER_SHIFT       56
+#define GPU_DRAW_LIST_PIPELINE_SHIFT    44
+#define GPU_DRAW_LIST_BIND_TABLE_SHIFT  30
+#define GPU_DRAW_LIST_GEOMETRY_SHIFT    16
+// depth-major layers, the state below the depth has the same layout shifted down
+#define GPU_DRAW_LIST_DEPTH_MAJOR_SHIFT 40
+
+GPUDrawListID GPUDrawList::Create(GPUDeviceID device, const GPUDrawListDescriptor* desc)
+{
+    assert((desc->push_data_size == 0 || desc->push_constant_name) && "push data needs the name of its push constant block!");
+    GPUDrawList* pList       = new (_aligned_malloc(sizeof(GPUDrawList), _alignof(GPUDrawList))) GPUDrawList();
+    pList->m_pDevice         = device;
+    pList->m_pPushConstName  = desc->push_constant_name;
+    pList->mPushDataSize     = desc->push_data_size;
+    pList->mInstanceDataSize = desc->instance_data_size;
+    for (uint32_t i = 0; i < desc->depth_major_layers_count; i++)
+    {
+        const uint8_t layer = desc->depth_major_layers[i];
+        pList->mDepthMajorLayers[layer >> 6] |= 1ull << (layer & 63);
+    }
+    pList->mKeys.reserve(desc->reserve_count);
+    pList->mOrder.reserve(desc->reserve_count);
+    pList->mCounts.reserve(desc->reserve_count);
+    pList->mFirsts.reserve(desc->reserve_count);
+    pList->mVertexOffsets.reserve(desc->reserve_count);
+    pList->mPushData.reserve((uint64_t)desc->reserve_count * desc->push_data_size);
+    pList->mInstanceData.reserve((uint64_t)desc->reserve_count * desc->instance_data_size);
+    return pList;
+}
+
+void GPUDrawList::Free(GPUDrawListID list)
+{
+    if (list)
+    {
+        GPUDrawList* pList = (GPUDrawList*)list;
+        pList->~GPUDrawList();
+        _aligned_free(pList);
+    }
+}
+
+uint32_t GPUDrawList::FindOrAddGeometry(const GPUDrawGeometry* geometry)
+{
+    assert(geometry->vertex_buffers_count <= GPU_MAX_VERTEX_ATTRIBS);
+    // zeroed so the padding and unused slots compare and hash equal
+    Geometry g;
+    memset(&g, 0, sizeof(Geometry));
+    for (uint32_t i = 0; i < geometry->vertex_buffers_count; i++)
+    {
+        g.vertexBuffers[i] = geometry->vertex_buffers[i];
+        g.strides[i]       = geometry->strides[i];
+        g.offsets[i]       = geometry->offsets ? geometry->offsets[i] : 0;
+    }
+    g.vertexBuffersCount = geometry->vertex_buffers_count;
+    g.indexBuffer        = geometry->index_buffer;
+    g.indexOffset        = geometry->index_buffer ? geometry->index_offset : 0;
+    g.indexStride        = geometry->index_buffer ? geometry->index_stride : 0;
+
+    const uint64_t hash = XXH3_64bits(&g, sizeof(Geometry));
+    auto range          = mGeometryIndices.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+        if (!memcmp(&mGeometries[iter->second], &g, sizeof(Geometry))) return iter->second;
+    }
+    const uint32_t index = (uint32_t)mGeometries.size();
+    mGeometries.push_back(g);
+    mGeometryIndices.emplace(hash, index);
+    return index;
+}
+
+void GPUDrawList::Record(const GPUDrawPacket* packet)
+{
+    assert(packet->pipeline && packet->geometry);
+    assert((mPushDataSize == 0 || packet->push_data) && "draw list expects push data!");
+    assert((mInstanceDataSize == 0 || packet->instance_data) && "draw list expects instance data!");
+
+    auto pipeline = mPipelineIndices.try_emplace(packet->pipeline, (uint32_t)mPipelines.size());
+    if (pipeline.second) mPipelines.push_back(packet->pipeline);
+    // 0 stands for the default table of the replay
+    uint32_t bindTable = 0;
+    if (packet->bind_table)
+    {
+        auto found = mBindTableIndices.try_emplace(packet->bind_table, (uint32_t)mBindTables.size() + 1);
+        if (found.second) mBindTables.push_back(packet->bind_table);
+        bindTable = found.first->second;
+    }
+    const uint32_t geometry = FindOrAddGeometry(packet->geometry);
+    assert(mPipelines.size() <= GPU_DRAW_LIST_MAX_PIPELINES && "too many pipelines in one draw list!");
+    assert(mBindTables.size() < GPU_DRAW_LIST_MAX_BIND_TABLES && "too many bind tables in one draw list!");
+    assert(mGeometries.size() <= GPU_DRAW_LIST_MAX_GEOMETRIES && "too many geometries in one draw list!");
+
+    const uint64_t state = ((uint64_t)pipeline.first->second << GPU_DRAW_LIST_PIPELINE_SHIFT) |
+                           ((uint64_t)bindTable << GPU_DRAW_LIST_BIND_TABLE_SHIFT) |
+                           ((uint64_t)geometry << GPU_DRAW_LIST_GEOMETRY_SHIFT);
+    const uint64_t order = IsDepthMajor(packet->layer) ?
+                           ((uint64_t)packet->depth << GPU_DRAW_LIST_DEPTH_MAJOR_SHIFT) | (state >> GPU_DRAW_LIST_GEOMETRY_SHIFT) :
+                           state | (uint64_t)packet->depth;
+    const uint64_t key   = ((uint64_t)packet->layer << GPU_DRAW_LIST_LAYER_SHIFT) | order;
+    mOrder.push_back((uint32_t)mCounts.size());
+    mKeys.push_back(key);
+    mCounts.push_back(packet->count);
+    mFirsts.push_back(packet->first);
+    mVertexOffsets.push_back(packet->vertex_offset);
+    if (mPushDataSize)
+    {
+        const uint8_t* data = (const uint8_t*)packet->push_data;
+        mPushData.insert(mPushData.end(), data, data + mPushDataSize);
+    }
+    if (mInstanceDataSize)
+    {
+        const uint8_t* data = (const uint8_t*)packet->instance_data;
+        mInstanceData.insert(mInstanceData.end(), data, data + mInstanceDataSize);
+    }
+    mSorted = false;
+}
+
+// LSD radix sort on 8-bit digits, stable so equal keys keep the recording order.
+// Digits that are the same for every key are skipped, which are most of them for small lists
+void GPUDrawList::Sort()
+{
+    if (mSorted) return;
+    const uint32_t count = (uint32_t)mKeys.size();
+    mScratchKeys.resize(count);
+    mScratchOrder.resize(count);
+    uint64_t* keys     = mKeys.data();
+    uint32_t* order    = mOrder.data();
+    uint64_t* tmpKeys  = mScratchKeys.data();
+    uint32_t* tmpOrder = mScratchOrder.data();
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        uint32_t histogram[256] = {};
+        for (uint32_t i = 0; i < count; i++)
+        {
+            histogram[(keys[i] >> shift) & 0xFF]++;
+        }
+        if (histogram[(keys[0] >> shift) & 0xFF] == count) continue;
+        uint32_t offset = 0;
+        for (uint32_t b = 0; b < 256; b++)
+        {
+            const uint32_t n = histogram[b];
+            histogram[b]     = offset;
+            offset += n;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const uint32_t dst = histogram[(keys[i] >> shift) & 0xFF]++;
+            tmpKeys[dst]       = keys[i];
+            tmpOrder[dst]      = order[i];
+        }
+        std::swap(keys, tmpKeys);
+        std::swap(order, tmpOrder);
+    }
+    if (keys != mKeys.data())
+    {
+        mKeys.swap(mScratchKeys);
+        mOrder.swap(mScratchOrder);
+    }
+    mSorted = true;
+}
+
+// layer and state of a key in the layout of the regular layers, without the depth
+uint64_t GPUDrawList::StateBits(uint64_t key) const
+{
+    const uint32_t layer = (uint32_t)(key >> GPU_DRAW_LIST_LAYER_SHIFT);
+    if (!IsDepthMajor(layer)) return key & ~0xFFFFull;
+    return ((uint64_t)layer << GPU_DRAW_LIST_LAYER_SHIFT) | ((key & ((1ull << GPU_DRAW_LIST_DEPTH_MAJOR_SHIFT) - 1)) << GPU_DRAW_LIST_GEOMETRY_SHIFT);
+}
+
+// a and b are positions in the sorted stream, the depth part of the key does not matter
+bool GPUDrawList::CanMerge(uint32_t a, uint32_t b) const
+{
+    if (StateBits(mKeys[a]) != StateBits(mKeys[b])) return false;
+    const uint32_t da = mOrder[a];
+    const uint32_t db = mOrder[b];
+    if (mCounts[da] != mCounts[db] || mFirsts[da] != mFirsts[db] || mVertexOffsets[da] != mVertexOffsets[db]) return false;
+    return mPushDataSize == 0 || !memcmp(&mPushData[(uint64_t)da * mPushDataSize], &mPushData[(uint64_t)db * mPushDataSize], mPushDataSize);
+}
+
+GPUDrawListStats GPUDrawList::Replay(GPURenderPassEncoderID encoder, const GPUDrawListReplayDescriptor* desc)
+{
+    Sort();
+    GPUDrawListStats stats{};
+    const uint32_t count = (uint32_t)mKeys.size();
+    stats.draws          = count;
+    uint8_t* pInstances  = nullptr;
+    if (mInstanceDataSize && count)
+    {
+        assert(desc->instance_buffer && desc->instance_buffer->cpu_mapped_address && "instance data needs a mapped buffer!");
+        assert(desc->instance_offset + InstanceDataSize() <= desc->instance_buffer->size && "instance buffer is too small!");
+        assert(desc->instance_offset <= UINT32_MAX);
+        pInstances = (uint8_t*)desc->instance_buffer->cpu_mapped_address + desc->instance_offset;
+    }
+
+    uint32_t boundPipeline      = UINT32_MAX;
+    uint32_t boundBindTable     = UINT32_MAX;
+    uint32_t boundGeometry      = UINT32_MAX;
+    const uint8_t* pBoundPush   = nullptr;
+    GPURootSignatureID pBoundRS = nullptr;
+    for (uint32_t i = 0; i < count;)
+    {
+        uint32_t run = 1;
+        while (i + run < count && CanMerge(i, i + run)) run++;
+        const uint64_t key       = StateBits(mKeys[i]);
+        const uint32_t draw      = mOrder[i];
+        const uint32_t pipeline  = (uint32_t)(key >> GPU_DRAW_LIST_PIPELINE_SHIFT) & (GPU_DRAW_LIST_MAX_PIPELINES - 1);
+        const uint32_t bindTable = (uint32_t)(key >> GPU_DRAW_LIST_BIND_TABLE_SHIFT) & (GPU_DRAW_LIST_MAX_BIND_TABLES - 1);
+        const uint32_t geometry  = (uint32_t)(key >> GPU_DRAW_LIST_GEOMETRY_SHIFT) & (GPU_DRAW_LIST_MAX_GEOMETRIES - 1);
+
+        if (pipeline != boundPipeline)
+        {
+            GPURenderEncoderBindPipeline(encoder, mPipelines[pipeline]);
+            // a new layout may have disturbed the sets and push constants
+            if (mPipelines[pipeline]->pRootSignature != pBoundRS)
+            {
+                pBoundRS       = mPipelines[pipeline]->pRootSignature;
+                boundBindTable = UINT32_MAX;
+                pBoundPush     = nullptr;
+            }
+            boundPipeline = pipeline;
+            stats.pipeline_binds++;
+        }
+        if (bindTable != boundBindTable)
+        {
+            GPUBindTableID pTable = bindTable ? mBindTables[bindTable - 1] : desc->default_bind_table;
+            if (pTable)
+            {
+                GPURenderEncoderBindBindTable(encoder, pTable);
+                stats.bind_table_binds++;
+            }
+            boundBindTable = bindTable;
+        }
+        const Geometry& g = mGeometries[geometry];
+        if (geometry != boundGeometry)
+        {
+            GPUBufferID buffers[GPU_MAX_VERTEX_ATTRIBS + 1];
+            uint32_t strides[GPU_MAX_VERTEX_ATTRIBS + 1];
+            uint32_t offsets[GPU_MAX_VERTEX_ATTRIBS + 1];
+            uint32_t buffersCount = g.vertexBuffersCount;
+            memcpy(buffers, g.vertexBuffers, sizeof(GPUBufferID) * buffersCount);
+            memcpy(strides, g.strides, sizeof(uint32_t) * buffersCount);
+            memcpy(offsets, g.offsets, sizeof(uint32_t) * buffersCount);
+            if (pInstances)
+            {
+                buffers[buffersCount] = desc->instance_buffer;
+                strides[buffersCount] = mInstanceDataSize;
+                offsets[buffersCount] = (uint32_t)desc->instance_offset;
+                buffersCount++;
+            }
+            if (buffersCount) GPURenderEncoderBindVertexBuffers(encoder, buffersCount, buffers, strides, offsets);
+            if (g.indexBuffer) GPURenderEncoderBindIndexBuffer(encoder, g.indexBuffer, g.indexOffset, g.indexStride);
+            boundGeometry = geometry;
+            stats.geometry_binds++;
+        }
+        if (mPushDataSize)
+        {
+            const uint8_t* pPush = &mPushData[(uint64_t)draw * mPushDataSize];
+            if (!pBoundPush || memcmp(pBoundPush, pPush, mPushDataSize))
+            {
+                GPURenderEncoderPushConstants(encoder, pBoundRS, m_pPushConstName, pPush);
+                pBoundPush = pPush;
+            }
+        }
+        // instance data is laid out in sorted order, the run starts at instance i
+        if (pInstances)
+        {
+            for (uint32_t j = 0; j < run; j++)
+            {
+                memcpy(pInstances + (uint64_t)(i + j) * mInstanceDataSize, &mInstanceData[(uint64_t)mOrder[i + j] * mInstanceDataSize], mInstanceDataSize);
+            }
+        }
+        const uint32_t firstInstance = pInstances ? i : 0;
+        if (g.indexBuffer)
+            GPURenderEncoderDrawIndexedInstanced(encoder, mCounts[draw], run, mFirsts[draw], mVertexOffsets[draw], firstInstance);
+        else
+            GPURenderEncoderDrawInstanced(encoder, mCounts[draw], run, mFirsts[draw], firstInstance);
+        stats.draw_calls++;
+        i += run;
+    }
+    return stats;
+}
+
+void GPUDrawList::Reset()
+{
+    mKeys.clear();
+    mOrder.clear();
+    mCounts.clear();
+    mFirsts.clear();
+    mVertexOffsets.clear();
+    mPushData.clear();
+    mInstanceData.clear();
+    mPipelines.clear();
+    mBindTables.clear();
+    mGeometries.clear();
+    mPipelineIndices.clear();
+    mBindTableIndices.clear();
+    mGeometryIndices.clear();
+    mSorted = true;
+}
+
+GPUDrawListID GPUCreateDrawList(GPUDeviceID device, const GPUDrawListDescriptor* desc)
+{
+    return GPUDrawList::Create(device, desc);
+}
+
+void GPUFreeDrawList(GPUDrawListID list)
+{
+    GPUDrawList::Free(list);
+}
+
+void GPUDrawListRecord(GPUDrawListID list, const GPUDrawPacket* packet)
+{
+    ((GPUDrawList*)list)->Record(packet);
+}
+
+GPUDrawListStats GPUDrawListReplay(GPUDrawListID list, GPURenderPassEncoderID encoder, const GPUDrawListReplayDescriptor* desc)
+{
+    return ((GPUDrawList*)list)->Replay(encoder, desc);
+}
+
+void GPUDrawListReset(GPUDrawListID list)
+{
+    ((GPUDrawList*)list)->Reset();
+}
@@ -0,0 +1,184 @@
+#include "GPUReflectionBlob.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <cstring>
+
+static_assert(sizeof(void*) == sizeof(uint64_t), "reflection blobs store pointers as 64-bit offsets");
+
+#define GPU_REFLECTION_BLOB_NULL UINTPTR_MAX
+
+template <typename T>
+static T* ReflectionBlob_Encode(uint64_t offset)
+{
+    return (T*)(uintptr_t)offset;
+}
+
+// offsets come from outside, an array has to lie inside the payload and a string has to end in it
+template <typename T>
+static bool ReflectionBlob_Relocate(T*& ptr, uint8_t* base, uint64_t size, uint64_t count)
+{
+    const uint64_t offset = (uintptr_t)ptr;
+    if (offset == GPU_REFLECTION_BLOB_NULL)
+    {
+        ptr = nullptr;
+        return count == 0;
+    }
+    if (offset % alignof(T) || offset > size || count > (size - offset) / sizeof(T)) return false;
+    ptr = (T*)(base + offset);
+    return true;
+}
+
+static bool ReflectionBlob_RelocateString(const char8_t*& str, uint8_t* base, uint64_t size)
+{
+    const uint64_t offset = (uintptr_t)str;
+    if (offset == GPU_REFLECTION_BLOB_NULL)
+    {
+        str = nullptr;
+        return true;
+    }
+    if (offset >= size || !memchr(base + offset, 0, size - offset)) return false;
+    str = (const char8_t*)(base + offset);
+    return true;
+}
+
+static uint64_t ReflectionBlob_StringSize(const char8_t* str)
+{
+    return str ? strlen((const char*)str) + 1 : 0;
+}
+
+uint64_t GPUSerializeShaderReflection(GPUShaderLibraryID library, void* dst, uint64_t dst_size)
+{
+    uint64_t inputs_count    = 0;
+    uint64_t resources_count = 0;
+    uint64_t constants_count = 0;
+    uint64_t strings_size    = 0;
+    for (uint32_t i = 0; i < library->entrys_count; i++)
+    {
+        const GPUShaderReflection& entry = library->entry_reflections[i];
+        strings_size += ReflectionBlob_StringSize(entry.entry_name);
+        for (uint32_t j = 0; j < entry.vertex_inputs_count; j++)
+        {
+            strings_size += ReflectionBlob_StringSize(entry.vertex_inputs[j].name);
+            strings_size += ReflectionBlob_StringSize(entry.vertex_inputs[j].semantics);
+        }
+        for (uint32_t j = 0; j < entry.shader_resources_count; j++)
+        {
+            strings_size += ReflectionBlob_StringSize(entry.shader_resources[j].name);
+        }
+        for (uint32_t j = 0; j < entry.spec_constants_count; j++)
+        {
+            strings_size += ReflectionBlob_StringSize(entry.spec_constants[j].name);
+        }
+        inputs_count += entry.vertex_inputs_count;
+        resources_count += entry.shader_resources_count;
+        constants_count += entry.spec_constants_count;
+    }
+    const uint64_t inputs_offset    = library->entrys_count * sizeof(GPUShaderReflection);
+    const uint64_t resources_offset = inputs_offset + inputs_count * sizeof(GPUVertexInput);
+    const uint64_t constants_offset = resources_offset + resources_count * sizeof(GPUShaderResource);
+    const uint64_t strings_offset   = constants_offset + constants_count * sizeof(GPUShaderSpecConstant);
+    const uint64_t size             = sizeof(GPUReflectionBlobHeader) + strings_offset + strings_size;
+    if (!dst) return size;
+    assert(dst_size >= size && "reflection blob does not fit!");
+
+    memset(dst, 0, size);
+    GPUReflectionBlobHeader* header = (GPUReflectionBlobHeader*)dst;
+    header->magic                   = GPU_REFLECTION_BLOB_MAGIC;
+    header->version                 = GPU_REFLECTION_BLOB_VERSION;
+    header->entrys_count            = library->entrys_count;
+    header->size                    = size;
+
+    uint8_t* payload                 = (uint8_t*)(header + 1);
+    GPUShaderReflection* entries     = (GPUShaderReflection*)payload;
+    GPUVertexInput* inputs           = (GPUVertexInput*)(payload + inputs_offset);
+    GPUShaderResource* resources     = (GPUShaderResource*)(payload + resources_offset);
+    GPUShaderSpecConstant* constants = (GPUShaderSpecConstant*)(payload + constants_offset);
+    uint64_t string_cursor           = strings_offset;
+    auto WriteString                 = [&](const char8_t* str) {
+        if (!str) return ReflectionBlob_Encode<const char8_t>(GPU_REFLECTION_BLOB_NULL);
+        const uint64_t str_size = ReflectionBlob_StringSize(str);
+        memcpy(payload + string_cursor, str, str_size);
+        string_cursor += str_size;
+        return ReflectionBlob_Encode<const char8_t>(string_cursor - str_size);
+    };
+
+    uint64_t input_cursor    = 0;
+    uint64_t resource_cursor = 0;
+    uint64_t constant_cursor = 0;
+    for (uint32_t i = 0; i < library->entrys_count; i++)
+    {
+        const GPUShaderReflection& entry = library->entry_reflections[i];
+        GPUShaderReflection& out         = entries[i];
+        out                              = entry;
+        out.entry_name                   = WriteString(entry.entry_name);
+        out.vertex_inputs                = ReflectionBlob_Encode<GPUVertexInput>(entry.vertex_inputs_count ? inputs_offset + input_cursor * sizeof(GPUVertexInput) : GPU_REFLECTION_BLOB_NULL);
+        out.shader_resources             = ReflectionBlob_Encode<GPUShaderResource>(entry.shader_resources_count ? resources_offset + resource_cursor * sizeof(GPUShaderResource) : GPU_REFLECTION_BLOB_NULL);
+        out.spec_constants               = ReflectionBlob_Encode<GPUShaderSpecConstant>(entry.spec_constants_count ? constants_offset + constant_cursor * sizeof(GPUShaderSpecConstant) : GPU_REFLECTION_BLOB_NULL);
+        for (uint32_t j = 0; j < entry.vertex_inputs_count; j++, input_cursor++)
+        {
+            inputs[input_cursor]           = entry.vertex_inputs[j];
+            inputs[input_cursor].name      = WriteString(entry.vertex_inputs[j].name);
+            inputs[input_cursor].semantics = WriteString(entry.vertex_inputs[j].semantics);
+        }
+        for (uint32_t j = 0; j < entry.shader_resources_count; j++, resource_cursor++)
+        {
+            resources[resource_cursor]      = entry.shader_resources[j];
+            resources[resource_cursor].name = WriteString(entry.shader_resources[j].name);
+        }
+        for (uint32_t j = 0; j < entry.spec_constants_count; j++, constant_cursor++)
+        {
+            constants[constant_cursor]      = entry.spec_constants[j];
+            constants[constant_cursor].name = WriteString(entry.spec_constants[j].name);
+        }
+    }
+    return size;
+}
+
+bool GPUUtil_LoadShaderReflection(const void* blob, uint64_t size, GPUShaderReflection** entries, uint32_t* entrys_count)
+{
+    const GPUReflectionBlobHeader* header = (const GPUReflectionBlobHeader*)blob;
+    if (size < sizeof(GPUReflectionBlobHeader)) return false;
+    if (header->magic != GPU_REFLECTION_BLOB_MAGIC || header->version != GPU_REFLECTION_BLOB_VERSION || header->size != size) return false;
+    const uint64_t payload_size = size - sizeof(GPUReflectionBlobHeader);
+    if (header->entrys_count > payload_size / sizeof(GPUShaderReflection)) return false;
+    if (header->entrys_count == 0)
+    {
+        *entries      = nullptr;
+        *entrys_count = 0;
+        return true;
+    }
+
+    uint8_t* base               = (uint8_t*)malloc(payload_size);
+    memcpy(base, header + 1, payload_size);
+    GPUShaderReflection* loaded = (GPUShaderReflection*)base;
+    bool valid                  = true;
+    for (uint32_t i = 0; valid && i < header->entrys_count; i++)
+    {
+        GPUShaderReflection& entry = loaded[i];
+        valid = ReflectionBlob_RelocateString(entry.entry_name, base, payload_size) &&
+                ReflectionBlob_Relocate(entry.vertex_inputs, base, payload_size, entry.vertex_inputs_count) &&
+                ReflectionBlob_Relocate(entry.shader_resources, base, payload_size, entry.shader_resources_count) &&
+                ReflectionBlob_Relocate(entry.spec_constants, base, payload_size, entry.spec_constants_count);
+        for (uint32_t j = 0; valid && j < entry.vertex_inputs_count; j++)
+        {
+            valid = ReflectionBlob_RelocateString(entry.vertex_inputs[j].name, base, payload_size) &&
+                    ReflectionBlob_RelocateString(entry.vertex_inputs[j].semantics, base, payload_size);
+        }
+        for (uint32_t j = 0; valid && j < entry.shader_resources_count; j++)
+        {
+            valid = ReflectionBlob_RelocateString(entry.shader_resources[j].name, base, payload_size);
+        }
+        for (uint32_t j = 0; valid && j < entry.spec_constants_count; j++)
+        {
+            valid = ReflectionBlob_RelocateString(entry.spec_constants[j].name, base, payload_size);
+        }
+    }
+    if (!valid)
+    {
+        free(base);
+        return false;
+    }
+    *entries      = loaded;
+    *entrys_count = header->entrys_count;
+    return true;
+}
@@ -0,0 +1,458 @@
+#include "GPUUploader.hpp"
+#include "Utils.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <assert.h>
+
+#define GPU_UPLOADER_DEFAULT_RING_SIZE (64ull * 1024 * 1024)
+#define GPU_UPLOADER_BUFFER_ALIGNMENT 16
+// covers optimalBufferCopyOffsetAlignment of the drivers we know, texture offsets are also kept on texel blocks
+#define GPU_UPLOADER_TEXTURE_ALIGNMENT 256
+
+// regions of one copy command have no order, an upload that rewrites bytes of the batch starts a new copy
+static bool UploaderUtil_Overlaps(const std::vector<GPUBufferToBufferRegion>& regions, uint64_t dst_offset, uint64_t size)
+{
+    for (const auto& region : regions)
+    {
+        if (dst_offset < region.dst_offset + region.size && region.dst_offset < dst_offset + size) return true;
+    }
+    return false;
+}
+
+static bool UploaderUtil_Overlaps(const std::vector<GPUBufferToTextureRegion>& regions, const GPUTextureSubresource& sub)
+{
+    // no aspects means all aspects of the texture
+    const uint32_t aspects = sub.aspects ? sub.aspects : ~0u;
+    for (const auto& region : regions)
+    {
+        const GPUTextureSubresource& other = region.dst_subresource;
+        if (other.mip_level == sub.mip_level && ((other.aspects ? other.aspects : ~0u) & aspects) &&
+            sub.base_array_layer < other.base_array_layer + other.layer_count && other.base_array_layer < sub.base_array_layer + sub.layer_count)
+            return true;
+    }
+    return false;
+}
+
+template <typename Barrier>
+static bool UploaderUtil_SameTransition(const Barrier& a, const Barrier& b)
+{
+    return a.src_state == b.src_state && a.dst_state == b.dst_state && a.queue_release == b.queue_release && a.queue_type == b.queue_type;
+}
+
+template <typename Barrier>
+static bool UploaderUtil_IsNoop(const Barrier& barrier)
+{
+    return barrier.src_state == barrier.dst_state && !barrier.queue_release;
+}
+
+// one barrier per buffer, a buffer has no subresources so its uploads have to agree on the states
+static void UploaderUtil_MergeBarriers(std::vector<GPUBufferBarrier>& barriers)
+{
+    std::unordered_map<GPUBufferID, size_t> merged;
+    size_t count = 0;
+    for (size_t i = 0; i < barriers.size(); i++)
+    {
+        const GPUBufferBarrier barrier = barriers[i];
+        const auto found               = merged.find(barrier.buffer);
+        if (found != merged.end())
+        {
+            assert(UploaderUtil_SameTransition(barriers[found->second], barrier) && "uploads into one buffer disagree on its states!");
+            continue;
+        }
+        merged.emplace(barrier.buffer, count);
+        barriers[count++] = barrier;
+    }
+    barriers.resize(count);
+    barriers.erase(std::remove_if(barriers.begin(), barriers.end(), UploaderUtil_IsNoop<GPUBufferBarrier>), barriers.end());
+}
+
+// one barrier per texture, or one per written subresource when its uploads disagree on the states,
+// subresources[i] is the range written by the upload of barriers[i]
+static void UploaderUtil_MergeBarriers(std::vector<GPUTextureBarrier>& barriers, const std::vector<GPUTextureSubresource>& subresources)
+{
+    std::unordered_map<GPUTextureID, std::pair<size_t, bool>> uniform;
+    for (size_t i = 0; i < barriers.size(); i++)
+    {
+        auto [it, inserted] = uniform.emplace(barriers[i].texture, std::make_pair(i, true));
+        if (!inserted) it->second.second &= UploaderUtil_SameTransition(barriers[it->second.first], barriers[i]);
+    }
+
+    std::vector<GPUTextureBarrier> merged;
+    std::set<std::tuple<GPUTextureID, uint32_t, uint32_t>> written;
+    for (size_t i = 0; i < barriers.size(); i++)
+    {
+        const auto& [first, whole] = uniform[barriers[i].texture];
+        if (whole)
+        {
+            if (first == i && !UploaderUtil_IsNoop(barriers[i])) merged.push_back(barriers[i]);
+            continue;
+        }
+        const GPUTextureSubresource& sub = subresources[i];
+        for (uint32_t layer = sub.base_array_layer; layer < sub.base_array_layer + std::max(sub.layer_count, 1u); layer++)
+        {
+            if (!written.emplace(barriers[i].texture, sub.mip_level, layer).second || UploaderUtil_IsNoop(barriers[i])) continue;
+            GPUTextureBarrier& barrier  = merged.emplace_back(barriers[i]);
+            barrier.subresource_barrier = 1;
+            barrier.mip_level           = (uint8_t)sub.mip_level;
+            barrier.array_layer         = (uint16_t)layer;
+        }
+    }
+    barriers.swap(merged);
+}
+
+GPUUploaderID GPUUploader::Create(GPUDeviceID device, const GPUUploaderDescriptor* desc)
+{
+    assert(desc->queue);
+    GPUUploader* pUploader = new (_aligned_malloc(sizeof(GPUUploader), _alignof(GPUUploader))) GPUUploader();
+    pUploader->m_pDevice   = device;
+    pUploader->m_pQueue    = desc->queue;
+    pUploader->mRingSize   = desc->ring_size ? desc->ring_size : GPU_UPLOADER_DEFAULT_RING_SIZE;
+    pUploader->m_pTimeline = GPUCreateTimelineSemaphore(device, 0);
+
+    GPUBufferDescriptor ring_desc{};
+    ring_desc.size         = pUploader->mRingSize;
+    ring_desc.flags        = GPU_BCF_OWN_MEMORY_BIT | GPU_BCF_PERSISTENT_MAP_BIT;
+    ring_desc.descriptors  = GPU_RESOURCE_TYPE_NONE;
+    ring_desc.memory_usage = GPU_MEM_USAGE_CPU_ONLY;
+    pUploader->m_pRing     = GPUCreateBuffer(device, &ring_desc);
+    assert(pUploader->m_pRing->cpu_mapped_address);
+
+    GPUCommandBufferDescriptor cmd_desc{};
+    cmd_desc.isSecondary = false;
+    for (uint32_t i = 0; i < GPU_UPLOADER_CMD_COUNT; i++)
+    {
+        pUploader->m_pPools[i] = GPUCreateCommandPool(desc->queue);
+        pUploader->m_pCmds[i]  = GPUCreateCommandBuffer(pUploader->m_pPools[i], &cmd_desc);
+    }
+
+    return pUploader;
+}
+
+void GPUUploader::Free(GPUUploaderID uploader)
+{
+    if (uploader)
+    {
+        GPUUploader* pUploader = (GPUUploader*)uploader;
+        pUploader->Wait(pUploader->Flush());
+        for (uint32_t i = 0; i < GPU_UPLOADER_CMD_COUNT; i++)
+        {
+            GPUFreeCommandBuffer(pUploader->m_pCmds[i]);
+            GPUFreeCommandPool(pUploader->m_pPools[i]);
+        }
+        GPUFreeBuffer(pUploader->m_pRing);
+        GPUFreeSemaphore(pUploader->m_pTimeline);
+        pUploader->~GPUUploader();
+        _aligned_free(pUploader);
+    }
+}
+
+GPUUploadToken GPUUploader::Enqueue(const GPUUploadBatch* batch)
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    // nothing to wait for, the last submission is already as good as any
+    if (!batch->buffers_count && !batch->textures_count) return mNextToken - 1;
+    uint8_t* pMapped = (uint8_t*)m_pRing->cpu_mapped_address;
+    for (uint32_t i = 0; i < batch->buffers_count; i++)
+    {
+        const GPUBufferUpload& upload = batch->buffers[i];
+        const uint64_t offset         = Allocate(lock, upload.size, GPU_UPLOADER_BUFFER_ALIGNMENT);
+        memcpy(pMapped + offset, upload.data, upload.size);
+        mPendingBuffers.push_back({ upload, offset, batch->dst_queue_type });
+    }
+    for (uint32_t i = 0; i < batch->textures_count; i++)
+    {
+        const GPUTextureUpload& upload = batch->textures[i];
+        const uint64_t blockBytes      = Utils::FormatUtil_BitSizeOfBlock((EGPUFormat)upload.dst->format) / 8;
+        assert(blockBytes && "unknown texel block size!");
+        const uint64_t offset = Allocate(lock, upload.size, std::lcm<uint64_t>(GPU_UPLOADER_TEXTURE_ALIGNMENT, blockBytes));
+        memcpy(pMapped + offset, upload.data, upload.size);
+        mPendingTextures.push_back({ upload, offset, batch->dst_queue_type });
+    }
+    return mNextToken;
+}
+
+GPUUploadToken GPUUploader::Flush()
+{
+    std::lock_guard<std::mutex> guard(mLock);
+    return FlushLocked();
+}
+
+bool GPUUploader::IsComplete(GPUUploadToken token) const
+{
+    return GPUQuerySemaphoreValue(m_pTimeline) >= token;
+}
+
+void GPUUploader::Wait(GPUUploadToken token)
+{
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        if (token >= mNextToken)
+        {
+            assert(token == mNextToken && "upload token was never handed out!");
+            token = FlushLocked();
+        }
+    }
+    if (token) GPUWaitSemaphores(&m_pTimeline, &token, 1, UINT64_MAX);
+}
+
+// ranges are handed out in token order, so the tail only has to follow the retired ones,
+// the lock is dropped while waiting for the gpu so other threads can keep flushing and polling
+uint64_t GPUUploader::Allocate(std::unique_lock<std::mutex>& lock, uint64_t size, uint64_t alignment)
+{
+    assert(size < mRingSize && "upload does not fit into the staging ring!");
+    for (;;)
+    {
+        Retire();
+        // head == tail means empty, a range never ends right on the tail
+        const uint64_t offset = (mHead + alignment - 1) / alignment * alignment;
+        uint64_t start        = UINT64_MAX;
+        if (mHead >= mTail)
+        {
+            if (offset + size <= mRingSize)
+                start = offset;
+            else if (size < mTail)
+                start = 0;
+        }
+        else if (offset + size < mTail)
+        {
+            start = offset;
+        }
+
+        if (start != UINT64_MAX)
+        {
+            mHead = start + size;
+            if (!mInflightRanges.empty() && mInflightRanges.back().token == mNextToken)
+                mInflightRanges.back().end = mHead;
+            else
+                mInflightRanges.push_back({ mNextToken, mHead });
+            return start;
+        }
+
+        // ring is full, make the pending copies retirable and wait for the oldest range
+        if (mInflightRanges.front().token == mNextToken) FlushLocked();
+        GPUUploadToken oldest = mInflightRanges.front().token;
+        lock.unlock();
+        GPUWaitSemaphores(&m_pTimeline, &oldest, 1, UINT64_MAX);
+        lock.lock();
+    }
+}
+
+void GPUUploader::Retire()
+{
+    const uint64_t completed = GPUQuerySemaphoreValue(m_pTimeline);
+    while (!mInflightRanges.empty() && mInflightRanges.front().token <= completed)
+    {
+        mTail = mInflightRanges.front().end;
+        mInflightRanges.pop_front();
+    }
+    if (mInflightRanges.empty()) mHead = mTail = 0;
+}
+
+GPUUploadToken GPUUploader::FlushLocked()
+{
+    if (mPendingBuffers.empty() && mPendingTextures.empty()) return mNextToken - 1;
+
+    const GPUUploadToken token = mNextToken++;
+    const uint32_t slot        = token % GPU_UPLOADER_CMD_COUNT;
+    if (mCmdTokens[slot]) GPUWaitSemaphores(&m_pTimeline, &mCmdTokens[slot], 1, UINT64_MAX);
+    mCmdTokens[slot] = token;
+
+    GPUCommandBufferID cmd = m_pCmds[slot];
+    GPUResetCommandPool(m_pPools[slot]);
+    GPUCmdBegin(cmd);
+    {
+        std::vector<GPUBufferBarrier> bufferBarriers;
+        std::vector<GPUTextureBarrier> textureBarriers;
+        std::vector<GPUTextureSubresource> textureSubresources;
+        for (const auto& copy : mPendingBuffers)
+        {
+            GPUBufferBarrier barrier{};
+            barrier.buffer    = copy.upload.dst;
+            barrier.src_state = copy.upload.src_state;
+            barrier.dst_state = GPU_RESOURCE_STATE_COPY_DEST;
+            bufferBarriers.push_back(barrier);
+        }
+        for (const auto& copy : mPendingTextures)
+        {
+            GPUTextureBarrier barrier{};
+            barrier.texture   = copy.upload.dst;
+            barrier.src_state = copy.upload.src_state;
+            barrier.dst_state = GPU_RESOURCE_STATE_COPY_DEST;
+            textureBarriers.push_back(barrier);
+            textureSubresources.push_back(copy.upload.dst_subresource);
+        }
+        UploaderUtil_MergeBarriers(bufferBarriers);
+        UploaderUtil_MergeBarriers(textureBarriers, textureSubresources);
+        GPUResourceBarrierDescriptor barrier_desc{};
+        barrier_desc.buffer_barriers        = bufferBarriers.data();
+        barrier_desc.buffer_barriers_count  = (uint32_t)bufferBarriers.size();
+        barrier_desc.texture_barriers       = textureBarriers.data();
+        barrier_desc.texture_barriers_count = (uint32_t)textureBarriers.size();
+        if (!bufferBarriers.empty() || !textureBarriers.empty()) GPUCmdResourceBarrier(cmd, &barrier_desc);
+
+        // consecutive uploads into the same resource share one copy command as long as they do not overlap,
+        // a copy that rewrites what an earlier copy of this flush wrote waits for it behind a write-after-write barrier
+        std::unordered_map<GPUBufferID, std::vector<GPUBufferToBufferRegion>> bufferWrites;
+        std::vector<GPUBufferToBufferRegion> bufferRegions;
+        for (size_t i = 0; i < mPendingBuffers.size(); i++)
+        {
+            const auto& copy                = mPendingBuffers[i];
+            GPUBufferToBufferRegion& region = bufferRegions.emplace_back();
+            region.src_offset               = copy.offset;
+            region.dst_offset               = copy.upload.dst_offset;
+            region.size                     = copy.upload.size;
+            if (i + 1 < mPendingBuffers.size() && mPendingBuffers[i + 1].upload.dst == copy.upload.dst &&
+                !UploaderUtil_Overlaps(bufferRegions, mPendingBuffers[i + 1].upload.dst_offset, mPendingBuffers[i + 1].upload.size)) continue;
+
+            std::vector<GPUBufferToBufferRegion>& written = bufferWrites[copy.upload.dst];
+            const bool rewrites = std::any_of(bufferRegions.begin(), bufferRegions.end(), [&](const GPUBufferToBufferRegion& r) {
+                return UploaderUtil_Overlaps(written, r.dst_offset, r.size);
+            });
+            if (rewrites)
+            {
+                GPUBufferBarrier waw{};
+                waw.buffer    = copy.upload.dst;
+                waw.src_state = GPU_RESOURCE_STATE_COPY_DEST;
+                waw.dst_state = GPU_RESOURCE_STATE_COPY_DEST;
+                GPUResourceBarrierDescriptor waw_desc{};
+                waw_desc.buffer_barriers       = &waw;
+                waw_desc.buffer_barriers_count = 1;
+                GPUCmdResourceBarrier(cmd, &waw_desc);
+            }
+            written.insert(written.end(), bufferRegions.begin(), bufferRegions.end());
+
+            GPUBufferToBufferRegions transfer{};
+            transfer.dst           = copy.upload.dst;
+            transfer.src           = m_pRing;
+            transfer.regions       = bufferRegions.data();
+            transfer.regions_count = (uint32_t)bufferRegions.size();
+            GPUCmdTransferBufferToBufferRegions(cmd, &transfer);
+            bufferRegions.clear();
+        }
+        // the other subresources of a texture may be in any state, only the rewritten ones get the barrier
+        std::unordered_map<GPUTextureID, std::vector<GPUBufferToTextureRegion>> textureWrites;
+        std::vector<GPUBufferToTextureRegion> textureRegions;
+        for (size_t i = 0; i < mPendingTextures.size(); i++)
+        {
+            const auto& copy                 = mPendingTextures[i];
+            GPUBufferToTextureRegion& region = textureRegions.emplace_back();
+            region.src_offset                = copy.offset;
+            region.dst_subresource           = copy.upload.dst_subresource;
+            if (i + 1 < mPendingTextures.size() && mPendingTextures[i + 1].upload.dst == copy.upload.dst &&
+                !UploaderUtil_Overlaps(textureRegions, mPendingTextures[i + 1].upload.dst_subresource)) continue;
+
+            std::vector<GPUBufferToTextureRegion>& written = textureWrites[copy.upload.dst];
+            std::vector<GPUTextureBarrier> waws;
+            for (const auto& r : textureRegions)
+            {
+                if (!UploaderUtil_Overlaps(written, r.dst_subresource)) continue;
+                const GPUTextureSubresource& sub = r.dst_subresource;
+                for (uint32_t layer = sub.base_array_layer; layer < sub.base_array_layer + std::max(sub.layer_count, 1u); layer++)
+                {
+                    GPUTextureBarrier& waw  = waws.emplace_back();
+                    waw.texture             = copy.upload.dst;
+                    waw.src_state           = GPU_RESOURCE_STATE_COPY_DEST;
+                    waw.dst_state           = GPU_RESOURCE_STATE_COPY_DEST;
+                    waw.subresource_barrier = 1;
+                    waw.mip_level           = (uint8_t)sub.mip_level;
+                    waw.array_layer         = (uint16_t)layer;
+                }
+            }
+            if (!waws.empty())
+            {
+                GPUResourceBarrierDescriptor waw_desc{};
+                waw_desc.texture_barriers       = waws.data();
+                waw_desc.texture_barriers_count = (uint32_t)waws.size();
+                GPUCmdResourceBarrier(cmd, &waw_desc);
+            }
+            written.insert(written.end(), textureRegions.begin(), textureRegions.end());
+
+            GPUBufferToTextureRegions transfer{};
+            transfer.dst           = copy.upload.dst;
+            transfer.src           = m_pRing;
+            transfer.regions       = textureRegions.data();
+            transfer.regions_count = (uint32_t)textureRegions.size();
+            GPUCmdTransferBufferToTextureRegions(cmd, &transfer);
+            textureRegions.clear();
+        }
+
+        // hand the resources over to their consumer queue
+        bufferBarriers.clear();
+        textureBarriers.clear();
+        for (const auto& copy : mPendingBuffers)
+        {
+            GPUBufferBarrier barrier{};
+            barrier.buffer        = copy.upload.dst;
+            barrier.src_state     = GPU_RESOURCE_STATE_COPY_DEST;
+            barrier.dst_state     = copy.upload.dst_state;
+            barrier.queue_release = copy.dstQueueType != m_pQueue->queueType;
+            barrier.queue_type    = copy.dstQueueType;
+            bufferBarriers.push_back(barrier);
+        }
+        for (const auto& copy : mPendingTextures)
+        {
+            GPUTextureBarrier barrier{};
+            barrier.texture       = copy.upload.dst;
+            barrier.src_state     = GPU_RESOURCE_STATE_COPY_DEST;
+            barrier.dst_state     = copy.upload.dst_state;
+            barrier.queue_release = copy.dstQueueType != m_pQueue->queueType;
+            barrier.queue_type    = copy.dstQueueType;
+            textureBarriers.push_back(barrier);
+        }
+        UploaderUtil_MergeBarriers(bufferBarriers);
+        UploaderUtil_MergeBarriers(textureBarriers, textureSubresources);
+        barrier_desc.buffer_barriers        = bufferBarriers.data();
+        barrier_desc.buffer_barriers_count  = (uint32_t)bufferBarriers.size();
+        barrier_desc.texture_barriers       = textureBarriers.data();
+        barrier_desc.texture_barriers_count = (uint32_t)textureBarriers.size();
+        if (!bufferBarriers.empty() || !textureBarriers.empty()) GPUCmdResourceBarrier(cmd, &barrier_desc);
+    }
+    GPUCmdEnd(cmd);
+
+    GPUQueueSubmitDescriptor submit_desc{};
+    submit_desc.cmds                   = &cmd;
+    submit_desc.cmds_count             = 1;
+    submit_desc.signal_semaphores      = &m_pTimeline;
+    submit_desc.signal_values          = &token;
+    submit_desc.signal_semaphore_count = 1;
+    GPUSubmitQueue(m_pQueue, &submit_desc);
+
+    mPendingBuffers.clear();
+    mPendingTextures.clear();
+    return token;
+}
+
+/////////////////////////////////////////////////////
+GPUUploaderID GPUCreateUploader(GPUDeviceID device, const GPUUploaderDescriptor* desc)
+{
+    return GPUUploader::Create(device, desc);
+}
+
+void GPUFreeUploader(GPUUploaderID uploader)
+{
+    GPUUploader::Free(uploader);
+}
+
+GPUUploadToken GPUUploaderEnqueue(GPUUploaderID uploader, const GPUUploadBatch* batch)
+{
+    return ((GPUUploader*)uploader)->Enqueue(batch);
+}
+
+GPUUploadToken GPUUploaderFlush(GPUUploaderID uploader)
+{
+    return ((GPUUploader*)uploader)->Flush();
+}
+
+bool GPUUploaderIsComplete(GPUUploaderID uploader, GPUUploadToken token)
+{
+    return uploader->IsComplete(token);
+}
+
+void GPUUploaderWait(GPUUploaderID uploader, GPUUploadToken token)
+{
+    ((GPUUploader*)uploader)->Wait(token);
+}
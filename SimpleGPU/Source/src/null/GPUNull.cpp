@@ -0,0 +1,874 @@
+#include "backend/null/GPUNull.h"
+#include <assert.h>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <unordered_map>
+#include "Utils.h"
+#include "GPUReflectionBlob.h"
+#ifdef GPU_USE_VULKAN
+    // shader reflection and parameter tables are SPIR-V based and shared with the vulkan backend
+    #include "backend/vulkan/GPUVulkan.h"
+    #include "backend/vulkan/GPUVulkanUtils.h"
+#endif
+
+typedef std::chrono::steady_clock GPUNullClock;
+
+typedef struct GPUInstance_Null
+{
+    GPUInstance super;
+    GPUNullClock::duration completionDelay;
+    bool validateBarriers;
+} GPUInstance_Null;
+
+typedef struct GPUAdapter_Null
+{
+    GPUAdapter super;
+} GPUAdapter_Null;
+
+typedef struct GPUDevice_Null
+{
+    GPUDevice super;
+    const GPUInstance_Null* pInstance;
+} GPUDevice_Null;
+
+typedef struct GPUQueue_Null
+{
+    GPUQueue super;
+} GPUQueue_Null;
+
+typedef struct GPUFence_Null
+{
+    GPUFence super;
+    bool submitted;
+    GPUNullClock::time_point completion;
+} GPUFence_Null;
+
+typedef struct GPUSemaphore_Null
+{
+    GPUSemaphore super;
+    std::mutex lock;
+    std::condition_variable signaled; // wakes waiters that sleep until a later submission completes
+    uint64_t value;
+    // signals that are submitted but not yet complete, as (value, completion)
+    std::vector<std::pair<uint64_t, GPUNullClock::time_point>> pending;
+} GPUSemaphore_Null;
+
+typedef struct GPUTexture_Null
+{
+    GPUTexture super;
+    EGPUResourceState state;
+    bool stateKnown; // a subresource barrier splits the state, the next whole barrier restores it
+} GPUTexture_Null;
+
+typedef struct GPUBuffer_Null
+{
+    GPUBuffer super;
+    EGPUResourceState state;
+    void* pMemory;
+} GPUBuffer_Null;
+
+typedef struct GPUSwapchain_Null
+{
+    GPUSwapchain super;
+    std::vector<GPUTextureID> backBuffers;
+    uint32_t nextImage;
+} GPUSwapchain_Null;
+
+typedef struct GPUBindlessHeap_Null
+{
+    GPUBindlessHeap super;
+    std::mutex lock;
+    struct Range
+    {
+        std::unordered_map<const void*, uint32_t> indices;
+        std::vector<const void*> owners;
+        std::vector<uint32_t> refs;
+        std::vector<uint32_t> freeList;
+        uint32_t capacity;
+    } ranges[GPU_BINDLESS_RANGE_COUNT];
+} GPUBindlessHeap_Null;
+
+static const GPUInstance_Null* NullUtil_Instance(GPUDeviceID device)
+{
+    return ((const GPUDevice_Null*)device)->pInstance;
+}
+
+static GPUNullClock::time_point NullUtil_CompletionTime(GPUDeviceID device)
+{
+    return GPUNullClock::now() + NullUtil_Instance(device)->completionDelay;
+}
+
+static void NullUtil_PromoteSignals(GPUSemaphore_Null* S, GPUNullClock::time_point now)
+{
+    size_t keep = 0;
+    for (size_t i = 0; i < S->pending.size(); i++)
+    {
+        if (S->pending[i].second <= now)
+            S->value = gpu_max(S->value, S->pending[i].first);
+        else
+            S->pending[keep++] = S->pending[i];
+    }
+    S->pending.resize(keep);
+}
+
+static void NullUtil_SignalSemaphore(GPUSemaphoreID semaphore, uint64_t value, GPUNullClock::time_point completion)
+{
+    // binary semaphores carry no state, waits on them are already satisfied
+    if (!semaphore || !semaphore->timeline) return;
+    GPUSemaphore_Null* S = (GPUSemaphore_Null*)semaphore;
+    std::lock_guard<std::mutex> guard(S->lock);
+    S->pending.emplace_back(value, completion);
+    NullUtil_PromoteSignals(S, GPUNullClock::now());
+    S->signaled.notify_all();
+}
+
+static void NullUtil_SignalFence(GPUFenceID fence, GPUNullClock::time_point completion)
+{
+    if (!fence) return;
+    GPUFence_Null* F = (GPUFence_Null*)fence;
+    F->submitted     = true;
+    F->completion    = completion;
+}
+
+// instance api
+GPUInstanceID GPUCreateInstance_Null(const struct GPUInstanceDescriptor* pDesc)
+{
+    GPUInstance_Null* I = new GPUInstance_Null();
+    I->completionDelay  = GPUNullClock::duration::zero();
+    I->validateBarriers = false;
+    if (pDesc->pChained && pDesc->pChained->backend == GPUBackend_Null)
+    {
+        const GPUNullInstanceDescriptor* chained = (const GPUNullInstanceDescriptor*)pDesc->pChained;
+        I->completionDelay  = std::chrono::duration_cast<GPUNullClock::duration>(std::chrono::microseconds(chained->completion_delay_us));
+        I->validateBarriers = chained->validate_barriers;
+    }
+    return &I->super;
+}
+
+void GPUFreeInstance_Null(GPUInstanceID instance)
+{
+    delete (GPUInstance_Null*)instance;
+}
+
+// adapter
+void GPUEnumerateAdapters_Null(GPUInstanceID /*pInstance*/, GPUAdapterID* const ppAdapters, uint32_t* adapterCount)
+{
+    // a single adapter that lives as long as the process
+    static GPUAdapter_Null adapter = {};
+    *adapterCount                  = 1;
+    if (ppAdapters) ppAdapters[0] = &adapter.super;
+}
+
+// device api
+GPUDeviceID GPUCreateDevice_Null(GPUAdapterID pAdapter, const GPUDeviceDescriptor* /*pDesc*/)
+{
+    GPUDevice_Null* D                   = (GPUDevice_Null*)calloc(1, sizeof(GPUDevice_Null));
+    *(GPUAdapterID*)&D->super.pAdapter = pAdapter;
+    D->pInstance                        = (const GPUInstance_Null*)pAdapter->pInstance;
+    return &D->super;
+}
+
+void GPUFreeDevice_Null(GPUDeviceID pDevice)
+{
+    free((void*)pDevice);
+}
+
+// queue
+GPUQueueID GPUGetQueue_Null(GPUDeviceID pDevice, EGPUQueueType queueType, uint32_t queueIndex)
+{
+    GPUQueue_Null* Q      = new GPUQueue_Null();
+    Q->super.pDevice      = pDevice;
+    Q->super.queueType    = queueType;
+    Q->super.queueIndex   = queueIndex;
+    GPUSemaphoreID timeline = GPUCreateTimelineSemaphore_Null(pDevice, 0);
+    ((GPUSemaphore*)timeline)->device   = pDevice;
+    ((GPUSemaphore*)timeline)->timeline = true;
+    Q->super.timeline     = timeline;
+    return &Q->super;
+}
+
+void GPUFreeQueue_Null(GPUQueueID queue)
+{
+    GPUFreeSemaphore_Null(queue->timeline);
+    delete (GPUQueue_Null*)queue;
+}
+
+void GPUSubmitQueue_Null(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* desc)
+{
+    const GPUNullClock::time_point completion = NullUtil_CompletionTime(queue->pDevice);
+    for (uint32_t i = 0; i < desc->signal_semaphore_count; i++)
+    {
+        NullUtil_SignalSemaphore(desc->signal_semaphores[i], desc->signal_values ? desc->signal_values[i] : 0, completion);
+    }
+    NullUtil_SignalFence(desc->signal_fence, completion);
+    NullUtil_SignalSemaphore(queue->timeline, queue->submitCount, completion);
+}
+
+void GPUSubmitQueueBatches_Null(GPUQueueID queue, const struct GPUQueueBatchSubmitDescriptor* desc)
+{
+    const GPUNullClock::time_point completion = NullUtil_CompletionTime(queue->pDevice);
+    for (uint32_t b = 0; b < desc->batch_count; b++)
+    {
+        const GPUQueueSubmitBatch& batch = desc->batches[b];
+        for (uint32_t i = 0; i < batch.signal_count; i++)
+        {
+            NullUtil_SignalSemaphore(batch.signals[i].semaphore, batch.signals[i].value, completion);
+        }
+    }
+    NullUtil_SignalFence(desc->signal_fence, completion);
+    NullUtil_SignalSemaphore(queue->timeline, queue->submitCount, completion);
+}
+
+uint64_t GPUFlushQueueTransitions_Null(GPUQueueID /*queue*/)
+{
+    // initial states are applied at creation, nothing is ever deferred
+    return 0;
+}
+
+void GPUWaitQueueIdle_Null(GPUQueueID queue)
+{
+    const uint64_t submission = queue->submitCount;
+    GPUWaitSemaphores_Null(&queue->timeline, &submission, 1, UINT64_MAX);
+}
+
+void GPUQueuePresent_Null(GPUQueueID /*queue*/, const struct GPUQueuePresentDescriptor* /*desc*/)
+{
+}
+
+// swapchain
+GPUSwapchainID GPUCreateSwapchain_Null(GPUDeviceID pDevice, GPUSwapchainDescriptor* pDesc)
+{
+    GPUSwapchain_Null* SC = new GPUSwapchain_Null();
+    GPUTextureDescriptor tex_desc{};
+    tex_desc.width        = pDesc->width;
+    tex_desc.height       = pDesc->height;
+    tex_desc.depth        = 1;
+    tex_desc.array_size   = 1;
+    tex_desc.mip_levels   = 1;
+    tex_desc.format       = pDesc->format;
+    tex_desc.sample_count = GPU_SAMPLE_COUNT_1;
+    tex_desc.start_state  = GPU_RESOURCE_STATE_UNDEFINED;
+    for (uint32_t i = 0; i < gpu_max(pDesc->imageCount, 1u); i++)
+    {
+        GPUTexture* T = (GPUTexture*)GPUCreateTexture_Null(pDevice, &tex_desc);
+        T->pDevice    = pDevice;
+        T->ownsImage  = false;
+        SC->backBuffers.push_back(T);
+    }
+    SC->super.ppBackBuffers    = SC->backBuffers.data();
+    SC->super.backBuffersCount = (uint32_t)SC->backBuffers.size();
+    SC->nextImage              = 0;
+    return &SC->super;
+}
+
+void GPUFreeSwapchain_Null(GPUSwapchainID pSwapchain)
+{
+    GPUSwapchain_Null* SC = (GPUSwapchain_Null*)pSwapchain;
+    for (GPUTextureID texture : SC->backBuffers)
+    {
+        GPUFreeTexture_Null(texture);
+    }
+    delete SC;
+}
+
+uint32_t GPUAcquireNextImage_Null(GPUSwapchainID swapchain, const struct GPUAcquireNextDescriptor* desc)
+{
+    GPUSwapchain_Null* SC = (GPUSwapchain_Null*)swapchain;
+    const uint32_t index  = SC->nextImage;
+    SC->nextImage         = (SC->nextImage + 1) % SC->super.backBuffersCount;
+    NullUtil_SignalFence(desc->fence, GPUNullClock::now());
+    return index;
+}
+
+// texture & texture_view api
+GPUTextureViewID GPUCreateTextureView_Null(GPUDeviceID /*pDevice*/, const struct GPUTextureViewDescriptor* /*pDesc*/)
+{
+    return new GPUTextureView();
+}
+
+void GPUFreeTextureView_Null(GPUTextureViewID pTextureView)
+{
+    delete (GPUTextureView*)pTextureView;
+}
+
+GPUTextureID GPUCreateTexture_Null(GPUDeviceID device, const GPUTextureDescriptor* desc)
+{
+    GPUTexture_Null* T          = new GPUTexture_Null();
+    T->super.pDevice            = device;
+    T->super.width              = desc->width;
+    T->super.height             = desc->height;
+    T->super.depth              = desc->depth;
+    T->super.mipLevels          = desc->mip_levels;
+    T->super.arraySizeMinusOne  = desc->array_size - 1;
+    T->super.format             = desc->format;
+    T->super.aspectMask         = Utils::FormatUtil_IsDepthStencilFormat(desc->format) ? (Utils::FormatUtil_IsDepthOnlyFormat(desc->format) ? GPU_TVA_DEPTH : GPU_TVA_DEPTH | GPU_TVA_STENCIL) : GPU_TVA_COLOR;
+    T->super.sizeInBytes        = 0;
+    T->super.isCube             = (desc->descriptors & GPU_RESOURCE_TYPE_TEXTURE_CUBE) != 0;
+    T->super.isDedicated        = desc->is_dedicated;
+    T->super.isAliasing         = desc->is_aliasing;
+    T->super.ownsImage          = true;
+    T->super.uniqueId           = ((GPUDevice*)device)->nextTextureId++;
+    T->state                    = desc->start_state;
+    T->stateKnown               = true;
+    // every mip level of every layer, tightly packed
+    const uint64_t blockBytes = Utils::FormatUtil_BitSizeOfBlock(desc->format) / 8;
+    for (uint32_t mip = 0; mip < gpu_max(1u, desc->mip_levels); mip++)
+    {
+        const uint64_t width  = gpu_max(1u, desc->width >> mip);
+        const uint64_t height = gpu_max(1u, desc->height >> mip);
+        const uint64_t depth  = gpu_max(1u, desc->depth >> mip);
+        T->super.sizeInBytes += width * height * depth * blockBytes;
+    }
+    T->super.sizeInBytes *= gpu_max(1u, desc->array_size);
+    return &T->super;
+}
+
+void GPUFreeTexture_Null(GPUTextureID texture)
+{
+    delete (GPUTexture_Null*)texture;
+}
+
+// shader
+GPUShaderLibraryID GPUCreateShaderLibrary_Null(GPUDeviceID pDevice, const GPUShaderLibraryDescriptor* pDesc)
+{
+#ifdef GPU_USE_VULKAN
+    // a reflection only vulkan library, no shader module is created
+    GPUShaderLibrary_Vulkan* S = (GPUShaderLibrary_Vulkan*)calloc(1, sizeof(GPUShaderLibrary_Vulkan));
+    VulkanUtil_InitializeShaderReflection(pDevice, S, pDesc);
+    return &S->super;
+#else
+    (void)pDevice;
+    GPUShaderLibrary* S = (GPUShaderLibrary*)calloc(1, sizeof(GPUShaderLibrary));
+    // there is no SPIR-V reflection to fall back on, a blob that does not load leaves the library without entries
+    if (pDesc->reflection) GPUUtil_LoadShaderReflection(pDesc->reflection, pDesc->reflectionSize, &S->entry_reflections, &S->entrys_count);
+    return S;
+#endif
+}
+
+void GPUFreeShaderLibrary_Null(GPUShaderLibraryID pShader)
+{
+#ifdef GPU_USE_VULKAN
+    VulkanUtil_FreeShaderReflection((GPUShaderLibrary_Vulkan*)pShader);
+#else
+    free(pShader->entry_reflections);
+#endif
+    free((void*)pShader);
+}
+
+// pipeline
+GPURenderPipelineID GPUCreateRenderPipeline_Null(GPUDeviceID /*pDevice*/, const GPURenderPipelineDescriptor* /*pDesc*/)
+{
+    return new GPURenderPipeline();
+}
+
+void GPUFreeRenderPipeline_Null(GPURenderPipelineID pPipeline)
+{
+    delete (GPURenderPipeline*)pPipeline;
+}
+
+GPUComputePipelineID GPUCreateComputePipeline_Null(GPUDeviceID /*pDevice*/, const GPUComputePipelineDescriptor* /*pDesc*/)
+{
+    return new GPUComputePipeline();
+}
+
+void GPUFreeComputePipeline_Null(GPUComputePipelineID pPipeline)
+{
+    delete (GPUComputePipeline*)pPipeline;
+}
+
+// rootsignature
+GPURootSignatureID GPUCreateRootSignature_Null(GPUDeviceID /*device*/, const struct GPURootSignatureDescriptor* desc)
+{
+    GPURootSignature* RS = (GPURootSignature*)calloc(1, sizeof(GPURootSignature));
+#ifdef GPU_USE_VULKAN
+    CGPUUtil_InitRSParamTables(RS, desc);
+#else
+    RS->bindless_heap      = desc->bindless_heap;
+    RS->bindless_set       = desc->bindless_set;
+    RS->transient_set_mask = desc->transient_set_mask;
+    RS->pipeline_type      = GPU_PIPELINE_TYPE_GRAPHICS;
+    for (uint32_t i = 0; i < desc->shader_count; i++)
+    {
+        if (desc->shaders[i].stage == GPU_SHADER_STAGE_COMPUTE) RS->pipeline_type = GPU_PIPELINE_TYPE_COMPUTE;
+    }
+#endif
+    RS->pool = desc->pool;
+    return RS;
+}
+
+void GPUFreeRootSignature_Null(GPURootSignatureID RS)
+{
+#ifdef GPU_USE_VULKAN
+    GPUUtil_FreeRSParamTables((GPURootSignature*)RS);
+#endif
+    free((void*)RS);
+}
+
+GPURootSignaturePoolID GPUCreateRootSignaturePool_Null(GPUDeviceID /*device*/, const struct GPURootSignaturePoolDescriptor* /*desc*/)
+{
+    // nothing to share, every signature of the pool stands alone
+    return new GPURootSignaturePool();
+}
+
+void GPUFreeRootSignaturePool_Null(GPURootSignaturePoolID pool)
+{
+    delete (GPURootSignaturePool*)pool;
+}
+
+// command
+GPUCommandPoolID GPUCreateCommandPool_Null(GPUQueueID /*queue*/)
+{
+    return new GPUCommandPool();
+}
+
+void GPUFreeCommandPool_Null(GPUCommandPoolID pool)
+{
+    delete (GPUCommandPool*)pool;
+}
+
+void GPUResetCommandPool_Null(GPUCommandPoolID /*pool*/)
+{
+}
+
+GPUCommandBufferID GPUCreateCommandBuffer_Null(GPUCommandPoolID /*pool*/, const GPUCommandBufferDescriptor* /*desc*/)
+{
+    GPUCommandBuffer* CMD = new GPUCommandBuffer();
+    CMD->currentDispatch  = GPU_PIPELINE_TYPE_NONE;
+    return CMD;
+}
+
+void GPUFreeCommandBuffer_Null(GPUCommandBufferID cmd)
+{
+    delete (GPUCommandBuffer*)cmd;
+}
+
+void GPUCmdBegin_Null(GPUCommandBufferID /*cmdBuffer*/)
+{
+}
+
+void GPUCmdEnd_Null(GPUCommandBufferID /*cmdBuffer*/)
+{
+}
+
+void GPUCmdResourceBarrier_Null(GPUCommandBufferID cmd, const struct GPUResourceBarrierDescriptor* desc)
+{
+    if (!NullUtil_Instance(cmd->device)->validateBarriers) return;
+    // acquires repeat the transition of their release, which already moved the state
+    for (uint32_t i = 0; i < desc->buffer_barriers_count; i++)
+    {
+        const GPUBufferBarrier& barrier = desc->buffer_barriers[i];
+        GPUBuffer_Null* B               = (GPUBuffer_Null*)barrier.buffer;
+        if (barrier.queue_acquire) continue;
+        assert((barrier.src_state == GPU_RESOURCE_STATE_UNDEFINED || barrier.src_state == B->state) && "buffer barrier does not start from the current state!");
+        B->state = barrier.dst_state;
+    }
+    for (uint32_t i = 0; i < desc->texture_barriers_count; i++)
+    {
+        const GPUTextureBarrier& barrier = desc->texture_barriers[i];
+        GPUTexture_Null* T               = (GPUTexture_Null*)barrier.texture;
+        if (barrier.queue_acquire) continue;
+        if (barrier.subresource_barrier)
+        {
+            T->stateKnown = false;
+            continue;
+        }
+        assert((!T->stateKnown || barrier.src_state == GPU_RESOURCE_STATE_UNDEFINED || barrier.src_state == T->state) && "texture barrier does not start from the current state!");
+        T->state      = barrier.dst_state;
+        T->stateKnown = true;
+    }
+}
+
+void GPUCmdTransferBufferToTexture_Null(GPUCommandBufferID /*cmd*/, const struct GPUBufferToTextureTransfer* /*desc*/)
+{
+}
+
+void GPUCmdTransferBufferToBuffer_Null(GPUCommandBufferID /*cmd*/, const struct GPUBufferToBufferTransfer* /*desc*/)
+{
+}
+
+void GPUCmdTransferTextureToTexture_Null(GPUCommandBufferID /*cmd*/, const struct GPUTextureToTextureTransfer* /*desc*/)
+{
+}
+
+void GPUCmdTransferBufferToTextureRegions_Null(GPUCommandBufferID /*cmd*/, const struct GPUBufferToTextureRegions* /*desc*/)
+{
+}
+
+void GPUCmdTransferBufferToBufferRegions_Null(GPUCommandBufferID /*cmd*/, const struct GPUBufferToBufferRegions* /*desc*/)
+{
+}
+
+void GPUCmdTransferTextureToTextureRegions_Null(GPUCommandBufferID /*cmd*/, const struct GPUTextureToTextureRegions* /*desc*/)
+{
+}
+
+// fence & semaphore
+GPUFenceID GPUCreateFence_Null(GPUDeviceID /*device*/)
+{
+    GPUFence_Null* F = new GPUFence_Null();
+    F->submitted     = false;
+    return &F->super;
+}
+
+void GPUFreeFence_Null(GPUFenceID fence)
+{
+    delete (GPUFence_Null*)fence;
+}
+
+void GPUWaitFences_Null(const GPUFenceID* fences, uint32_t fenceCount)
+{
+    for (uint32_t i = 0; i < fenceCount; i++)
+    {
+        GPUFence_Null* F = (GPUFence_Null*)fences[i];
+        if (F->submitted) std::this_thread::sleep_until(F->completion);
+        F->submitted = false;
+    }
+}
+
+EGPUFenceStatus GPUQueryFenceStatus_Null(GPUFenceID fence)
+{
+    const GPUFence_Null* F = (const GPUFence_Null*)fence;
+    if (!F->submitted) return GPU_FENCE_STATUS_NOTSUBMITTED;
+    return GPUNullClock::now() >= F->completion ? GPU_FENCE_STATUS_COMPLETE : GPU_FENCE_STATUS_INCOMPLETE;
+}
+
+GPUSemaphoreID GPUCreateSemaphore_Null(GPUDeviceID /*device*/)
+{
+    GPUSemaphore_Null* S = new GPUSemaphore_Null();
+    S->value             = 0;
+    return &S->super;
+}
+
+void GPUFreeSemaphore_Null(GPUSemaphoreID semaphore)
+{
+    delete (GPUSemaphore_Null*)semaphore;
+}
+
+GPUSemaphoreID GPUCreateTimelineSemaphore_Null(GPUDeviceID /*device*/, uint64_t initialValue)
+{
+    GPUSemaphore_Null* S = new GPUSemaphore_Null();
+    S->value             = initialValue;
+    return &S->super;
+}
+
+void GPUSignalSemaphore_Null(GPUSemaphoreID semaphore, uint64_t value)
+{
+    NullUtil_SignalSemaphore(semaphore, value, GPUNullClock::now());
+}
+
+bool GPUWaitSemaphores_Null(const GPUSemaphoreID* semaphores, const uint64_t* values, uint32_t count, uint64_t timeout)
+{
+    const GPUNullClock::time_point deadline = timeout >= (uint64_t)std::chrono::nanoseconds::max().count() ?
+                                              GPUNullClock::time_point::max() :
+                                              GPUNullClock::now() + std::chrono::duration_cast<GPUNullClock::duration>(std::chrono::nanoseconds(timeout));
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!semaphores[i]->timeline) continue;
+        GPUSemaphore_Null* S = (GPUSemaphore_Null*)semaphores[i];
+        std::unique_lock<std::mutex> guard(S->lock);
+        for (;;)
+        {
+            NullUtil_PromoteSignals(S, GPUNullClock::now());
+            if (S->value >= values[i]) break;
+            if (GPUNullClock::now() >= deadline) return false;
+            // sleep until a submission reaching the value completes, a later submit or host signal wakes us earlier
+            GPUNullClock::time_point wake = deadline;
+            for (const auto& signal : S->pending)
+            {
+                if (signal.first >= values[i]) wake = gpu_min(wake, signal.second);
+            }
+            if (wake == GPUNullClock::time_point::max())
+                S->signaled.wait(guard);
+            else
+                S->signaled.wait_until(guard, wake);
+        }
+    }
+    return true;
+}
+
+uint64_t GPUQuerySemaphoreValue_Null(GPUSemaphoreID semaphore)
+{
+    GPUSemaphore_Null* S = (GPUSemaphore_Null*)semaphore;
+    std::lock_guard<std::mutex> guard(S->lock);
+    NullUtil_PromoteSignals(S, GPUNullClock::now());
+    return S->value;
+}
+
+// render pass, the encoders are the command buffer like in vulkan
+GPURenderPassEncoderID GPUCmdBeginRenderPass_Null(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* /*desc*/)
+{
+    return (GPURenderPassEncoderID)cmd;
+}
+
+void GPUCmdEndRenderPass_Null(GPUCommandBufferID /*cmd*/, GPURenderPassEncoderID /*encoder*/)
+{
+}
+
+GPURenderPassEncoderID GPUCmdBeginRenderBundle_Null(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* /*desc*/)
+{
+    return (GPURenderPassEncoderID)cmd;
+}
+
+void GPUCmdEndRenderBundle_Null(GPUCommandBufferID /*cmd*/, GPURenderPassEncoderID /*encoder*/)
+{
+}
+
+void GPURenderEncoderExecuteBundles_Null(GPURenderPassEncoderID /*encoder*/, const GPUCommandBufferID* /*bundles*/, uint32_t /*count*/)
+{
+}
+
+void GPURenderEncoderSetViewport_Null(GPURenderPassEncoderID /*encoder*/, float /*x*/, float /*y*/, float /*width*/, float /*height*/, float /*min_depth*/, float /*max_depth*/)
+{
+}
+
+void GPURenderEncoderSetScissor_Null(GPURenderPassEncoderID /*encoder*/, uint32_t /*x*/, uint32_t /*y*/, uint32_t /*width*/, uint32_t /*height*/)
+{
+}
+
+void GPURenderEncoderBindPipeline_Null(GPURenderPassEncoderID /*encoder*/, GPURenderPipelineID /*pipeline*/)
+{
+}
+
+void GPURenderEncoderSetRasterizerState_Null(GPURenderPassEncoderID /*encoder*/, const GPURasterizerStateDescriptor* /*state*/)
+{
+}
+
+void GPURenderEncoderSetDepthState_Null(GPURenderPassEncoderID /*encoder*/, const GPUDepthStateDesc* /*state*/)
+{
+}
+
+void GPURenderEncoderSetPrimitiveTopology_Null(GPURenderPassEncoderID /*encoder*/, EGPUPrimitiveTopology /*topology*/)
+{
+}
+
+void GPURenderEncoderDraw_Null(GPURenderPassEncoderID /*encoder*/, uint32_t /*vertex_count*/, uint32_t /*first_vertex*/)
+{
+}
+
+void GPURenderEncoderDrawInstanced_Null(GPURenderPassEncoderID /*encoder*/, uint32_t /*vertex_count*/, uint32_t /*instance_count*/, uint32_t /*first_vertex*/, uint32_t /*first_instance*/)
+{
+}
+
+void GPURenderEncoderDrawIndexed_Null(GPURenderPassEncoderID /*encoder*/, uint32_t /*indexCount*/, uint32_t /*firstIndex*/, uint32_t /*vertexOffset*/)
+{
+}
+
+void GPURenderEncoderDrawIndexedInstanced_Null(GPURenderPassEncoderID /*encoder*/, uint32_t /*indexCount*/, uint32_t /*instanceCount*/, uint32_t /*firstIndex*/, int32_t /*vertexOffset*/, uint32_t /*firstInstance*/)
+{
+}
+
+void GPURenderEncoderDrawIndirect_Null(GPURenderPassEncoderID /*encoder*/, GPUBufferID /*buffer*/, uint64_t /*offset*/, uint32_t /*drawCount*/, uint32_t /*stride*/)
+{
+}
+
+void GPURenderEncoderDrawIndexedIndirect_Null(GPURenderPassEncoderID /*encoder*/, GPUBufferID /*buffer*/, uint64_t /*offset*/, uint32_t /*drawCount*/, uint32_t /*stride*/)
+{
+}
+
+void GPURenderEncoderDrawIndirectCount_Null(GPURenderPassEncoderID /*encoder*/, GPUBufferID /*buffer*/, uint64_t /*offset*/, GPUBufferID /*countBuffer*/, uint64_t /*countOffset*/, uint32_t /*maxDrawCount*/, uint32_t /*stride*/)
+{
+}
+
+void GPURenderEncoderDrawIndexedIndirectCount_Null(GPURenderPassEncoderID /*encoder*/, GPUBufferID /*buffer*/, uint64_t /*offset*/, GPUBufferID /*countBuffer*/, uint64_t /*countOffset*/, uint32_t /*maxDrawCount*/, uint32_t /*stride*/)
+{
+}
+
+void GPURenderEncoderBindVertexBuffers_Null(GPURenderPassEncoderID /*encoder*/, uint32_t /*buffer_count*/, const GPUBufferID* /*buffers*/, const uint32_t* /*strides*/, const uint32_t* /*offsets*/)
+{
+}
+
+void GPURenderEncoderBindIndexBuffer_Null(GPURenderPassEncoderID /*encoder*/, GPUBufferID /*buffer*/, uint32_t /*offset*/, uint64_t /*indexStride*/)
+{
+}
+
+void GPURenderEncoderBindDescriptorSet_Null(GPURenderPassEncoderID /*encoder*/, GPUDescriptorSetID /*set*/)
+{
+}
+
+void GPURenderEncoderBindDescriptorSetWithOffsets_Null(GPURenderPassEncoderID /*encoder*/, GPUDescriptorSetID /*set*/, const uint32_t* /*dynamic_offsets*/, uint32_t /*dynamic_offset_count*/)
+{
+}
+
+void GPURenderEncoderPushConstants_Null(GPURenderPassEncoderID /*encoder*/, GPURootSignatureID /*rs*/, const char8_t* /*name*/, const void* /*data*/)
+{
+}
+
+void GPURenderEncoderPushDescriptorSet_Null(GPURenderPassEncoderID /*encoder*/, GPURootSignatureID /*rs*/, uint32_t /*set_index*/, const struct GPUDescriptorData* /*datas*/, uint32_t /*count*/)
+{
+}
+
+GPUComputePassEncoderID GPUCmdBeginComputePass_Null(GPUCommandBufferID cmd, const struct GPUComputePassDescriptor* /*desc*/)
+{
+    return (GPUComputePassEncoderID)cmd;
+}
+
+void GPUCmdEndComputePass_Null(GPUCommandBufferID /*cmd*/, GPUComputePassEncoderID /*encoder*/)
+{
+}
+
+void GPUComputeEncoderBindPipeline_Null(GPUComputePassEncoderID /*encoder*/, GPUComputePipelineID /*pipeline*/)
+{
+}
+
+void GPUComputeEncoderBindDescriptorSet_Null(GPUComputePassEncoderID /*encoder*/, GPUDescriptorSetID /*set*/)
+{
+}
+
+void GPUComputeEncoderBindDescriptorSetWithOffsets_Null(GPUComputePassEncoderID /*encoder*/, GPUDescriptorSetID /*set*/, const uint32_t* /*dynamic_offsets*/, uint32_t /*dynamic_offset_count*/)
+{
+}
+
+void GPUComputeEncoderPushConstants_Null(GPUComputePassEncoderID /*encoder*/, GPURootSignatureID /*rs*/, const char8_t* /*name*/, const void* /*data*/)
+{
+}
+
+void GPUComputeEncoderPushDescriptorSet_Null(GPUComputePassEncoderID /*encoder*/, GPURootSignatureID /*rs*/, uint32_t /*set_index*/, const struct GPUDescriptorData* /*datas*/, uint32_t /*count*/)
+{
+}
+
+void GPUComputeEncoderDispatch_Null(GPUComputePassEncoderID /*encoder*/, uint32_t /*x*/, uint32_t /*y*/, uint32_t /*z*/)
+{
+}
+
+void GPUComputeEncoderDispatchIndirect_Null(GPUComputePassEncoderID /*encoder*/, GPUBufferID /*buffer*/, uint64_t /*offset*/)
+{
+}
+
+// buffer
+GPUBufferID GPUCreateBuffer_Null(GPUDeviceID /*device*/, const GPUBufferDescriptor* desc)
+{
+    GPUBuffer_Null* B           = new GPUBuffer_Null();
+    B->super.size               = desc->size;
+    B->super.descriptors        = desc->descriptors;
+    B->super.memory_usage       = desc->memory_usage;
+    B->super.cpu_mapped_address = nullptr;
+    B->super.gpu_address        = 0;
+    B->state                    = desc->start_state;
+    B->pMemory                  = nullptr;
+    // only host visible buffers get memory, the cpu is the only one touching it
+    const bool hostVisible = desc->memory_usage == GPU_MEM_USAGE_CPU_ONLY || desc->memory_usage == GPU_MEM_USAGE_CPU_TO_GPU ||
+                             desc->memory_usage == GPU_MEM_USAGE_GPU_TO_CPU || (desc->flags & GPU_BCF_HOST_VISIBLE);
+    if (hostVisible)
+    {
+        B->pMemory = calloc(1, desc->size);
+        if (desc->flags & GPU_BCF_PERSISTENT_MAP_BIT) B->super.cpu_mapped_address = B->pMemory;
+    }
+    if (desc->flags & GPU_BCF_DEVICE_ADDRESS_BIT) B->super.gpu_address = (uint64_t)(uintptr_t)B;
+    return &B->super;
+}
+
+void GPUFreeBuffer_Null(GPUBufferID buffer)
+{
+    GPUBuffer_Null* B = (GPUBuffer_Null*)buffer;
+    free(B->pMemory);
+    delete B;
+}
+
+void GPUTransferBufferToBuffer_Null(GPUCommandBufferID /*cmd*/, const struct GPUBufferToBufferTransfer* /*desc*/)
+{
+}
+
+// sampler
+GPUSamplerID GPUCreateSampler_Null(GPUDeviceID /*device*/, const struct GPUSamplerDescriptor* /*desc*/)
+{
+    return new GPUSampler();
+}
+
+void GPUFreeSampler_Null(GPUSamplerID sampler)
+{
+    delete (GPUSampler*)sampler;
+}
+
+GPUDescriptorSetID GPUCreateDescriptorSet_Null(GPUDeviceID /*device*/, const struct GPUDescriptorSetDescriptor* /*desc*/)
+{
+    return new GPUDescriptorSet();
+}
+
+void GPUFreeDescriptorSet_Null(GPUDescriptorSetID set)
+{
+    delete (GPUDescriptorSet*)set;
+}
+
+void GPUUpdateDescriptorSet_Null(GPUDescriptorSetID /*set*/, const struct GPUDescriptorData* /*datas*/, uint32_t /*count*/)
+{
+}
+
+// bindless heap
+GPUBindlessHeapID GPUCreateBindlessHeap_Null(GPUDeviceID /*device*/, const struct GPUBindlessHeapDescriptor* desc)
+{
+    GPUBindlessHeap_Null* H = new GPUBindlessHeap_Null();
+    const uint32_t counts[GPU_BINDLESS_RANGE_COUNT] = { desc->texture_count, desc->rw_texture_count, desc->buffer_count, desc->sampler_count };
+    for (uint32_t i = 0; i < GPU_BINDLESS_RANGE_COUNT; i++)
+    {
+        H->ranges[i].capacity = counts[i] ? counts[i] : UINT32_MAX;
+    }
+    return &H->super;
+}
+
+void GPUFreeBindlessHeap_Null(GPUBindlessHeapID heap)
+{
+    delete (GPUBindlessHeap_Null*)heap;
+}
+
+static uint32_t NullUtil_BindlessAdd(GPUBindlessHeapID heap, EGPUBindlessRange range, const void* resource)
+{
+    GPUBindlessHeap_Null* H = (GPUBindlessHeap_Null*)heap;
+    std::lock_guard<std::mutex> guard(H->lock);
+    GPUBindlessHeap_Null::Range& R = H->ranges[range];
+    auto found = R.indices.find(resource);
+    if (found != R.indices.end())
+    {
+        R.refs[found->second]++;
+        return found->second;
+    }
+    uint32_t index;
+    if (!R.freeList.empty())
+    {
+        index = R.freeList.back();
+        R.freeList.pop_back();
+    }
+    else
+    {
+        assert(R.owners.size() < R.capacity && "bindless range is full!");
+        index = (uint32_t)R.owners.size();
+        R.owners.push_back(nullptr);
+        R.refs.push_back(0);
+    }
+    R.owners[index]     = resource;
+    R.refs[index]       = 1;
+    R.indices[resource] = index;
+    return index;
+}
+
+uint32_t GPUBindlessHeapAddTexture_Null(GPUBindlessHeapID heap, GPUTextureViewID view, bool writable)
+{
+    return NullUtil_BindlessAdd(heap, writable ? GPU_BINDLESS_RANGE_RW_TEXTURE : GPU_BINDLESS_RANGE_TEXTURE, view);
+}
+
+uint32_t GPUBindlessHeapAddBuffer_Null(GPUBindlessHeapID heap, GPUBufferID buffer)
+{
+    return NullUtil_BindlessAdd(heap, GPU_BINDLESS_RANGE_BUFFER, buffer);
+}
+
+uint32_t GPUBindlessHeapAddSampler_Null(GPUBindlessHeapID heap, GPUSamplerID sampler)
+{
+    return NullUtil_BindlessAdd(heap, GPU_BINDLESS_RANGE_SAMPLER, sampler);
+}
+
+void GPUBindlessHeapRemove_Null(GPUBindlessHeapID heap, EGPUBindlessRange range, uint32_t index)
+{
+    GPUBindlessHeap_Null* H = (GPUBindlessHeap_Null*)heap;
+    std::lock_guard<std::mutex> guard(H->lock);
+    GPUBindlessHeap_Null::Range& R = H->ranges[range];
+    assert(index < R.refs.size() && R.refs[index] > 0 && "removing a free bindless index!");
+    if (--R.refs[index] == 0)
+    {
+        R.indices.erase(R.owners[index]);
+        R.owners[index] = nullptr;
+        R.freeList.push_back(index);
+    }
+}
@@ -0,0 +1,109 @@
+#include "backend/null/GPUNull.h"
+
+const GPUProcTable nullTable = {
+    .CreateInstance                             = &GPUCreateInstance_Null,
+    .FreeInstance                               = &GPUFreeInstance_Null,
+    .EnumerateAdapters                          = &GPUEnumerateAdapters_Null,
+    .CreateDevice                               = &GPUCreateDevice_Null,
+    .FreeDevice                                 = &GPUFreeDevice_Null,
+    .GetQueue                                   = &GPUGetQueue_Null,
+    .FreeQueue                                  = &GPUFreeQueue_Null,
+    .SubmitQueue                                = &GPUSubmitQueue_Null,
+    .SubmitQueueBatches                         = &GPUSubmitQueueBatches_Null,
+    .FlushQueueTransitions                      = &GPUFlushQueueTransitions_Null,
+    .WaitQueueIdle                              = &GPUWaitQueueIdle_Null,
+    .QueuePresent                               = &GPUQueuePresent_Null,
+    .CreateSwapchain                            = &GPUCreateSwapchain_Null,
+    .FreeSwapchain                              = &GPUFreeSwapchain_Null,
+    .AcquireNextImage                           = &GPUAcquireNextImage_Null,
+    .CreateTextureView                          = &GPUCreateTextureView_Null,
+    .FreeTextureView                            = &GPUFreeTextureView_Null,
+    .CreateTexture                              = &GPUCreateTexture_Null,
+    .FreeTexture                                = &GPUFreeTexture_Null,
+    .CreateShaderLibrary                        = &GPUCreateShaderLibrary_Null,
+    .FreeShaderLibrary                          = &GPUFreeShaderLibrary_Null,
+    .CreateRenderPipeline                       = &GPUCreateRenderPipeline_Null,
+    .FreeRenderPipeline                         = &GPUFreeRenderPipeline_Null,
+    .CreateComputePipeline                      = &GPUCreateComputePipeline_Null,
+    .FreeComputePipeline                        = &GPUFreeComputePipeline_Null,
+    .CreateRootSignature                        = &GPUCreateRootSignature_Null,
+    .FreeRootSignature                          = &GPUFreeRootSignature_Null,
+    .CreateRootSignaturePool                    = &GPUCreateRootSignaturePool_Null,
+    .FreeRootSignaturePool                      = &GPUFreeRootSignaturePool_Null,
+    .CreateCommandPool                          = &GPUCreateCommandPool_Null,
+    .FreeCommandPool                            = &GPUFreeCommandPool_Null,
+    .ResetCommandPool                           = &GPUResetCommandPool_Null,
+    .CreateCommandBuffer                        = &GPUCreateCommandBuffer_Null,
+    .FreeCommandBuffer                          = &GPUFreeCommandBuffer_Null,
+    .CmdBegin                                   = &GPUCmdBegin_Null,
+    .CmdEnd                                     = &GPUCmdEnd_Null,
+    .CmdResourceBarrier                         = &GPUCmdResourceBarrier_Null,
+    .CmdTransferBufferToTexture                 = &GPUCmdTransferBufferToTexture_Null,
+    .CmdTransferBufferToBuffer                  = &GPUCmdTransferBufferToBuffer_Null,
+    .CmdTransferTextureToTexture                = &GPUCmdTransferTextureToTexture_Null,
+    .CmdTransferBufferToTextureRegions          = &GPUCmdTransferBufferToTextureRegions_Null,
+    .CmdTransferBufferToBufferRegions           = &GPUCmdTransferBufferToBufferRegions_Null,
+    .CmdTransferTextureToTextureRegions         = &GPUCmdTransferTextureToTextureRegions_Null,
+    .CreateFence                                = &GPUCreateFence_Null,
+    .FreeFence                                  = &GPUFreeFence_Null,
+    .WaitFences                                 = &GPUWaitFences_Null,
+    .QueryFenceStatus                           = &GPUQueryFenceStatus_Null,
+    .GpuCreateSemaphore                         = &GPUCreateSemaphore_Null,
+    .GpuFreeSemaphore                           = &GPUFreeSemaphore_Null,
+    .CreateTimelineSemaphore                    = &GPUCreateTimelineSemaphore_Null,
+    .SignalSemaphore                            = &GPUSignalSemaphore_Null,
+    .WaitSemaphores                             = &GPUWaitSemaphores_Null,
+    .QuerySemaphoreValue                        = &GPUQuerySemaphoreValue_Null,
+    .CmdBeginRenderPass                         = &GPUCmdBeginRenderPass_Null,
+    .CmdEndRenderPass                           = &GPUCmdEndRenderPass_Null,
+    .CmdBeginRenderBundle                       = &GPUCmdBeginRenderBundle_Null,
+    .CmdEndRenderBundle                         = &GPUCmdEndRenderBundle_Null,
+    .RenderEncoderExecuteBundles                = &GPURenderEncoderExecuteBundles_Null,
+    .RenderEncoderSetViewport                   = &GPURenderEncoderSetViewport_Null,
+    .RenderEncoderSetScissor                    = &GPURenderEncoderSetScissor_Null,
+    .RenderEncoderBindPipeline                  = &GPURenderEncoderBindPipeline_Null,
+    .RenderEncoderSetRasterizerState            = &GPURenderEncoderSetRasterizerState_Null,
+    .RenderEncoderSetDepthState                 = &GPURenderEncoderSetDepthState_Null,
+    .RenderEncoderSetPrimitiveTopology          = &GPURenderEncoderSetPrimitiveTopology_Null,
+    .RenderEncoderDraw                          = &GPURenderEncoderDraw_Null,
+    .RenderEncoderDrawInstanced                 = &GPURenderEncoderDrawInstanced_Null,
+    .RenderEncoderDrawIndexed                   = &GPURenderEncoderDrawIndexed_Null,
+    .RenderEncoderDrawIndexedInstanced          = &GPURenderEncoderDrawIndexedInstanced_Null,
+    .RenderEncoderDrawIndirect                  = &GPURenderEncoderDrawIndirect_Null,
+    .RenderEncoderDrawIndexedIndirect           = &GPURenderEncoderDrawIndexedIndirect_Null,
+    .RenderEncoderDrawIndirectCount             = &GPURenderEncoderDrawIndirectCount_Null,
+    .RenderEncoderDrawIndexedIndirectCount      = &GPURenderEncoderDrawIndexedIndirectCount_Null,
+    .RenderEncoderBindVertexBuffers             = &GPURenderEncoderBindVertexBuffers_Null,
+    .RenderEncoderBindIndexBuffer               = &GPURenderEncoderBindIndexBuffer_Null,
+    .RenderEncoderBindDescriptorSet             = &GPURenderEncoderBindDescriptorSet_Null,
+    .RenderEncoderBindDescriptorSetWithOffsets  = &GPURenderEncoderBindDescriptorSetWithOffsets_Null,
+    .RenderEncoderPushConstants                 = &GPURenderEncoderPushConstants_Null,
+    .RenderEncoderPushDescriptorSet             = &GPURenderEncoderPushDescriptorSet_Null,
+    .CmdBeginComputePass                        = &GPUCmdBeginComputePass_Null,
+    .CmdEndComputePass                          = &GPUCmdEndComputePass_Null,
+    .ComputeEncoderBindPipeline                 = &GPUComputeEncoderBindPipeline_Null,
+    .ComputeEncoderBindDescriptorSet            = &GPUComputeEncoderBindDescriptorSet_Null,
+    .ComputeEncoderBindDescriptorSetWithOffsets = &GPUComputeEncoderBindDescriptorSetWithOffsets_Null,
+    .ComputeEncoderPushConstants                = &GPUComputeEncoderPushConstants_Null,
+    .ComputeEncoderPushDescriptorSet            = &GPUComputeEncoderPushDescriptorSet_Null,
+    .ComputeEncoderDispatch                     = &GPUComputeEncoderDispatch_Null,
+    .ComputeEncoderDispatchIndirect             = &GPUComputeEncoderDispatchIndirect_Null,
+    .CreateBuffer                               = &GPUCreateBuffer_Null,
+    .FreeBuffer                                 = &GPUFreeBuffer_Null,
+    .TransferBufferToBuffer                     = &GPUTransferBufferToBuffer_Null,
+    .CreateSampler                              = &GPUCreateSampler_Null,
+    .FreeSampler                                = &GPUFreeSampler_Null,
+    .CreateDescriptorSet                        = &GPUCreateDescriptorSet_Null,
+    .FreeDescriptorSet                          = &GPUFreeDescriptorSet_Null,
+    .UpdateDescriptorSet                        = &GPUUpdateDescriptorSet_Null,
+    .CreateBindlessHeap                         = &GPUCreateBindlessHeap_Null,
+    .FreeBindlessHeap                           = &GPUFreeBindlessHeap_Null,
+    .BindlessHeapAddTexture                     = &GPUBindlessHeapAddTexture_Null,
+    .BindlessHeapAddBuffer                      = &GPUBindlessHeapAddBuffer_Null,
+    .BindlessHeapAddSampler                     = &GPUBindlessHeapAddSampler_Null,
+    .BindlessHeapRemove                         = &GPUBindlessHeapRemove_Null,
+};
+const GPUProcTable* GPUNullProcTable()
+{
+    return &nullTable;
+}
\ No newline at end of file
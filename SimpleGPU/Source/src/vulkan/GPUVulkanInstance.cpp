@@ -5,10 +5,14 @@
 #include <vector>
 #include <algorithm>
 #include <unordered_map>
+#include <mutex>
+#include <string>
 #include "extensions/GPUVulkanEXTs.h"
 #include "backend/vulkan/GPUVulkanUtils.h"
 #include "backend/vulkan/vma/vk_mem_alloc.h"
 #include "Utils.h"
+#include "hash.h"
+#include "shader-reflections/spirv/spirv_reflect.h"
 
 class VulkanBlackboard
 {
@@ -152,6 +156,224 @@ struct GPUVkPassTable
     std::unordered_map<VulkanFramebufferDesriptor, GPUCachedFrameBuffer, VulkanFramebufferDesriptorHasher> cached_framebuffers;
 };
 
+// initial state transitions waiting for the next submission of their owner queue
+struct GPUVkTransitionTable
+{
+    std::mutex lock;
+    std::vector<std::pair<GPUQueueID, GPUTextureBarrier>> textures;
+    std::vector<std::pair<GPUQueueID, GPUBufferBarrier>> buffers;
+};
+
+// byte-identical spir-v shares one shader module and its reflection
+struct GPUVkCachedShader
+{
+    GPUShaderLibrary_Vulkan library;
+    uint32_t* code; // kept for the comparison when the reflection came from a blob
+    uint32_t codeSize;
+    uint64_t hash;
+    uint32_t refs;
+};
+
+struct GPUVkShaderCache
+{
+    std::mutex lock;
+    std::unordered_multimap<uint64_t, GPUVkCachedShader*> shaders;
+};
+
+// root signatures of a pool with equal layouts share the vulkan objects of one pool signature
+struct GPUVkPooledSignature
+{
+    std::vector<uint64_t> key;
+    GPURootSignature_Vulkan* pSignature; // owned by the pool, freed with its last user
+    uint32_t refs;
+};
+
+typedef struct GPURootSignaturePool_Vulkan
+{
+    GPURootSignaturePool super;
+    std::mutex lock;
+    std::unordered_multimap<uint64_t, GPUVkPooledSignature> signatures;
+} GPURootSignaturePool_Vulkan;
+
+// graphics pipeline library parts, keyed by the bytes of the state they are built from
+struct GPUVkPipelineLibraryCache
+{
+    std::mutex lock;
+    std::unordered_map<std::string, VkPipeline> libraries;
+};
+
+#define GPU_VK_DESCRIPTOR_HEAP_SIZE (16ull * 1024 * 1024)
+
+// descriptor buffer mode, every descriptor set is a sub-range of one persistently mapped buffer,
+// sets with sampler descriptors are kept in the front part a sampler binding can address
+struct GPUVkDescriptorHeap
+{
+    std::mutex lock;
+    VkBuffer pBuffer;
+    VmaAllocation pAllocation;
+    VmaVirtualBlock pSamplerBlock;
+    VmaVirtualBlock pResourceBlock; // null when the sampler range covers the whole heap
+    VkDeviceSize samplerRange;
+    uint8_t* pMapped;
+    VkDeviceAddress address;
+    VkDeviceSize alignment;
+};
+
+static GPUVkPipelineLibraryCache* VulkanUtil_CreatePipelineLibraryCache()
+{
+    void* ptr = calloc(1, sizeof(GPUVkPipelineLibraryCache));
+    return new (ptr) GPUVkPipelineLibraryCache();
+}
+
+static void VulkanUtil_FreePipelineLibraryCache(const GPUDevice_Vulkan* D, GPUVkPipelineLibraryCache* cache)
+{
+    for (auto& iter : cache->libraries)
+    {
+        D->mVkDeviceTable.vkDestroyPipeline(D->pDevice, iter.second, GLOBAL_VkAllocationCallbacks);
+    }
+    cache->~GPUVkPipelineLibraryCache();
+    free(cache);
+}
+
+static GPUVkDescriptorHeap* VulkanUtil_CreateDescriptorHeap(GPUDevice_Vulkan* D)
+{
+    const GPUAdapter_Vulkan* A                                 = (GPUAdapter_Vulkan*)D->spuer.pAdapter;
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT& props = A->descriptorBufferProperties;
+    void* ptr                                                  = calloc(1, sizeof(GPUVkDescriptorHeap));
+    GPUVkDescriptorHeap* heap                                  = new (ptr) GPUVkDescriptorHeap();
+    VkDeviceSize size                                          = GPU_VK_DESCRIPTOR_HEAP_SIZE;
+    if (size > props.maxResourceDescriptorBufferRange) size = props.maxResourceDescriptorBufferRange;
+    heap->alignment    = props.descriptorBufferOffsetAlignment;
+    heap->samplerRange = size > props.maxSamplerDescriptorBufferRange ? props.maxSamplerDescriptorBufferRange : size;
+    heap->samplerRange -= heap->samplerRange % heap->alignment;
+
+    VkBufferCreateInfo info{};
+    info.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size        = size;
+    info.usage       = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+                       VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+                       VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VmaAllocationCreateInfo vma{};
+    vma.usage         = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    vma.flags         = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    vma.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    VmaAllocationInfo alloc_info{};
+    assert(vmaCreateBuffer(D->pVmaAllocator, &info, &vma, &heap->pBuffer, &heap->pAllocation, &alloc_info) == VK_SUCCESS);
+    heap->pMapped = (uint8_t*)alloc_info.pMappedData;
+
+    VkBufferDeviceAddressInfo address_info{};
+    address_info.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    address_info.buffer = heap->pBuffer;
+    heap->address       = D->mVkDeviceTable.vkGetBufferDeviceAddress(D->pDevice, &address_info);
+
+    VmaVirtualBlockCreateInfo block_info{};
+    block_info.size = heap->samplerRange;
+    assert(vmaCreateVirtualBlock(&block_info, &heap->pSamplerBlock) == VK_SUCCESS);
+    if (size > heap->samplerRange)
+    {
+        block_info.size = size - heap->samplerRange;
+        assert(vmaCreateVirtualBlock(&block_info, &heap->pResourceBlock) == VK_SUCCESS);
+    }
+    return heap;
+}
+
+static void VulkanUtil_FreeDescriptorHeap(GPUDevice_Vulkan* D)
+{
+    GPUVkDescriptorHeap* heap = D->pDescriptorHeap;
+    vmaClearVirtualBlock(heap->pSamplerBlock);
+    vmaDestroyVirtualBlock(heap->pSamplerBlock);
+    if (heap->pResourceBlock)
+    {
+        vmaClearVirtualBlock(heap->pResourceBlock);
+        vmaDestroyVirtualBlock(heap->pResourceBlock);
+    }
+    vmaDestroyBuffer(D->pVmaAllocator, heap->pBuffer, heap->pAllocation);
+    heap->~GPUVkDescriptorHeap();
+    GPU_SAFE_FREE(D->pDescriptorHeap);
+}
+
+// zeroed range for a set, returns its offset in the heap
+static VkDeviceSize VulkanUtil_AllocateDescriptors(const GPUDevice_Vulkan* D, VkDeviceSize size, bool samplers, VmaVirtualAllocation* pAllocation)
+{
+    GPUVkDescriptorHeap* heap   = D->pDescriptorHeap;
+    const bool front            = samplers || !heap->pResourceBlock;
+    const VmaVirtualBlock block = front ? heap->pSamplerBlock : heap->pResourceBlock;
+    VmaVirtualAllocationCreateInfo info{};
+    info.size           = size ? size : 1;
+    info.alignment      = heap->alignment;
+    VkDeviceSize offset = 0;
+    VkResult result     = VK_SUCCESS;
+    {
+        std::lock_guard<std::mutex> guard(heap->lock);
+        result = vmaVirtualAllocate(block, &info, pAllocation, &offset);
+    }
+    assert(result == VK_SUCCESS && "descriptor heap is full!");
+    if (!front) offset += heap->samplerRange;
+    memset(heap->pMapped + offset, 0, size);
+    return offset;
+}
+
+static void VulkanUtil_FreeDescriptors(const GPUDevice_Vulkan* D, VmaVirtualAllocation allocation, VkDeviceSize offset)
+{
+    GPUVkDescriptorHeap* heap = D->pDescriptorHeap;
+    std::lock_guard<std::mutex> guard(heap->lock);
+    vmaVirtualFree(offset < heap->samplerRange ? heap->pSamplerBlock : heap->pResourceBlock, allocation);
+}
+
+// writes one descriptor of the given type at dst, buffers are described by address instead of handle
+static void VulkanUtil_WriteDescriptor(const GPUDevice_Vulkan* D, uint8_t* dst, VkDescriptorType type, const VkDescriptorImageInfo* image, const VkDescriptorAddressInfoEXT* address)
+{
+    const GPUAdapter_Vulkan* A                                 = (GPUAdapter_Vulkan*)D->spuer.pAdapter;
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT& props = A->descriptorBufferProperties;
+    VkDescriptorGetInfoEXT info{};
+    info.sType  = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+    info.type   = type;
+    size_t size = 0;
+    switch (type)
+    {
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+            info.data.pSampler = &image->sampler;
+            size               = props.samplerDescriptorSize;
+            break;
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            info.data.pSampledImage = image;
+            size                    = props.sampledImageDescriptorSize;
+            break;
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            info.data.pStorageImage = image;
+            size                    = props.storageImageDescriptorSize;
+            break;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            info.data.pUniformBuffer = address;
+            size                     = props.uniformBufferDescriptorSize;
+            break;
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            info.data.pStorageBuffer = address;
+            size                     = props.storageBufferDescriptorSize;
+            break;
+        default:
+            assert(0 && "Descriptor Type not supported in descriptor buffer mode!");
+            return;
+    }
+    D->mVkDeviceTable.vkGetDescriptorEXT(D->pDevice, &info, size, dst);
+}
+
+static size_t VulkanUtil_DescriptorStride(const GPUDevice_Vulkan* D, VkDescriptorType type)
+{
+    const GPUAdapter_Vulkan* A                                 = (GPUAdapter_Vulkan*)D->spuer.pAdapter;
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT& props = A->descriptorBufferProperties;
+    switch (type)
+    {
+        case VK_DESCRIPTOR_TYPE_SAMPLER: return props.samplerDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE: return props.sampledImageDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE: return props.storageImageDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER: return props.uniformBufferDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER: return props.storageBufferDescriptorSize;
+        default: return 0;
+    }
+}
+
 GPUInstanceID CreateInstance_Vulkan(const GPUInstanceDescriptor* pDesc)
 {
     VulkanBlackboard blackBoard(pDesc);
@@ -353,9 +575,78 @@ GPUDeviceID CreateDevice_Vulkan(GPUAdapterID pAdapter, const GPUDeviceDescriptor
         assert(QueryQueueCount_Vulkan(pAdapter, descriptor.queueType) >= descriptor.queueCount);
     }
 
+    // descriptor buffer mode, only turned on for devices that ask for it
+    const bool descriptorBuffer = pDesc->enableDescriptorBuffer && pVkAdapter->adapterDetail.support_descriptor_buffer;
+    // descriptor buffers address everything they point at
+    pDevice->bufferDeviceAddress     = descriptorBuffer || pDesc->enableBufferDeviceAddress;
+    assert(!pDesc->enableBufferDeviceAddress || pVkAdapter->adapterDetail.support_buffer_device_address);
+    pDevice->graphicsPipelineLibrary = pDesc->enableGraphicsPipelineLibrary && pVkAdapter->adapterDetail.support_graphics_pipeline_library;
+    pDevice->bindless                = pDesc->enableBindless;
+    assert(!pDevice->bindless || pVkAdapter->adapterDetail.support_bindless);
+
+    // the adapter's feature structs report everything it supports, the device only enables the features
+    // the backend uses when present and the ones the descriptor asked for
+    const VkPhysicalDeviceVulkan12Features& supported12 = pVkAdapter->physicalDeviceFeatures12;
+    VkPhysicalDeviceVulkan13Features features13{};
+    features13.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    features13.synchronization2 = pVkAdapter->adapterDetail.support_synchronization2;
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType               = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    features12.pNext               = pVkAdapter->physicalDeviceFeatures13.sType ? &features13 : VK_NULL_HANDLE;
+    features12.timelineSemaphore   = VK_TRUE;
+    features12.drawIndirectCount   = supported12.drawIndirectCount;
+    features12.bufferDeviceAddress = pDevice->bufferDeviceAddress;
+    if (pDevice->bindless)
+    {
+        features12.descriptorIndexing                            = VK_TRUE;
+        features12.runtimeDescriptorArray                        = VK_TRUE;
+        features12.descriptorBindingPartiallyBound               = VK_TRUE;
+        features12.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
+        features12.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+        features12.descriptorBindingStorageImageUpdateAfterBind  = VK_TRUE;
+        features12.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        features12.shaderSampledImageArrayNonUniformIndexing     = VK_TRUE;
+    }
+    // core features are not opt-in
+    VkPhysicalDeviceFeatures2 features{};
+    features.sType    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext    = supported12.sType ? &features12 : VK_NULL_HANDLE;
+    features.features = pVkAdapter->physicalDeviceFeatures.features;
+    void* pFeatures   = &features;
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipelineLibraryFeatures{};
+    pipelineLibraryFeatures.sType                   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+    pipelineLibraryFeatures.pNext                   = pFeatures;
+    pipelineLibraryFeatures.graphicsPipelineLibrary = VK_TRUE;
+    if (pDevice->graphicsPipelineLibrary) pFeatures = &pipelineLibraryFeatures;
+    const GPUAdapterDetail& detail  = pVkAdapter->adapterDetail;
+    pDevice->extendedDynamicState   = pDesc->enableExtendedDynamicState && detail.support_extended_dynamic_state;
+    pDevice->extendedDynamicState2  = pDevice->extendedDynamicState && detail.support_extended_dynamic_state2;
+    pDevice->extendedDynamicState3  = pDevice->extendedDynamicState && detail.support_extended_dynamic_state3;
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT dynamicStateFeatures{};
+    dynamicStateFeatures.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+    dynamicStateFeatures.pNext                = pFeatures;
+    dynamicStateFeatures.extendedDynamicState = VK_TRUE;
+    if (pDevice->extendedDynamicState) pFeatures = &dynamicStateFeatures;
+    VkPhysicalDeviceExtendedDynamicState2FeaturesEXT dynamicState2Features{};
+    dynamicState2Features.sType                 = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+    dynamicState2Features.pNext                 = pFeatures;
+    dynamicState2Features.extendedDynamicState2 = VK_TRUE;
+    if (pDevice->extendedDynamicState2) pFeatures = &dynamicState2Features;
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT dynamicState3Features{};
+    dynamicState3Features.sType                                 = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+    dynamicState3Features.pNext                                 = pFeatures;
+    dynamicState3Features.extendedDynamicState3PolygonMode      = VK_TRUE;
+    dynamicState3Features.extendedDynamicState3DepthClampEnable = VK_TRUE;
+    if (pDevice->extendedDynamicState3) pFeatures = &dynamicState3Features;
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures{};
+    descriptorBufferFeatures.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+    descriptorBufferFeatures.pNext            = pFeatures;
+    descriptorBufferFeatures.descriptorBuffer = VK_TRUE;
+    if (descriptorBuffer) pFeatures = &descriptorBufferFeatures;
+
     VkDeviceCreateInfo createInfo{};
     createInfo.sType                = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    createInfo.pNext                = &pVkAdapter->physicalDeviceFeatures;
+    createInfo.pNext                = pFeatures;
     createInfo.queueCreateInfoCount = pDesc->queueGroupCount;
     createInfo.pQueueCreateInfos    = queueCreateInfos.data();
     createInfo.pEnabledFeatures     = VK_NULL_HANDLE;
@@ -392,6 +683,17 @@ GPUDeviceID CreateDevice_Vulkan(GPUAdapterID pAdapter, const GPUDeviceDescriptor
     void* ptr           = calloc(1, sizeof(GPUVkPassTable));
     pDevice->pPassTable = new (ptr) GPUVkPassTable();
 
+    //deferred initial transitions
+    ptr                       = calloc(1, sizeof(GPUVkTransitionTable));
+    pDevice->pTransitionTable = new (ptr) GPUVkTransitionTable();
+
+    //shader cache
+    ptr                   = calloc(1, sizeof(GPUVkShaderCache));
+    pDevice->pShaderCache = new (ptr) GPUVkShaderCache();
+
+    //pipeline libraries
+    pDevice->pPipelineLibraries = pDevice->graphicsPipelineLibrary ? VulkanUtil_CreatePipelineLibraryCache() : nullptr;
+
     //vma
     VmaVulkanFunctions vulkanFunctions = {
         .vkGetPhysicalDeviceProperties       = vkGetPhysicalDeviceProperties,
@@ -420,11 +722,15 @@ GPUDeviceID CreateDevice_Vulkan(GPUAdapterID pAdapter, const GPUDeviceDescriptor
     vma.physicalDevice       = pVkAdapter->pPhysicalDevice;
     vma.pVulkanFunctions     = &vulkanFunctions;
     vma.pAllocationCallbacks = GLOBAL_VkAllocationCallbacks;
+    vma.flags                = pDevice->bufferDeviceAddress ? VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT : 0;
     if (vmaCreateAllocator(&vma, &pDevice->pVmaAllocator) != VK_SUCCESS)
     {
         assert(0);
     }
 
+    //descriptor heap
+    pDevice->pDescriptorHeap = descriptorBuffer ? VulkanUtil_CreateDescriptorHeap(pDevice) : nullptr;
+
     return &(pDevice->spuer);
 }
 
@@ -442,9 +748,16 @@ void FreeDevice_Vulkan(GPUDeviceID pDevice)
         pVkDevice->mVkDeviceTable.vkDestroyFramebuffer(pVkDevice->pDevice, iter.second.pBuffer, GLOBAL_VkAllocationCallbacks);
     }
 
+    if (pVkDevice->pPipelineLibraries) VulkanUtil_FreePipelineLibraryCache(pVkDevice, pVkDevice->pPipelineLibraries);
     pVkDevice->mVkDeviceTable.vkDestroyDescriptorPool(pVkDevice->pDevice, pVkDevice->pDescriptorPool->pVkDescPool, GLOBAL_VkAllocationCallbacks);
+    if (pVkDevice->pDescriptorHeap) VulkanUtil_FreeDescriptorHeap(pVkDevice);
     vkDestroyDevice(pVkDevice->pDevice, GLOBAL_VkAllocationCallbacks);
     GPU_SAFE_FREE(pVkDevice->pPassTable);
+    pVkDevice->pTransitionTable->~GPUVkTransitionTable();
+    GPU_SAFE_FREE(pVkDevice->pTransitionTable);
+    assert(pVkDevice->pShaderCache->shaders.empty() && "shader libraries are still alive!");
+    pVkDevice->pShaderCache->~GPUVkShaderCache();
+    GPU_SAFE_FREE(pVkDevice->pShaderCache);
     GPU_SAFE_FREE(pVkDevice->pDescriptorPool);
     GPU_SAFE_FREE(pVkDevice);
 }
@@ -561,79 +874,252 @@ GPUQueueID GetQueue_Vulkan(GPUDeviceID pDevice, EGPUQueueType queueType, uint32_
     tmpQueue.queueFamilyIndex = (uint32_t)pVkAdapter->queueFamilyIndices[queueType];
     memcpy(pVkQueue, &tmpQueue, sizeof(GPUQueue_Vulkan));
     
-    pVkQueue->pInnerCmdPool = GPUCreateCommandPool(&pVkQueue->super);
     GPUCommandBufferDescriptor desc{};
-    desc.isSecondary          = false;
-    pVkQueue->pInnerCmdBuffer = GPUCreateCommandBuffer(pVkQueue->pInnerCmdPool, &desc);
-    pVkQueue->pInnerFence     = GPUCreateFence(pDevice);
+    desc.isSecondary = false;
+    for (uint32_t i = 0; i < GPU_VK_INNER_CMD_COUNT; i++)
+    {
+        pVkQueue->pInnerCmdPools[i]   = GPUCreateCommandPool(&pVkQueue->super);
+        pVkQueue->pInnerCmdBuffers[i] = GPUCreateCommandBuffer(pVkQueue->pInnerCmdPools[i], &desc);
+    }
+
+    // submission counter
+    assert(pVkAdapter->adapterDetail.support_timeline_semaphore && "timeline semaphore is required!");
+    pVkQueue->super.timeline = GPUCreateTimelineSemaphore(pDevice, 0);
 
     return &pVkQueue->super;
 }
 
+template <typename Barrier>
+static void VulkanUtil_TakeQueuedTransitions(std::vector<std::pair<GPUQueueID, Barrier>>& pending, GPUQueueID queue, std::vector<Barrier>& out)
+{
+    size_t keep = 0;
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        if (pending[i].first == queue)
+            out.push_back(pending[i].second);
+        else
+            pending[keep++] = pending[i];
+    }
+    pending.resize(keep);
+}
+
+static void VulkanUtil_TakeQueuedTransitions(GPUVkTransitionTable* table, GPUQueueID queue, std::vector<GPUTextureBarrier>& textures, std::vector<GPUBufferBarrier>& buffers)
+{
+    std::lock_guard<std::mutex> guard(table->lock);
+    VulkanUtil_TakeQueuedTransitions(table->textures, queue, textures);
+    VulkanUtil_TakeQueuedTransitions(table->buffers, queue, buffers);
+}
+
+// records taken initial transitions into one inner cmd retired by submission, nullptr if there are none
+static GPUCommandBufferID VulkanUtil_RecordQueuedTransitions(GPUQueueID queue, uint64_t submission, const std::vector<GPUTextureBarrier>& textures, const std::vector<GPUBufferBarrier>& buffers)
+{
+    GPUQueue_Vulkan* Q = (GPUQueue_Vulkan*)queue;
+    if (textures.empty() && buffers.empty()) return nullptr;
+
+    // inner cmds are recycled by submission, the oldest one has normally retired long ago
+    const uint32_t slot    = Q->innerCmdIndex++ % GPU_VK_INNER_CMD_COUNT;
+    GPUCommandBufferID cmd = Q->pInnerCmdBuffers[slot];
+    GPUWaitQueueSubmission(queue, Q->innerCmdSubmissions[slot], UINT64_MAX);
+    Q->innerCmdSubmissions[slot] = submission;
+
+    GPUResetCommandPool(Q->pInnerCmdPools[slot]);
+    GPUCmdBegin(cmd);
+    GPUResourceBarrierDescriptor barrier_desc{};
+    barrier_desc.texture_barriers       = textures.data();
+    barrier_desc.texture_barriers_count = (uint32_t)textures.size();
+    barrier_desc.buffer_barriers        = buffers.data();
+    barrier_desc.buffer_barriers_count  = (uint32_t)buffers.size();
+    GPUCmdResourceBarrier(cmd, &barrier_desc);
+    GPUCmdEnd(cmd);
+    return cmd;
+}
+
 void GPUFreeQueue_Vulkan(GPUQueueID queue)
 {
     GPUQueue_Vulkan* Q = (GPUQueue_Vulkan*)queue;
-    if (Q && Q->pInnerCmdBuffer) GPUFreeCommandBuffer(Q->pInnerCmdBuffer);
-    if (Q && Q->pInnerCmdPool) GPUFreeCommandPool(Q->pInnerCmdPool);
-    if (Q && Q->pInnerFence) GPUFreeFence(Q->pInnerFence);
+    if (Q)
+    {
+        // transitions that never got submitted are dropped with the queue
+        GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)queue->pDevice;
+        std::vector<GPUTextureBarrier> textures;
+        std::vector<GPUBufferBarrier> buffers;
+        VulkanUtil_TakeQueuedTransitions(D->pTransitionTable, queue, textures, buffers);
+    }
+    for (uint32_t i = 0; Q && i < GPU_VK_INNER_CMD_COUNT; i++)
+    {
+        if (Q->pInnerCmdBuffers[i]) GPUFreeCommandBuffer(Q->pInnerCmdBuffers[i]);
+        if (Q->pInnerCmdPools[i]) GPUFreeCommandPool(Q->pInnerCmdPools[i]);
+    }
+    if (Q && Q->super.timeline) GPUFreeSemaphore(Q->super.timeline);
     free(Q);
 }
 
-void GPUSubmitQueue_Vulkan(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* desc)
+// binary semaphores keep the signaled flag so unpaired waits/signals are dropped,
+// timeline semaphores are always forwarded with their value. The queue timeline is signaled with submission
+static void VulkanUtil_SubmitBatches(GPUQueueID queue, const GPUQueueSubmitBatch* batches, uint32_t batchCount, GPUFenceID fence, uint64_t submission)
 {
-    GPUQueue_Vulkan* Q  = (GPUQueue_Vulkan*)queue;
-    GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)queue->pDevice;
-    GPUFence_Vulkan* F  = (GPUFence_Vulkan*)desc->signal_fence;
-    uint32_t cmdCount   = desc->cmds_count;
-    GPUCommandBuffer_Vulkan** vkCmds = (GPUCommandBuffer_Vulkan**)desc->cmds;
-    // cgpu_assert that given cmd list and given params are valid
-    assert(cmdCount > 0);
-    assert(vkCmds);
-    // execute given command list
+    GPUQueue_Vulkan* Q   = (GPUQueue_Vulkan*)queue;
+    GPUDevice_Vulkan* D  = (GPUDevice_Vulkan*)queue->pDevice;
+    GPUAdapter_Vulkan* A = (GPUAdapter_Vulkan*)queue->pDevice->pAdapter;
+    GPUFence_Vulkan* F   = (GPUFence_Vulkan*)fence;
     assert(Q->pQueue != VK_NULL_HANDLE);
-    DECLEAR_ZERO_VAL(VkCommandBuffer, cmds, cmdCount);
-    for (uint32_t i = 0; i < cmdCount; i++)
+
+    // pending initial transitions run ahead of the first batch
+    std::vector<GPUTextureBarrier> textures;
+    std::vector<GPUBufferBarrier> buffers;
+    VulkanUtil_TakeQueuedTransitions(D->pTransitionTable, queue, textures, buffers);
+    GPUCommandBufferID transitionCmd = VulkanUtil_RecordQueuedTransitions(queue, submission, textures, buffers);
+
+    uint32_t totalCmds = 0, totalWaits = 0, totalSignals = 0;
+    for (uint32_t b = 0; b < batchCount; b++)
     {
-        cmds[i] = vkCmds[i]->pVkCmd;
+        assert(batches[b].cmds_count == 0 || batches[b].cmds);
+        totalCmds    += batches[b].cmds_count;
+        totalWaits   += batches[b].wait_count;
+        totalSignals += batches[b].signal_count;
     }
-
-    GPUSemaphore_Vulkan** vkSemaphores = (GPUSemaphore_Vulkan**)desc->wait_semaphores;
-    DECLEAR_ZERO_VAL(VkSemaphore, ppWaitSemaphore, desc->wait_semaphore_count + 1);
-    uint32_t waitCount = 0;
-    for (uint32_t i = 0; i < desc->wait_semaphore_count; i++)
+    // one extra signal for the queue submission counter
+    totalSignals += 1;
+
+    DECLEAR_ZERO_VAL(VkCommandBuffer, cmds, totalCmds + 2);
+    DECLEAR_ZERO_VAL(VkSemaphore, waitSemaphores, totalWaits + 1);
+    DECLEAR_ZERO_VAL(uint64_t, waitValues, totalWaits + 1);
+    DECLEAR_ZERO_VAL(VkPipelineStageFlags2, waitStages, totalWaits + 1);
+    DECLEAR_ZERO_VAL(VkSemaphore, signalSemaphores, totalSignals);
+    DECLEAR_ZERO_VAL(uint64_t, signalValues, totalSignals);
+    DECLEAR_ZERO_VAL(VkPipelineStageFlags2, signalStages, totalSignals);
+    DECLEAR_ZERO_VAL(uint32_t, batchCmdCounts, batchCount);
+    DECLEAR_ZERO_VAL(uint32_t, batchWaitCounts, batchCount);
+    DECLEAR_ZERO_VAL(uint32_t, batchSignalCounts, batchCount);
+
+    uint32_t cmdCount = 0, waitCount = 0, signalCount = 0;
+    if (transitionCmd)
+    {
+        cmds[cmdCount++] = ((GPUCommandBuffer_Vulkan*)transitionCmd)->pVkCmd;
+        batchCmdCounts[0]++;
+    }
+    for (uint32_t b = 0; b < batchCount; b++)
     {
-        if (vkSemaphores[i]->signaled)
+        const GPUQueueSubmitBatch& batch = batches[b];
+        for (uint32_t i = 0; i < batch.cmds_count; i++)
         {
-            ppWaitSemaphore[waitCount] = vkSemaphores[i]->pVkSemaphore;
-            vkSemaphores[i]->signaled  = false;
+            cmds[cmdCount++] = ((GPUCommandBuffer_Vulkan*)batch.cmds[i])->pVkCmd;
+            batchCmdCounts[b]++;
+        }
+        for (uint32_t i = 0; i < batch.wait_count; i++)
+        {
+            GPUSemaphore_Vulkan* S = (GPUSemaphore_Vulkan*)batch.waits[i].semaphore;
+            if (!S->super.timeline)
+            {
+                if (!S->signaled) continue;
+                S->signaled = false;
+            }
+            waitSemaphores[waitCount] = S->pVkSemaphore;
+            waitValues[waitCount]     = batch.waits[i].value;
+            waitStages[waitCount]     = VulkanUtil_PipelineStagesToVk(batch.waits[i].stages);
             waitCount++;
+            batchWaitCounts[b]++;
+        }
+        for (uint32_t i = 0; i < batch.signal_count; i++)
+        {
+            GPUSemaphore_Vulkan* S = (GPUSemaphore_Vulkan*)batch.signals[i].semaphore;
+            if (!S->super.timeline)
+            {
+                if (S->signaled) continue;
+                S->signaled = true;
+            }
+            signalSemaphores[signalCount] = S->pVkSemaphore;
+            signalValues[signalCount]     = batch.signals[i].value;
+            signalStages[signalCount]     = VulkanUtil_PipelineStagesToVk(batch.signals[i].stages);
+            signalCount++;
+            batchSignalCounts[b]++;
         }
     }
-
-    GPUSemaphore_Vulkan** vkSignalSemaphores = (GPUSemaphore_Vulkan**)desc->signal_semaphores;
-    DECLEAR_ZERO_VAL(VkSemaphore, ppSignalSemaphore, desc->signal_semaphore_count + 1);
-    uint32_t signalCount = 0;
-    for (uint32_t i = 0; i < desc->signal_semaphore_count; i++)
+    // signal operations of the last batch cover everything submitted before them
+    signalSemaphores[signalCount] = ((GPUSemaphore_Vulkan*)queue->timeline)->pVkSemaphore;
+    signalValues[signalCount]     = submission;
+    signalStages[signalCount]     = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    signalCount++;
+    batchSignalCounts[batchCount - 1]++;
+
+    VkResult rs = VK_SUCCESS;
+    if (A->adapterDetail.support_synchronization2 && D->mVkDeviceTable.vkQueueSubmit2)
     {
-        if (!vkSignalSemaphores[i]->signaled)
+        DECLEAR_ZERO_VAL(VkCommandBufferSubmitInfo, cmdInfos, totalCmds + 2);
+        DECLEAR_ZERO_VAL(VkSemaphoreSubmitInfo, waitInfos, totalWaits + 1);
+        DECLEAR_ZERO_VAL(VkSemaphoreSubmitInfo, signalInfos, totalSignals);
+        DECLEAR_ZERO_VAL(VkSubmitInfo2, infos, batchCount);
+        for (uint32_t i = 0; i < cmdCount; i++)
         {
-            ppSignalSemaphore[signalCount] = vkSignalSemaphores[i]->pVkSemaphore;
-            vkSemaphores[i]->signaled    = true;
-            signalCount++;
+            cmdInfos[i].sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+            cmdInfos[i].commandBuffer = cmds[i];
+        }
+        for (uint32_t i = 0; i < waitCount; i++)
+        {
+            waitInfos[i].sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            waitInfos[i].semaphore = waitSemaphores[i];
+            waitInfos[i].value     = waitValues[i];
+            waitInfos[i].stageMask = waitStages[i];
+        }
+        for (uint32_t i = 0; i < signalCount; i++)
+        {
+            signalInfos[i].sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            signalInfos[i].semaphore = signalSemaphores[i];
+            signalInfos[i].value     = signalValues[i];
+            signalInfos[i].stageMask = signalStages[i];
         }
+        uint32_t cmdOffset = 0, waitOffset = 0, signalOffset = 0;
+        for (uint32_t b = 0; b < batchCount; b++)
+        {
+            VkSubmitInfo2& info           = infos[b];
+            info.sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+            info.waitSemaphoreInfoCount   = batchWaitCounts[b];
+            info.pWaitSemaphoreInfos      = waitInfos + waitOffset;
+            info.commandBufferInfoCount   = batchCmdCounts[b];
+            info.pCommandBufferInfos      = cmdInfos + cmdOffset;
+            info.signalSemaphoreInfoCount = batchSignalCounts[b];
+            info.pSignalSemaphoreInfos    = signalInfos + signalOffset;
+            cmdOffset    += batchCmdCounts[b];
+            waitOffset   += batchWaitCounts[b];
+            signalOffset += batchSignalCounts[b];
+        }
+        rs = D->mVkDeviceTable.vkQueueSubmit2(Q->pQueue, batchCount, infos, F ? F->pVkFence : VK_NULL_HANDLE);
+    }
+    else
+    {
+        DECLEAR_ZERO_VAL(VkPipelineStageFlags, legacyWaitStages, totalWaits + 1);
+        DECLEAR_ZERO_VAL(VkTimelineSemaphoreSubmitInfo, timelineInfos, batchCount);
+        DECLEAR_ZERO_VAL(VkSubmitInfo, infos, batchCount);
+        for (uint32_t i = 0; i < waitCount; i++)
+        {
+            legacyWaitStages[i] = (VkPipelineStageFlags)waitStages[i];
+        }
+        uint32_t cmdOffset = 0, waitOffset = 0, signalOffset = 0;
+        for (uint32_t b = 0; b < batchCount; b++)
+        {
+            VkTimelineSemaphoreSubmitInfo& timelineInfo = timelineInfos[b];
+            timelineInfo.sType                          = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfo.waitSemaphoreValueCount        = batchWaitCounts[b];
+            timelineInfo.pWaitSemaphoreValues           = waitValues + waitOffset;
+            timelineInfo.signalSemaphoreValueCount      = batchSignalCounts[b];
+            timelineInfo.pSignalSemaphoreValues         = signalValues + signalOffset;
+
+            VkSubmitInfo& info        = infos[b];
+            info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            info.pNext                = &timelineInfo;
+            info.waitSemaphoreCount   = batchWaitCounts[b];
+            info.pWaitSemaphores      = waitSemaphores + waitOffset;
+            info.pWaitDstStageMask    = legacyWaitStages + waitOffset;
+            info.commandBufferCount   = batchCmdCounts[b];
+            info.pCommandBuffers      = cmds + cmdOffset;
+            info.signalSemaphoreCount = batchSignalCounts[b];
+            info.pSignalSemaphores    = signalSemaphores + signalOffset;
+            cmdOffset    += batchCmdCounts[b];
+            waitOffset   += batchWaitCounts[b];
+            signalOffset += batchSignalCounts[b];
+        }
+        rs = D->mVkDeviceTable.vkQueueSubmit(Q->pQueue, batchCount, infos, F ? F->pVkFence : VK_NULL_HANDLE);
     }
-
-    VkSubmitInfo info{};
-    info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    info.waitSemaphoreCount   = waitCount;
-    info.pWaitSemaphores      = waitCount ? ppSignalSemaphore : VK_NULL_HANDLE;
-    info.pWaitDstStageMask    = 0;
-    info.commandBufferCount   = cmdCount;
-    info.pCommandBuffers      = cmds;
-    info.signalSemaphoreCount = signalCount;
-    info.pSignalSemaphores    = signalCount ? ppWaitSemaphore : VK_NULL_HANDLE;
-
-    VkResult rs = D->mVkDeviceTable.vkQueueSubmit(Q->pQueue, 1, &info, F ? F->pVkFence : VK_NULL_HANDLE);
     if (rs != VK_SUCCESS)
     {
         if (rs == VK_ERROR_DEVICE_LOST)
@@ -647,6 +1133,64 @@ void GPUSubmitQueue_Vulkan(GPUQueueID queue, const struct GPUQueueSubmitDescript
     if (F) F->submitted = true;
 }
 
+void GPUSubmitQueue_Vulkan(GPUQueueID queue, const struct GPUQueueSubmitDescriptor* desc)
+{
+    // cgpu_assert that given cmd list and given params are valid
+    assert(desc->cmds_count > 0);
+    assert(desc->cmds);
+
+    DECLEAR_ZERO_VAL(GPUSemaphoreSubmitInfo, waits, desc->wait_semaphore_count + 1);
+    for (uint32_t i = 0; i < desc->wait_semaphore_count; i++)
+    {
+        assert(!desc->wait_semaphores[i]->timeline || desc->wait_values);
+        waits[i].semaphore = desc->wait_semaphores[i];
+        waits[i].value     = desc->wait_values ? desc->wait_values[i] : 0;
+        waits[i].stages    = desc->wait_stages ? desc->wait_stages[i] : (GPUPipelineStages)GPU_PIPELINE_STAGE_ALL_COMMANDS;
+    }
+    DECLEAR_ZERO_VAL(GPUSemaphoreSubmitInfo, signals, desc->signal_semaphore_count + 1);
+    for (uint32_t i = 0; i < desc->signal_semaphore_count; i++)
+    {
+        assert(!desc->signal_semaphores[i]->timeline || desc->signal_values);
+        signals[i].semaphore = desc->signal_semaphores[i];
+        signals[i].value     = desc->signal_values ? desc->signal_values[i] : 0;
+        signals[i].stages    = GPU_PIPELINE_STAGE_ALL_COMMANDS;
+    }
+
+    GPUQueueSubmitBatch batch = {
+        .cmds         = desc->cmds,
+        .waits        = waits,
+        .signals      = signals,
+        .cmds_count   = desc->cmds_count,
+        .wait_count   = desc->wait_semaphore_count,
+        .signal_count = desc->signal_semaphore_count
+    };
+    VulkanUtil_SubmitBatches(queue, &batch, 1, desc->signal_fence, queue->submitCount);
+}
+
+void GPUSubmitQueueBatches_Vulkan(GPUQueueID queue, const struct GPUQueueBatchSubmitDescriptor* desc)
+{
+    VulkanUtil_SubmitBatches(queue, desc->batches, desc->batch_count, desc->signal_fence, queue->submitCount);
+}
+
+uint64_t GPUFlushQueueTransitions_Vulkan(GPUQueueID queue)
+{
+    // taken under the table lock, a concurrent flush finds the list empty instead of submitting nothing
+    GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)queue->pDevice;
+    std::vector<GPUTextureBarrier> textures;
+    std::vector<GPUBufferBarrier> buffers;
+    VulkanUtil_TakeQueuedTransitions(D->pTransitionTable, queue, textures, buffers);
+    if (textures.empty() && buffers.empty()) return 0;
+
+    // GPUFlushQueueTransitions counts the submission once it is returned
+    const uint64_t submission = queue->submitCount + 1;
+    GPUCommandBufferID cmd    = VulkanUtil_RecordQueuedTransitions(queue, submission, textures, buffers);
+    GPUQueueSubmitBatch batch{};
+    batch.cmds       = &cmd;
+    batch.cmds_count = 1;
+    VulkanUtil_SubmitBatches(queue, &batch, 1, nullptr, submission);
+    return submission;
+}
+
 void GPUWaitQueueIdle_Vulkan(GPUQueueID queue)
 {
     GPUQueue_Vulkan* Q  = (GPUQueue_Vulkan*)queue;
@@ -1399,26 +1943,13 @@ GPUTextureID GPUCreateTexture_Vulkan(GPUDeviceID device, const GPUTextureDescrip
     // Start state
     if (Q && T->pVkImage != VK_NULL_HANDLE && T->pVkAllocation != VK_NULL_HANDLE)
     {
-        GPUResetCommandPool(Q->pInnerCmdPool);
-        GPUCmdBegin(Q->pInnerCmdBuffer);
         GPUTextureBarrier init_barrier = {
             .texture   = &T->super,
             .src_state = GPU_RESOURCE_STATE_UNDEFINED,
             .dst_state = desc->start_state
         };
-        GPUResourceBarrierDescriptor init_barrier_d = {
-            .texture_barriers       = &init_barrier,
-            .texture_barriers_count = 1
-        };
-        GPUCmdResourceBarrier(Q->pInnerCmdBuffer, &init_barrier_d);
-        GPUCmdEnd(Q->pInnerCmdBuffer);
-        GPUQueueSubmitDescriptor barrier_submit = {
-            .cmds         = &Q->pInnerCmdBuffer,
-            .signal_fence = Q->pInnerFence,
-            .cmds_count   = 1
-        };
-        GPUSubmitQueue(&Q->super, &barrier_submit);
-        GPUWaitFences(&Q->pInnerFence, 1);
+        std::lock_guard<std::mutex> guard(D->pTransitionTable->lock);
+        D->pTransitionTable->textures.emplace_back(&Q->super, init_barrier);
     }
     return &T->super;
 }
@@ -1427,6 +1958,11 @@ void GPUFreeTexture_Vulkan(GPUTextureID texture)
 {
     GPUDevice_Vulkan* D  = (GPUDevice_Vulkan*)texture->pDevice;
     GPUTexture_Vulkan* T = (GPUTexture_Vulkan*)texture;
+    {
+        std::lock_guard<std::mutex> guard(D->pTransitionTable->lock);
+        auto& pending = D->pTransitionTable->textures;
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [texture](const auto& iter) { return iter.second.texture == texture; }), pending.end());
+    }
     if (T->pVkImage != VK_NULL_HANDLE)
     {
         if (T->super.isImported)
@@ -1464,33 +2000,137 @@ void GPUFreeTexture_Vulkan(GPUTextureID texture)
     _aligned_free(T);
 }
 
+static bool VulkanUtil_IsSameShaderCode(const GPUVkCachedShader* cached, const GPUShaderLibraryDescriptor* pDesc)
+{
+    const uint32_t* code    = cached->library.pReflect ? spvReflectGetCode(cached->library.pReflect) : cached->code;
+    const uint32_t codeSize = cached->library.pReflect ? spvReflectGetCodeSize(cached->library.pReflect) : cached->codeSize;
+    return codeSize == pDesc->codeSize && memcmp(code, pDesc->code, pDesc->codeSize) == 0;
+}
+
+// called with the cache lock held, a hit is referenced so it outlives the unlocked work of the caller
+static GPUVkCachedShader* VulkanUtil_AcquireCachedShader(GPUVkShaderCache* cache, uint64_t hash, const GPUShaderLibraryDescriptor* pDesc)
+{
+    auto range = cache->shaders.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; iter++)
+    {
+        if (VulkanUtil_IsSameShaderCode(iter->second, pDesc))
+        {
+            iter->second->refs++;
+            return iter->second;
+        }
+    }
+    return nullptr;
+}
+
+static VkShaderModule VulkanUtil_CreateShaderModule(const GPUDevice_Vulkan* D, const GPUShaderLibraryDescriptor* pDesc)
+{
+    VkShaderModuleCreateInfo info{};
+    info.sType             = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    info.codeSize          = pDesc->codeSize;
+    info.pCode             = pDesc->code;
+    VkShaderModule pShader = VK_NULL_HANDLE;
+    VkResult result        = D->mVkDeviceTable.vkCreateShaderModule(D->pDevice, &info, GLOBAL_VkAllocationCallbacks, &pShader);
+    assert(result == VK_SUCCESS);
+    return pShader;
+}
+
+// reflection and module creation run outside the cache lock, a thread that loses the race
+// for the same code drops its copy and takes the cached one
 GPUShaderLibraryID GPUCreateShaderLibrary_Vulkan(GPUDeviceID pDevice, const GPUShaderLibraryDescriptor* pDesc)
 {
     GPUDevice_Vulkan* pVkDevice = (GPUDevice_Vulkan*)pDevice;
+    GPUVkShaderCache* cache     = pVkDevice->pShaderCache;
+    const uint64_t hash         = XXH3_64bits(pDesc->code, pDesc->codeSize);
 
-    VkShaderModuleCreateInfo info{};
-    info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    info.codeSize = pDesc->codeSize;
-    info.pCode    = pDesc->code;
+    GPUVkCachedShader* cached = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(cache->lock);
+        cached = VulkanUtil_AcquireCachedShader(cache, hash, pDesc);
+    }
+    if (!cached)
+    {
+        GPUVkCachedShader* created = (GPUVkCachedShader*)calloc(1, sizeof(GPUVkCachedShader));
+        created->hash              = hash;
+        created->refs              = 1;
+        VulkanUtil_InitializeShaderReflection(pDevice, &created->library, pDesc);
+        if (!created->library.pReflect)
+        {
+            created->code     = (uint32_t*)malloc(pDesc->codeSize);
+            created->codeSize = pDesc->codeSize;
+            memcpy(created->code, pDesc->code, pDesc->codeSize);
+        }
+        if (!pDesc->reflectionOnly) created->library.pShader = VulkanUtil_CreateShaderModule(pVkDevice, pDesc);
+        {
+            std::lock_guard<std::mutex> guard(cache->lock);
+            cached = VulkanUtil_AcquireCachedShader(cache, hash, pDesc);
+            if (!cached) cache->shaders.emplace(hash, created);
+        }
+        if (cached)
+        {
+            // another thread cached the same code meanwhile
+            if (created->library.pShader != VK_NULL_HANDLE)
+                pVkDevice->mVkDeviceTable.vkDestroyShaderModule(pVkDevice->pDevice, created->library.pShader, GLOBAL_VkAllocationCallbacks);
+            VulkanUtil_FreeShaderReflection(&created->library);
+            GPU_SAFE_FREE(created->code);
+            GPU_SAFE_FREE(created);
+        }
+        else
+        {
+            cached = created;
+        }
+    }
 
-    GPUShaderLibrary_Vulkan* pShader = (GPUShaderLibrary_Vulkan*)calloc(1, sizeof(GPUShaderLibrary_Vulkan));
-    if (!pDesc->reflectionOnly)
+    // a reflection only library may have been cached first
+    VkShaderModule pShader = VK_NULL_HANDLE;
+    {
+        std::lock_guard<std::mutex> guard(cache->lock);
+        pShader = cached->library.pShader;
+    }
+    if (!pDesc->reflectionOnly && pShader == VK_NULL_HANDLE)
     {
-        if (pVkDevice->mVkDeviceTable.vkCreateShaderModule(pVkDevice->pDevice, &info, GLOBAL_VkAllocationCallbacks, &pShader->pShader) != VK_SUCCESS)
+        VkShaderModule pCreated = VulkanUtil_CreateShaderModule(pVkDevice, pDesc);
         {
-            assert(0);
+            std::lock_guard<std::mutex> guard(cache->lock);
+            if (cached->library.pShader == VK_NULL_HANDLE) cached->library.pShader = pCreated;
+            pShader = cached->library.pShader;
         }
+        if (pShader != pCreated) pVkDevice->mVkDeviceTable.vkDestroyShaderModule(pVkDevice->pDevice, pCreated, GLOBAL_VkAllocationCallbacks);
     }
-    VulkanUtil_InitializeShaderReflection(pDevice, pShader, pDesc);
-    return &pShader->super;
+
+    GPUShaderLibrary_Vulkan* pVkShader = (GPUShaderLibrary_Vulkan*)calloc(1, sizeof(GPUShaderLibrary_Vulkan));
+    pVkShader->super.entry_reflections = cached->library.super.entry_reflections;
+    pVkShader->super.entrys_count      = cached->library.super.entrys_count;
+    pVkShader->pShader                 = pShader;
+    pVkShader->pReflect                = cached->library.pReflect;
+    pVkShader->pCached                 = cached;
+    return &pVkShader->super;
 }
 
 void GPUFreeShaderLibrary_Vulkan(GPUShaderLibraryID pShader)
 {
     GPUShaderLibrary_Vulkan* pVkShader = (GPUShaderLibrary_Vulkan*)pShader;
     GPUDevice_Vulkan* pVkDevice        = (GPUDevice_Vulkan*)pShader->pDevice;
-    VulkanUtil_FreeShaderReflection(pVkShader);
-    pVkDevice->mVkDeviceTable.vkDestroyShaderModule(pVkDevice->pDevice, pVkShader->pShader, GLOBAL_VkAllocationCallbacks);
+    GPUVkShaderCache* cache            = pVkDevice->pShaderCache;
+    GPUVkCachedShader* cached          = pVkShader->pCached;
+    {
+        std::lock_guard<std::mutex> guard(cache->lock);
+        if (--cached->refs == 0)
+        {
+            auto range = cache->shaders.equal_range(cached->hash);
+            for (auto iter = range.first; iter != range.second; iter++)
+            {
+                if (iter->second == cached)
+                {
+                    cache->shaders.erase(iter);
+                    break;
+                }
+            }
+            VulkanUtil_FreeShaderReflection(&cached->library);
+            GPU_SAFE_FREE(cached->code);
+            pVkDevice->mVkDeviceTable.vkDestroyShaderModule(pVkDevice->pDevice, cached->library.pShader, GLOBAL_VkAllocationCallbacks);
+            GPU_SAFE_FREE(cached);
+        }
+    }
     GPU_SAFE_FREE(pVkShader);
 }
 
@@ -1585,63 +2225,372 @@ static void FindOrCreateFrameBuffer(const GPUDevice_Vulkan* D, const struct Vulk
     VulkanUtil_FrameBufferTableAdd(D->pPassTable, pDesc, *ppFramebuffer);
 }
 
-GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GPURenderPipelineDescriptor* pDesc)
+// the map entries address the values inside the descriptor's array, nothing is copied
+static const VkSpecializationInfo* VulkanUtil_FillSpecializationInfo(const GPUShaderEntryDescriptor* entry, VkSpecializationMapEntry* mapEntries, VkSpecializationInfo* info)
 {
-    GPUDevice_Vulkan* pVkDevice = (GPUDevice_Vulkan*)pDevice;
-    GPURootSignature_Vulkan* pVkRS = (GPURootSignature_Vulkan*)pDesc->pRootSignature;
+    if (entry->num_constants == 0) return VK_NULL_HANDLE;
+    assert(entry->constants);
+    for (uint32_t i = 0; i < entry->num_constants; i++)
+    {
+        const uint32_t size = entry->constants[i].size ? entry->constants[i].size : sizeof(uint32_t);
+        assert((size == sizeof(uint32_t) || size == sizeof(uint64_t)) && "specialization constants are 4 or 8 bytes!");
+        mapEntries[i].constantID = entry->constants[i].constantID;
+        mapEntries[i].offset     = i * sizeof(GPUConstantSpecialization) + offsetof(GPUConstantSpecialization, u64);
+        mapEntries[i].size       = size;
+    }
+    info->mapEntryCount = entry->num_constants;
+    info->pMapEntries   = mapEntries;
+    info->dataSize      = entry->num_constants * sizeof(GPUConstantSpecialization);
+    info->pData         = entry->constants;
+    return info;
+}
 
-    // Vertex input state
-    uint32_t inputBindingCount = 0;
-    uint32_t inputAttribCount  = 0;
-    uint32_t attrCount         = pDesc->pVertexLayout->attributeCount > GPU_MAX_VERTEX_ATTRIBS ? GPU_MAX_VERTEX_ATTRIBS : pDesc->pVertexLayout->attributeCount;
-    uint32_t attribVal         = 0xffffffff;
-    for (uint32_t i = 0; i < attrCount; i++)
+// library keys are built from value fields only, create infos carry pointers and padding
+template <typename... Ts>
+static void VulkanUtil_AppendLibraryKey(std::string& key, const Ts&... values)
+{
+    (key.append((const char*)&values, sizeof(values)), ...);
+}
+
+static void VulkanUtil_AppendLibraryKey(std::string& key, const VkPipelineShaderStageCreateInfo& stage, const GPUShaderEntryDescriptor* entry)
+{
+    // the module handle may be reused by another shader, the code hash identifies it
+    const GPUShaderLibrary_Vulkan* S = (const GPUShaderLibrary_Vulkan*)entry->pLibrary;
+    VulkanUtil_AppendLibraryKey(key, S->pCached->hash);
+    key.append(stage.pName);
+    key.push_back('\0');
+    VulkanUtil_AppendLibraryKey(key, entry->num_constants);
+    for (uint32_t i = 0; i < entry->num_constants; i++)
     {
-        const GPUVertexAttribute* pAttrib = &pDesc->pVertexLayout->attributes[i];
-        uint32_t arraySize                = pAttrib->arraySize ? pAttrib->arraySize : 1;
-        if (attribVal != pAttrib->binding)
-        {
-            attribVal = pAttrib->binding;
-            inputBindingCount++;
-        }
-        for (uint32_t j = 0; j < arraySize; j++)
-        {
-            inputAttribCount += 1;
-        }
+        // the upper half of a 4-byte constant is not part of its value
+        const GPUConstantSpecialization& constant = entry->constants[i];
+        if (constant.size == sizeof(uint64_t)) VulkanUtil_AppendLibraryKey(key, constant.constantID, constant.size, constant.u64);
+        else VulkanUtil_AppendLibraryKey(key, constant.constantID, constant.u);
     }
-    uint64_t dsize = sizeof(GPURenderPipeline_Vulkan);
-    uint64_t inputElemOffset = dsize;
-    dsize += (sizeof(VkVertexInputBindingDescription) * inputBindingCount);
-    uint64_t inputAttribsOffset = dsize;
-    dsize += (sizeof(VkVertexInputAttributeDescription) * inputAttribCount);
-    uint8_t* ptr                                   = (uint8_t*)calloc(1, dsize);
-    GPURenderPipeline_Vulkan* pRp                  = (GPURenderPipeline_Vulkan*)ptr;
-    VkVertexInputBindingDescription* pBindingDesc  = (VkVertexInputBindingDescription*)(ptr + inputElemOffset);
-    VkVertexInputAttributeDescription* pAttribDesc = (VkVertexInputAttributeDescription*)(ptr + inputAttribsOffset);
+}
 
-    uint32_t slot = 0;
-    for (uint32_t i = 0; i < attrCount; i++)
+static void VulkanUtil_AppendLibraryKey(std::string& key, const VkGraphicsPipelineCreateInfo& shared)
+{
+    VulkanUtil_AppendLibraryKey(key, shared.flags, shared.pDynamicState->dynamicStateCount);
+    for (uint32_t i = 0; i < shared.pDynamicState->dynamicStateCount; i++)
     {
-        const GPUVertexAttribute* pAttrib         = &pDesc->pVertexLayout->attributes[i];
-        uint32_t arraySize                        = pAttrib->arraySize ? pAttrib->arraySize : 1;
-        VkVertexInputBindingDescription* bindDesc = &pBindingDesc[pAttrib->binding];
-        bindDesc->binding                         = pAttrib->binding;
-        if (pAttrib->rate == EGPUVertexInputRate::GPU_INPUT_RATE_VERTEX)
-        {
-            bindDesc->inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-        }
-        else
-        {
-            bindDesc->inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
-        }
-        bindDesc->stride += pAttrib->stride;
+        VulkanUtil_AppendLibraryKey(key, shared.pDynamicState->pDynamicStates[i]);
+    }
+}
 
-        for (uint32_t j = 0; j < arraySize; j++)
-        {
-            pAttribDesc[slot].location = slot;
+static void VulkanUtil_AppendLibraryKey(std::string& key, const VkPipelineVertexInputStateCreateInfo& state)
+{
+    VulkanUtil_AppendLibraryKey(key, state.vertexBindingDescriptionCount);
+    for (uint32_t i = 0; i < state.vertexBindingDescriptionCount; i++)
+    {
+        const VkVertexInputBindingDescription& binding = state.pVertexBindingDescriptions[i];
+        VulkanUtil_AppendLibraryKey(key, binding.binding, binding.stride, binding.inputRate);
+    }
+    VulkanUtil_AppendLibraryKey(key, state.vertexAttributeDescriptionCount);
+    for (uint32_t i = 0; i < state.vertexAttributeDescriptionCount; i++)
+    {
+        const VkVertexInputAttributeDescription& attribute = state.pVertexAttributeDescriptions[i];
+        VulkanUtil_AppendLibraryKey(key, attribute.location, attribute.binding, attribute.format, attribute.offset);
+    }
+}
+
+static void VulkanUtil_AppendLibraryKey(std::string& key, const VkPipelineRasterizationStateCreateInfo& state)
+{
+    VulkanUtil_AppendLibraryKey(key, state.depthClampEnable, state.rasterizerDiscardEnable, state.polygonMode, state.cullMode, state.frontFace);
+    VulkanUtil_AppendLibraryKey(key, state.depthBiasEnable, state.depthBiasConstantFactor, state.depthBiasClamp, state.depthBiasSlopeFactor, state.lineWidth);
+}
+
+static void VulkanUtil_AppendLibraryKey(std::string& key, const VkStencilOpState& state)
+{
+    VulkanUtil_AppendLibraryKey(key, state.failOp, state.passOp, state.depthFailOp, state.compareOp, state.compareMask, state.writeMask, state.reference);
+}
+
+static void VulkanUtil_AppendLibraryKey(std::string& key, const VkPipelineDepthStencilStateCreateInfo& state)
+{
+    VulkanUtil_AppendLibraryKey(key, state.depthTestEnable, state.depthWriteEnable, state.depthCompareOp, state.depthBoundsTestEnable, state.stencilTestEnable);
+    VulkanUtil_AppendLibraryKey(key, state.front);
+    VulkanUtil_AppendLibraryKey(key, state.back);
+    VulkanUtil_AppendLibraryKey(key, state.minDepthBounds, state.maxDepthBounds);
+}
+
+static void VulkanUtil_AppendLibraryKey(std::string& key, const VkPipelineMultisampleStateCreateInfo& state)
+{
+    VulkanUtil_AppendLibraryKey(key, state.rasterizationSamples, state.sampleShadingEnable, state.minSampleShading, state.alphaToCoverageEnable, state.alphaToOneEnable);
+    // one mask word per 32 samples
+    const uint32_t maskCount = state.pSampleMask ? ((uint32_t)state.rasterizationSamples + 31) / 32 : 0;
+    VulkanUtil_AppendLibraryKey(key, maskCount);
+    for (uint32_t i = 0; i < maskCount; i++)
+    {
+        VulkanUtil_AppendLibraryKey(key, state.pSampleMask[i]);
+    }
+}
+
+static void VulkanUtil_AppendLibraryKey(std::string& key, const VkPipelineColorBlendStateCreateInfo& state)
+{
+    VulkanUtil_AppendLibraryKey(key, state.logicOpEnable, state.logicOp, state.blendConstants, state.attachmentCount);
+    for (uint32_t i = 0; i < state.attachmentCount; i++)
+    {
+        const VkPipelineColorBlendAttachmentState& attachment = state.pAttachments[i];
+        VulkanUtil_AppendLibraryKey(key, attachment.blendEnable, attachment.srcColorBlendFactor, attachment.dstColorBlendFactor, attachment.colorBlendOp);
+        VulkanUtil_AppendLibraryKey(key, attachment.srcAlphaBlendFactor, attachment.dstAlphaBlendFactor, attachment.alphaBlendOp, attachment.colorWriteMask);
+    }
+}
+
+static VkPipeline VulkanUtil_FindOrCreatePipelineLibrary(const GPUDevice_Vulkan* D, GPUVkPipelineLibraryCache* cache, const std::string& key,
+                                                         VkGraphicsPipelineLibraryFlagsEXT part, VkGraphicsPipelineCreateInfo info)
+{
+    std::lock_guard<std::mutex> guard(cache->lock);
+    auto found = cache->libraries.find(key);
+    if (found != cache->libraries.end()) return found->second;
+
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+        .pNext = NULL,
+        .flags = part
+    };
+    info.pNext          = &libraryInfo;
+    info.flags         |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+    VkPipeline library  = VK_NULL_HANDLE;
+    VkResult result     = D->mVkDeviceTable.vkCreateGraphicsPipelines(D->pDevice, VK_NULL_HANDLE, 1, &info, GLOBAL_VkAllocationCallbacks, &library);
+    assert(result == VK_SUCCESS);
+    cache->libraries.emplace(key, library);
+    return library;
+}
+
+// splits a complete pipeline into the four library parts, compiles the missing ones and fast-links them
+static VkPipeline VulkanUtil_LinkGraphicsPipeline(const GPUDevice_Vulkan* D, const GPURootSignature_Vulkan* RS, const GPURenderPipelineDescriptor* pDesc, const VkGraphicsPipelineCreateInfo& full)
+{
+    assert(RS->pPipelineLibraries && "root signature was created before the pipeline library mode!");
+    VkGraphicsPipelineCreateInfo base{};
+    base.sType         = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    base.flags         = full.flags;
+    base.pDynamicState = full.pDynamicState;
+    VkPipeline libraries[4];
+
+    // vertex input interface
+    std::string key;
+    key.push_back('V');
+    VulkanUtil_AppendLibraryKey(key, base);
+    VulkanUtil_AppendLibraryKey(key, *full.pVertexInputState);
+    VulkanUtil_AppendLibraryKey(key, full.pInputAssemblyState->topology, full.pInputAssemblyState->primitiveRestartEnable);
+    VkGraphicsPipelineCreateInfo info = base;
+    info.pVertexInputState            = full.pVertexInputState;
+    info.pInputAssemblyState          = full.pInputAssemblyState;
+    libraries[0]                      = VulkanUtil_FindOrCreatePipelineLibrary(D, D->pPipelineLibraries, key, VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, info);
+
+    // pre-rasterization shaders
+    key.assign(1, 'P');
+    VulkanUtil_AppendLibraryKey(key, base);
+    VulkanUtil_AppendLibraryKey(key, full.pStages[0], pDesc->pVertexShader);
+    VulkanUtil_AppendLibraryKey(key, full.pViewportState->viewportCount, full.pViewportState->scissorCount);
+    VulkanUtil_AppendLibraryKey(key, *full.pRasterizationState);
+    VulkanUtil_AppendLibraryKey(key, full.renderPass, full.subpass);
+    info                     = base;
+    info.stageCount          = 1;
+    info.pStages             = &full.pStages[0];
+    info.pViewportState      = full.pViewportState;
+    info.pRasterizationState = full.pRasterizationState;
+    info.layout              = full.layout;
+    info.renderPass          = full.renderPass;
+    info.subpass             = full.subpass;
+    libraries[1]             = VulkanUtil_FindOrCreatePipelineLibrary(D, RS->pPipelineLibraries, key, VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT, info);
+
+    // fragment shader
+    key.assign(1, 'F');
+    VulkanUtil_AppendLibraryKey(key, base);
+    VulkanUtil_AppendLibraryKey(key, full.pStages[1], pDesc->pFragmentShader);
+    VulkanUtil_AppendLibraryKey(key, *full.pDepthStencilState);
+    VulkanUtil_AppendLibraryKey(key, *full.pMultisampleState);
+    VulkanUtil_AppendLibraryKey(key, full.renderPass, full.subpass);
+    info                    = base;
+    info.stageCount         = 1;
+    info.pStages            = &full.pStages[1];
+    info.pDepthStencilState = full.pDepthStencilState;
+    info.pMultisampleState  = full.pMultisampleState;
+    info.layout             = full.layout;
+    info.renderPass         = full.renderPass;
+    info.subpass            = full.subpass;
+    libraries[2]            = VulkanUtil_FindOrCreatePipelineLibrary(D, RS->pPipelineLibraries, key, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, info);
+
+    // fragment output interface
+    key.assign(1, 'O');
+    VulkanUtil_AppendLibraryKey(key, base);
+    VulkanUtil_AppendLibraryKey(key, *full.pColorBlendState);
+    VulkanUtil_AppendLibraryKey(key, *full.pMultisampleState);
+    VulkanUtil_AppendLibraryKey(key, full.renderPass, full.subpass);
+    info                   = base;
+    info.pColorBlendState  = full.pColorBlendState;
+    info.pMultisampleState = full.pMultisampleState;
+    info.renderPass        = full.renderPass;
+    info.subpass           = full.subpass;
+    libraries[3]           = VulkanUtil_FindOrCreatePipelineLibrary(D, D->pPipelineLibraries, key, VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT, info);
+
+    // no link time optimization, linking stays cheap
+    VkPipelineLibraryCreateInfoKHR linkInfo = {
+        .sType        = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+        .pNext        = NULL,
+        .libraryCount = 4,
+        .pLibraries   = libraries
+    };
+    info                = {};
+    info.sType          = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    info.pNext          = &linkInfo;
+    info.flags          = full.flags;
+    info.layout         = full.layout;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult result     = D->mVkDeviceTable.vkCreateGraphicsPipelines(D->pDevice, VK_NULL_HANDLE, 1, &info, GLOBAL_VkAllocationCallbacks, &pipeline);
+    assert(result == VK_SUCCESS);
+    return pipeline;
+}
+
+static void VulkanUtil_TranslateDepthState(const GPUDepthStateDesc* pState, VkPipelineDepthStencilStateCreateInfo* dss)
+{
+    dss->sType                 = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    dss->depthTestEnable       = pState->depthTest ? VK_TRUE : VK_FALSE;
+    dss->depthWriteEnable      = pState->depthWrite ? VK_TRUE : VK_FALSE;
+    dss->depthCompareOp        = VulkanUtil_CompareOpToVk(pState->depthFunc);
+    dss->depthBoundsTestEnable = VK_FALSE;
+    dss->stencilTestEnable     = pState->stencilTest ? VK_TRUE : VK_FALSE;
+    dss->front.failOp          = VulkanUtil_StencilOpToVk(pState->stencilFrontFail);
+    dss->front.passOp          = VulkanUtil_StencilOpToVk(pState->stencilFrontPass);
+    dss->front.depthFailOp     = VulkanUtil_StencilOpToVk(pState->depthFrontFail);
+    dss->front.compareOp       = VulkanUtil_CompareOpToVk(pState->stencilFrontFunc);
+    dss->front.compareMask     = pState->stencilReadMask;
+    dss->front.writeMask       = pState->stencilWriteMask;
+    dss->front.reference       = 0;
+    dss->back.failOp           = VulkanUtil_StencilOpToVk(pState->stencilBackFail);
+    dss->back.passOp           = VulkanUtil_StencilOpToVk(pState->stencilBackPass);
+    dss->back.depthFailOp      = VulkanUtil_StencilOpToVk(pState->depthBackFail);
+    dss->back.compareOp        = VulkanUtil_CompareOpToVk(pState->stencilBackFunc);
+    dss->back.compareMask      = pState->stencilReadMask;
+    dss->back.writeMask        = pState->stencilWriteMask;
+    dss->back.reference        = 0;
+    dss->minDepthBounds        = 0.f;
+    dss->maxDepthBounds        = 1.f;
+}
+
+static void VulkanUtil_TranslateRasterizerState(const GPURasterizerStateDescriptor* pState, VkPipelineRasterizationStateCreateInfo* rs)
+{
+    uint32_t depthBias = pState ? pState->depthBias : 0;
+    rs->sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rs->depthClampEnable        = pState ? (pState->enableDepthClamp ? VK_TRUE : VK_FALSE) : VK_FALSE;
+    rs->rasterizerDiscardEnable = VK_FALSE;
+    rs->polygonMode             = pState ? gVkFillModeTranslator[pState->fillMode] : VK_POLYGON_MODE_FILL;
+    rs->cullMode                = pState ? gVkCullModeTranslator[pState->cullMode] : VK_CULL_MODE_BACK_BIT;
+    rs->frontFace               = pState ? gVkFrontFaceTranslator[pState->frontFace] : VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rs->depthBiasEnable         = (depthBias != 0) ? VK_TRUE : VK_FALSE;
+    rs->depthBiasConstantFactor = pState ? pState->depthBias : 0.f;
+    rs->depthBiasClamp          = 0.f;
+    rs->depthBiasSlopeFactor    = pState ? pState->slopeScaledDepthBias : 0.f;
+    rs->lineWidth               = 1.f;
+}
+
+// moves the states the device sets dynamically from the create infos into state,
+// the topology stays baked since it can only change inside its class
+static void VulkanUtil_RecordDynamicState(const GPUDevice_Vulkan* D, VkPipelineRasterizationStateCreateInfo& rs, VkPipelineDepthStencilStateCreateInfo& dss,
+                                          VkPrimitiveTopology topology, GPUVkDynamicState* state)
+{
+    state->cullMode             = rs.cullMode;
+    state->frontFace            = rs.frontFace;
+    state->topology             = topology;
+    state->polygonMode          = rs.polygonMode;
+    state->depthClamp           = rs.depthClampEnable;
+    state->depthBias            = rs.depthBiasEnable;
+    state->depthTest            = dss.depthTestEnable;
+    state->depthWrite           = dss.depthWriteEnable;
+    state->depthCompareOp       = dss.depthCompareOp;
+    state->stencilTest          = dss.stencilTestEnable;
+    state->front.failOp         = dss.front.failOp;
+    state->front.passOp         = dss.front.passOp;
+    state->front.depthFailOp    = dss.front.depthFailOp;
+    state->front.compareOp      = dss.front.compareOp;
+    state->back.failOp          = dss.back.failOp;
+    state->back.passOp          = dss.back.passOp;
+    state->back.depthFailOp     = dss.back.depthFailOp;
+    state->back.compareOp       = dss.back.compareOp;
+
+    rs.cullMode                 = VK_CULL_MODE_NONE;
+    rs.frontFace                = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    dss.depthTestEnable         = VK_FALSE;
+    dss.depthWriteEnable        = VK_FALSE;
+    dss.depthCompareOp          = VK_COMPARE_OP_NEVER;
+    dss.stencilTestEnable       = VK_FALSE;
+    dss.front.failOp            = VK_STENCIL_OP_KEEP;
+    dss.front.passOp            = VK_STENCIL_OP_KEEP;
+    dss.front.depthFailOp       = VK_STENCIL_OP_KEEP;
+    dss.front.compareOp         = VK_COMPARE_OP_NEVER;
+    dss.back.failOp             = VK_STENCIL_OP_KEEP;
+    dss.back.passOp             = VK_STENCIL_OP_KEEP;
+    dss.back.depthFailOp        = VK_STENCIL_OP_KEEP;
+    dss.back.compareOp          = VK_COMPARE_OP_NEVER;
+    if (D->extendedDynamicState2)
+    {
+        rs.depthBiasEnable = VK_FALSE;
+    }
+    if (D->extendedDynamicState3)
+    {
+        rs.polygonMode      = VK_POLYGON_MODE_FILL;
+        rs.depthClampEnable = VK_FALSE;
+    }
+}
+
+GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GPURenderPipelineDescriptor* pDesc)
+{
+    GPUDevice_Vulkan* pVkDevice = (GPUDevice_Vulkan*)pDevice;
+    GPURootSignature_Vulkan* pVkRS = (GPURootSignature_Vulkan*)pDesc->pRootSignature;
+
+    // Vertex input state
+    uint32_t inputBindingCount = 0;
+    uint32_t inputAttribCount  = 0;
+    uint32_t attrCount         = pDesc->pVertexLayout->attributeCount > GPU_MAX_VERTEX_ATTRIBS ? GPU_MAX_VERTEX_ATTRIBS : pDesc->pVertexLayout->attributeCount;
+    uint32_t attribVal         = 0xffffffff;
+    for (uint32_t i = 0; i < attrCount; i++)
+    {
+        const GPUVertexAttribute* pAttrib = &pDesc->pVertexLayout->attributes[i];
+        uint32_t arraySize                = pAttrib->arraySize ? pAttrib->arraySize : 1;
+        if (attribVal != pAttrib->binding)
+        {
+            attribVal = pAttrib->binding;
+            inputBindingCount++;
+        }
+        for (uint32_t j = 0; j < arraySize; j++)
+        {
+            inputAttribCount += 1;
+        }
+    }
+    uint64_t dsize = sizeof(GPURenderPipeline_Vulkan);
+    uint64_t inputElemOffset = dsize;
+    dsize += (sizeof(VkVertexInputBindingDescription) * inputBindingCount);
+    uint64_t inputAttribsOffset = dsize;
+    dsize += (sizeof(VkVertexInputAttributeDescription) * inputAttribCount);
+    uint8_t* ptr                                   = (uint8_t*)calloc(1, dsize);
+    GPURenderPipeline_Vulkan* pRp                  = (GPURenderPipeline_Vulkan*)ptr;
+    VkVertexInputBindingDescription* pBindingDesc  = (VkVertexInputBindingDescription*)(ptr + inputElemOffset);
+    VkVertexInputAttributeDescription* pAttribDesc = (VkVertexInputAttributeDescription*)(ptr + inputAttribsOffset);
+
+    uint32_t slot = 0;
+    for (uint32_t i = 0; i < attrCount; i++)
+    {
+        const GPUVertexAttribute* pAttrib         = &pDesc->pVertexLayout->attributes[i];
+        uint32_t arraySize                        = pAttrib->arraySize ? pAttrib->arraySize : 1;
+        VkVertexInputBindingDescription* bindDesc = &pBindingDesc[pAttrib->binding];
+        bindDesc->binding                         = pAttrib->binding;
+        if (pAttrib->rate == EGPUVertexInputRate::GPU_INPUT_RATE_VERTEX)
+        {
+            bindDesc->inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        }
+        else
+        {
+            bindDesc->inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        }
+        bindDesc->stride += pAttrib->stride;
+
+        for (uint32_t j = 0; j < arraySize; j++)
+        {
+            pAttribDesc[slot].location = slot;
             pAttribDesc[slot].binding  = pAttrib->binding;
             pAttribDesc[slot].format   = GPUFormatToVulkanFormat(pAttrib->format);
-            pAttribDesc[slot].offset   = pAttrib->offset + (j * VulkanUtil_BitSizeOfBlock(pAttrib->format) / 8);
+            pAttribDesc[slot].offset   = pAttrib->offset + (j * Utils::FormatUtil_BitSizeOfBlock(pAttrib->format) / 8);
             slot++;
         }
     }
@@ -1664,6 +2613,11 @@ GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GP
     shaderStage[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
     shaderStage[1].module = ((GPUShaderLibrary_Vulkan*)(pDesc->pFragmentShader->pLibrary))->pShader;
     shaderStage[1].pName  = (const char*)pDesc->pFragmentShader->entry;
+    DECLEAR_ZERO_VAL(VkSpecializationMapEntry, vsMapEntries, pDesc->pVertexShader->num_constants + 1)
+    DECLEAR_ZERO_VAL(VkSpecializationMapEntry, fsMapEntries, pDesc->pFragmentShader->num_constants + 1)
+    VkSpecializationInfo specInfos[2]{};
+    shaderStage[0].pSpecializationInfo = VulkanUtil_FillSpecializationInfo(pDesc->pVertexShader, vsMapEntries, &specInfos[0]);
+    shaderStage[1].pSpecializationInfo = VulkanUtil_FillSpecializationInfo(pDesc->pFragmentShader, fsMapEntries, &specInfos[1]);
 
     // Viewport state
     VkPipelineViewportStateCreateInfo viewPort{};
@@ -1673,7 +2627,7 @@ GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GP
     viewPort.scissorCount  = 1;
     viewPort.pScissors     = VK_NULL_HANDLE;
 
-    VkDynamicState dyn_states[] = {
+    VkDynamicState dyn_states[16] = {
         VK_DYNAMIC_STATE_VIEWPORT,
         VK_DYNAMIC_STATE_SCISSOR,
         VK_DYNAMIC_STATE_BLEND_CONSTANTS,
@@ -1683,9 +2637,30 @@ GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GP
 //        VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR
 //#endif
     };
+    uint32_t dyn_state_count = 5;
+    if (pVkDevice->extendedDynamicState)
+    {
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_CULL_MODE_EXT;
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_FRONT_FACE_EXT;
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT;
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT;
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT;
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT;
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT;
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_STENCIL_OP_EXT;
+    }
+    if (pVkDevice->extendedDynamicState2)
+    {
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT;
+    }
+    if (pVkDevice->extendedDynamicState3)
+    {
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_POLYGON_MODE_EXT;
+        dyn_states[dyn_state_count++] = VK_DYNAMIC_STATE_DEPTH_CLAMP_ENABLE_EXT;
+    }
     VkPipelineDynamicStateCreateInfo dyInfo {};
     dyInfo.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dyInfo.dynamicStateCount = sizeof(dyn_states) / sizeof(VkDynamicState);
+    dyInfo.dynamicStateCount = dyn_state_count;
     dyInfo.pDynamicStates    = dyn_states;
 
     // Multi-sampling
@@ -1706,43 +2681,18 @@ GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GP
 
     // Depth stencil state
     VkPipelineDepthStencilStateCreateInfo dss{};
-    dss.sType                 = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    dss.depthTestEnable       = pDesc->pDepthState->depthTest ? VK_TRUE : VK_FALSE;
-    dss.depthWriteEnable      = pDesc->pDepthState->depthWrite ? VK_TRUE : VK_FALSE;
-    dss.depthCompareOp        = VulkanUtil_CompareOpToVk(pDesc->pDepthState->depthFunc);
-    dss.depthBoundsTestEnable = VK_FALSE;
-    dss.stencilTestEnable     = pDesc->pDepthState->stencilTest ? VK_TRUE : VK_FALSE;
-    dss.front.failOp          = VulkanUtil_StencilOpToVk(pDesc->pDepthState->stencilFrontFail);
-    dss.front.passOp          = VulkanUtil_StencilOpToVk(pDesc->pDepthState->stencilFrontPass);
-    dss.front.depthFailOp     = VulkanUtil_StencilOpToVk(pDesc->pDepthState->depthFrontFail);
-    dss.front.compareOp       = VulkanUtil_CompareOpToVk(pDesc->pDepthState->stencilFrontFunc);
-    dss.front.compareMask     = pDesc->pDepthState->stencilReadMask;
-    dss.front.writeMask       = pDesc->pDepthState->stencilWriteMask;
-    dss.front.reference       = 0;
-    dss.back.failOp           = VulkanUtil_StencilOpToVk(pDesc->pDepthState->stencilBackFail);
-    dss.back.passOp           = VulkanUtil_StencilOpToVk(pDesc->pDepthState->stencilBackPass);
-    dss.back.depthFailOp      = VulkanUtil_StencilOpToVk(pDesc->pDepthState->depthBackFail);
-    dss.back.compareOp        = VulkanUtil_CompareOpToVk(pDesc->pDepthState->stencilBackFunc);
-    dss.back.compareMask      = pDesc->pDepthState->stencilReadMask;
-    dss.back.writeMask        = pDesc->pDepthState->stencilWriteMask;
-    dss.back.reference        = 0;
-    dss.minDepthBounds        = 0.f;
-    dss.maxDepthBounds        = 1.f;
+    VulkanUtil_TranslateDepthState(pDesc->pDepthState, &dss);
 
     // Rasterizer state
-    uint32_t depthBias = pDesc->pRasterizerState ? pDesc->pRasterizerState->depthBias : 0;
     VkPipelineRasterizationStateCreateInfo rs{};
-    rs.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rs.depthClampEnable        = pDesc->pRasterizerState ? (pDesc->pRasterizerState->enableDepthClamp ? VK_TRUE : VK_FALSE) : VK_FALSE;
-    rs.rasterizerDiscardEnable = VK_FALSE;
-    rs.polygonMode             = pDesc->pRasterizerState ? gVkFillModeTranslator[pDesc->pRasterizerState->fillMode] : VK_POLYGON_MODE_FILL;
-    rs.cullMode                = pDesc->pRasterizerState ? gVkCullModeTranslator[pDesc->pRasterizerState->cullMode] : VK_CULL_MODE_BACK_BIT;
-    rs.frontFace               = pDesc->pRasterizerState ? gVkFrontFaceTranslator[pDesc->pRasterizerState->frontFace] : VK_FRONT_FACE_COUNTER_CLOCKWISE;
-    rs.depthBiasEnable         = (depthBias != 0) ? VK_TRUE : VK_FALSE;
-    rs.depthBiasConstantFactor = pDesc->pRasterizerState ? pDesc->pRasterizerState->depthBias : 0.f;
-    rs.depthBiasClamp          = 0.f;
-    rs.depthBiasSlopeFactor    = pDesc->pRasterizerState ? pDesc->pRasterizerState->slopeScaledDepthBias : 0.f;
-    rs.lineWidth               = 1.f;
+    VulkanUtil_TranslateRasterizerState(pDesc->pRasterizerState, &rs);
+
+    // the dynamic parts are recorded for the bind and zeroed in the baked state,
+    // pipelines differing only in them share the same driver and library cache entries
+    if (pVkDevice->extendedDynamicState)
+    {
+        VulkanUtil_RecordDynamicState(pVkDevice, rs, dss, ia.topology, &pRp->dynamicState);
+    }
 
      // Color blending state
     VkPipelineColorBlendAttachmentState colorBlendattachments[GPU_MAX_MRT_COUNT] = {};
@@ -1794,6 +2744,7 @@ GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GP
     FindOrCreateRenderPass(pVkDevice, &renderPassDesc, &pRenderPass);
     VkGraphicsPipelineCreateInfo pipelineCreateInfo{};
     pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.flags = pVkDevice->pDescriptorHeap ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0;
     pipelineCreateInfo.stageCount = shaderStagCount;
     pipelineCreateInfo.pStages    = shaderStage;
     pipelineCreateInfo.pVertexInputState = &vertexInputInfo;
@@ -1809,6 +2760,11 @@ GPURenderPipelineID GPUCreateRenderPipeline_Vulkan(GPUDeviceID pDevice, const GP
     pipelineCreateInfo.renderPass          = pRenderPass;
     pipelineCreateInfo.subpass             = 0;
 
+    if (pVkDevice->graphicsPipelineLibrary)
+    {
+        pRp->pPipeline = VulkanUtil_LinkGraphicsPipeline(pVkDevice, pVkRS, pDesc, pipelineCreateInfo);
+        return &pRp->super;
+    }
     VkResult result = pVkDevice->mVkDeviceTable.vkCreateGraphicsPipelines(pVkDevice->pDevice, VK_NULL_HANDLE, 1, &pipelineCreateInfo, GLOBAL_VkAllocationCallbacks, &pRp->pPipeline);
     assert(result == VK_SUCCESS);
 
@@ -1824,27 +2780,189 @@ void GPUFreeRenderPipeline_Vulkan(GPURenderPipelineID pPipeline)
     GPU_SAFE_FREE(pVkRpr);
 }
 
+GPUComputePipelineID GPUCreateComputePipeline_Vulkan(GPUDeviceID pDevice, const GPUComputePipelineDescriptor* pDesc)
+{
+    GPUDevice_Vulkan* pVkDevice    = (GPUDevice_Vulkan*)pDevice;
+    GPURootSignature_Vulkan* pVkRS = (GPURootSignature_Vulkan*)pDesc->pRootSignature;
+    GPUComputePipeline_Vulkan* pCp = (GPUComputePipeline_Vulkan*)calloc(1, sizeof(GPUComputePipeline_Vulkan));
+
+    VkPipelineShaderStageCreateInfo shaderStage{};
+    shaderStage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    shaderStage.module = ((GPUShaderLibrary_Vulkan*)(pDesc->pComputeShader->pLibrary))->pShader;
+    shaderStage.pName  = (const char*)pDesc->pComputeShader->entry;
+    DECLEAR_ZERO_VAL(VkSpecializationMapEntry, mapEntries, pDesc->pComputeShader->num_constants + 1)
+    VkSpecializationInfo specInfo{};
+    shaderStage.pSpecializationInfo = VulkanUtil_FillSpecializationInfo(pDesc->pComputeShader, mapEntries, &specInfo);
+
+    VkComputePipelineCreateInfo pipelineCreateInfo{};
+    pipelineCreateInfo.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.flags  = pVkDevice->pDescriptorHeap ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0;
+    pipelineCreateInfo.stage  = shaderStage;
+    pipelineCreateInfo.layout = pVkRS->pPipelineLayout;
+
+    VkResult result = pVkDevice->mVkDeviceTable.vkCreateComputePipelines(pVkDevice->pDevice, VK_NULL_HANDLE, 1, &pipelineCreateInfo, GLOBAL_VkAllocationCallbacks, &pCp->pPipeline);
+    assert(result == VK_SUCCESS);
+
+    return &pCp->super;
+}
+
+void GPUFreeComputePipeline_Vulkan(GPUComputePipelineID pPipeline)
+{
+    GPUDevice_Vulkan* pVkDevice      = (GPUDevice_Vulkan*)pPipeline->pDevice;
+    GPUComputePipeline_Vulkan* pVkCp = (GPUComputePipeline_Vulkan*)pPipeline;
+
+    pVkDevice->mVkDeviceTable.vkDestroyPipeline(pVkDevice->pDevice, pVkCp->pPipeline, GLOBAL_VkAllocationCallbacks);
+    GPU_SAFE_FREE(pVkCp);
+}
+
+// layout size and binding offsets, plus the empty set with the static samplers written in
+static void VulkanUtil_RecordDescriptorBufferLayout(const GPUDevice_Vulkan* D, SetLayout_Vulkan* layout, const VkDescriptorSetLayoutBinding* bindings, uint32_t count)
+{
+    D->mVkDeviceTable.vkGetDescriptorSetLayoutSizeEXT(D->pDevice, layout->pLayout, &layout->descriptorSize);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (bindings[i].binding >= layout->bindingOffsetCount) layout->bindingOffsetCount = bindings[i].binding + 1;
+    }
+    layout->pBindingOffsets = (VkDeviceSize*)calloc(layout->bindingOffsetCount ? layout->bindingOffsetCount : 1, sizeof(VkDeviceSize));
+    for (uint32_t i = 0; i < count; i++)
+    {
+        D->mVkDeviceTable.vkGetDescriptorSetLayoutBindingOffsetEXT(D->pDevice, layout->pLayout, bindings[i].binding, &layout->pBindingOffsets[bindings[i].binding]);
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (bindings[i].descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER || bindings[i].descriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+            layout->samplerDescriptors = true;
+    }
+    layout->emptyOffset = VulkanUtil_AllocateDescriptors(D, layout->descriptorSize, layout->samplerDescriptors, &layout->pEmptyAllocation);
+    // immutable samplers still have to be present in the buffer
+    uint8_t* pEmpty = D->pDescriptorHeap->pMapped + layout->emptyOffset;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!bindings[i].pImmutableSamplers) continue;
+        VkDescriptorImageInfo info{};
+        info.sampler = bindings[i].pImmutableSamplers[0];
+        VulkanUtil_WriteDescriptor(D, pEmpty + layout->pBindingOffsets[bindings[i].binding], VK_DESCRIPTOR_TYPE_SAMPLER, &info, NULL);
+    }
+}
+
+// everything the vulkan objects of a signature are made of, names are left out since binding goes through the own tables
+static uint64_t VulkanUtil_RootSignatureKey(const GPURootSignature* RS, const struct GPURootSignatureDescriptor* desc, std::vector<uint64_t>& key)
+{
+    key.push_back(RS->pipeline_type);
+    key.push_back((uint64_t)(uintptr_t)RS->bindless_heap);
+    key.push_back(((uint64_t)RS->bindless_set << 32) | RS->transient_set_mask);
+    for (uint32_t i = 0; i < RS->table_count; i++)
+    {
+        const GPUParameterTable& table = RS->tables[i];
+        key.push_back(((uint64_t)table.set_index << 32) | table.resources_count);
+        for (uint32_t j = 0; j < table.resources_count; j++)
+        {
+            const GPUShaderResource& res = table.resources[j];
+            key.push_back(((uint64_t)res.set << 32) | res.binding);
+            key.push_back(((uint64_t)res.type << 32) | res.stages);
+            key.push_back(((uint64_t)res.size << 1) | res.dynamic_offset);
+        }
+    }
+    for (uint32_t i = 0; i < RS->static_sampler_count; i++)
+    {
+        const GPUShaderResource& res = RS->static_samplers[i];
+        key.push_back(((uint64_t)res.set << 32) | res.binding);
+        key.push_back(((uint64_t)res.stages << 32) | res.size);
+        key.push_back((uint64_t)(uintptr_t)desc->static_samplers[i]);
+    }
+    for (uint32_t i = 0; i < RS->push_constant_count; i++)
+    {
+        const GPUShaderResource& res = RS->push_constants[i];
+        key.push_back(res.stages);
+        key.push_back(((uint64_t)res.offset << 32) | res.size);
+    }
+    return XXH3_64bits(key.data(), key.size() * sizeof(uint64_t));
+}
+
+static const GPURootSignature_Vulkan* VulkanUtil_PoolAcquireSignature(GPURootSignaturePoolID pool, uint64_t hash, const std::vector<uint64_t>& key)
+{
+    GPURootSignaturePool_Vulkan* P = (GPURootSignaturePool_Vulkan*)pool;
+    std::lock_guard<std::mutex> guard(P->lock);
+    auto range = P->signatures.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; iter++)
+    {
+        if (iter->second.key == key)
+        {
+            iter->second.refs++;
+            return iter->second.pSignature;
+        }
+    }
+    return nullptr;
+}
+
+static void VulkanUtil_PoolAddSignature(GPURootSignaturePoolID pool, GPURootSignature_Vulkan* RS, uint64_t hash, std::vector<uint64_t>&& key)
+{
+    GPURootSignaturePool_Vulkan* P = (GPURootSignaturePool_Vulkan*)pool;
+    // the pool keeps its own copy of the vulkan objects, they outlive the signature that created them
+    GPURootSignature_Vulkan* poolSig = (GPURootSignature_Vulkan*)calloc(1, sizeof(GPURootSignature_Vulkan));
+    *poolSig                         = *RS;
+    poolSig->super.tables            = nullptr;
+    poolSig->super.table_count       = 0;
+    poolSig->super.push_constants    = nullptr;
+    poolSig->super.static_samplers   = nullptr;
+    poolSig->super.pool              = pool;
+    poolSig->super.pool_sig          = &poolSig->super;
+    RS->super.pool                   = pool;
+    RS->super.pool_sig               = &poolSig->super;
+
+    std::lock_guard<std::mutex> guard(P->lock);
+    P->signatures.emplace(hash, GPUVkPooledSignature{ std::move(key), poolSig, 1 });
+}
+
+// returns the pool signature once its last user is gone
+static GPURootSignature_Vulkan* VulkanUtil_PoolReleaseSignature(GPURootSignatureID RS)
+{
+    GPURootSignaturePool_Vulkan* P = (GPURootSignaturePool_Vulkan*)RS->pool;
+    std::lock_guard<std::mutex> guard(P->lock);
+    for (auto iter = P->signatures.begin(); iter != P->signatures.end(); iter++)
+    {
+        if (&iter->second.pSignature->super != RS->pool_sig) continue;
+        if (--iter->second.refs) return nullptr;
+        GPURootSignature_Vulkan* poolSig = iter->second.pSignature;
+        P->signatures.erase(iter);
+        return poolSig;
+    }
+    assert(0 && "root signature is not in its pool!");
+    return nullptr;
+}
+
 GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struct GPURootSignatureDescriptor* desc)
 {
     const GPUDevice_Vulkan* D   = (GPUDevice_Vulkan*)device;
     GPURootSignature_Vulkan* RS = (GPURootSignature_Vulkan*)malloc(sizeof(GPURootSignature_Vulkan));
     memset(RS, 0, sizeof(GPURootSignature_Vulkan));
     CGPUUtil_InitRSParamTables((GPURootSignature*)RS, desc);
+    // descriptor buffer layouts have no dynamic descriptors and cannot share a pipeline layout with pool sets
+    assert(!(D->pDescriptorHeap && (desc->dynamic_buffer_count || desc->bindless_heap || desc->transient_set_mask)) && "not available in descriptor buffer mode!");
+    // vulkan pushes a single set per pipeline layout
+    assert(!(desc->transient_set_mask & (desc->transient_set_mask - 1)) && "only one transient set is supported!");
+    assert((!desc->transient_set_mask || ((GPUAdapter_Vulkan*)device->pAdapter)->adapterDetail.support_push_descriptor) && "push descriptors are not supported by the adapter!");
     // [RS POOL] ALLOCATION
+    std::vector<uint64_t> pool_key;
+    uint64_t pool_hash = 0;
     if (desc->pool)
     {
-        /*GPURootSignature_Vulkan* poolSig =
-        (GPURootSignature_Vulkan*)GPUUtil_TryAllocateSignature(desc->pool, &RS->super, desc);
-        if (poolSig != VK_NULL_HANDLE)
+        assert(desc->pool->pipeline_type == RS->super.pipeline_type && "root signature pool of another pipeline type!");
+        pool_hash                              = VulkanUtil_RootSignatureKey(&RS->super, desc, pool_key);
+        const GPURootSignature_Vulkan* poolSig = VulkanUtil_PoolAcquireSignature(desc->pool, pool_hash, pool_key);
+        if (poolSig)
         {
-            RS->pPipelineLayout  = poolSig->pPipelineLayout;
-            RS->pSetLayouts      = poolSig->pSetLayouts;
-            RS->setLayoutsCount  = poolSig->setLayoutsCount;
+            RS->pPipelineLayout     = poolSig->pPipelineLayout;
+            RS->pSetLayouts         = poolSig->pSetLayouts;
+            RS->pVkSetLayouts       = poolSig->pVkSetLayouts;
+            RS->setLayoutsCount     = poolSig->setLayoutsCount;
             RS->pPushConstantRanges = poolSig->pPushConstantRanges;
-            RS->super.pool       = desc->pool;
-            RS->super.pool_sig   = &poolSig->super;
+            RS->pPipelineLibraries  = poolSig->pPipelineLibraries;
+            RS->super.pool          = desc->pool;
+            RS->super.pool_sig      = &poolSig->super;
             return &RS->super;
-        }*/
+        }
     }
     // [RS POOL] END ALLOCATION
     // set index mask. set(0, 1, 2, 3) -> 0000...1111
@@ -1859,6 +2977,11 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
     {
         set_index_mask |= (1 << RS->super.static_samplers[i].set);
     }
+    // bindless heap
+    if (RS->super.bindless_heap)
+    {
+        set_index_mask |= (1 << RS->super.bindless_set);
+    }
     // parse
     //const uint32_t set_count = get_set_count(set_index_mask);
     uint32_t set_count = 0;
@@ -1871,12 +2994,20 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
         }
         m >>= 1;
     }
-    RS->pSetLayouts          = (SetLayout_Vulkan*)malloc(set_count * sizeof(SetLayout_Vulkan));
+    RS->pSetLayouts          = (SetLayout_Vulkan*)calloc(set_count, sizeof(SetLayout_Vulkan));
     RS->setLayoutsCount      = set_count;
     uint32_t set_index       = 0;
     while (set_index_mask != 0)
     {
-        if (set_index_mask & 1)
+        if (set_index_mask & 1 && RS->super.bindless_heap && set_index == RS->super.bindless_set)
+        {
+            // the heap owns layout and set, flushing binds its set where an empty one would go
+            const GPUBindlessHeap_Vulkan* H          = (const GPUBindlessHeap_Vulkan*)RS->super.bindless_heap;
+            RS->pSetLayouts[set_index].pLayout       = H->pLayout;
+            RS->pSetLayouts[set_index].pEmptyDescSet = H->pSet;
+            RS->pSetLayouts[set_index].hash          = H->hash;
+        }
+        else if (set_index_mask & 1)
         {
             GPUParameterTable* param_table = NULL;
             for (uint32_t i = 0; i < RS->super.table_count; i++)
@@ -1897,8 +3028,18 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
                 {
                     vkbindings[i_binding].binding         = param_table->resources[i_binding].binding;
                     vkbindings[i_binding].stageFlags      = VulkanUtil_TranslateShaderUsages(param_table->resources[i_binding].stages);
-                    vkbindings[i_binding].descriptorType  = VulkanUtil_TranslateResourceType(param_table->resources[i_binding].type);
+                    vkbindings[i_binding].descriptorType  = VulkanUtil_TranslateShaderResourceType(&param_table->resources[i_binding]);
                     vkbindings[i_binding].descriptorCount = param_table->resources[i_binding].size;
+                    // dynamic offsets are consumed in binding order, remember which ones need the storage alignment
+                    for (uint32_t i = 0; param_table->resources[i_binding].dynamic_offset && i < param_table->resources[i_binding].size; i++)
+                    {
+                        SetLayout_Vulkan& layout = RS->pSetLayouts[set_index];
+                        assert(!(RS->super.transient_set_mask & (1u << set_index)) && "push descriptor sets cannot hold dynamic buffers!");
+                        assert(layout.dynamicOffsetCount < GPU_VK_MAX_DYNAMIC_OFFSETS);
+                        if (vkbindings[i_binding].descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)
+                            layout.storageDynamicOffsetMask |= 1u << layout.dynamicOffsetCount;
+                        layout.dynamicOffsetCount++;
+                    }
                 }
             }
             // static samplers
@@ -1918,7 +3059,8 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
             VkDescriptorSetLayoutCreateInfo set_info = {
                 .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
                 .pNext        = NULL,
-                .flags        = 0,
+                .flags        = D->pDescriptorHeap ? (VkDescriptorSetLayoutCreateFlags)VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT :
+                                (RS->super.transient_set_mask & (1u << set_index)) ? (VkDescriptorSetLayoutCreateFlags)VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0,
                 .bindingCount = i_binding,
                 .pBindings    = vkbindings
             };
@@ -1926,8 +3068,18 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
                                                                  &set_info,
                                                                  GLOBAL_VkAllocationCallbacks,
                                                                  &RS->pSetLayouts[set_index].pLayout) == VK_SUCCESS);
-            //vkAllocateDescriptorSets
-            VulkanUtil_ConsumeDescriptorSets(D->pDescriptorPool, &RS->pSetLayouts[set_index].pLayout, &RS->pSetLayouts[set_index].pEmptyDescSet, 1);
+            if (D->pDescriptorHeap)
+            {
+                VulkanUtil_RecordDescriptorBufferLayout(D, &RS->pSetLayouts[set_index], vkbindings, i_binding);
+            }
+            else if (!(RS->super.transient_set_mask & (1u << set_index)))
+            {
+                //vkAllocateDescriptorSets
+                VulkanUtil_ConsumeDescriptorSets(D->pDescriptorPool, &RS->pSetLayouts[set_index].pLayout, &RS->pSetLayouts[set_index].pEmptyDescSet, 1);
+            }
+            // push descriptor and descriptor buffer layouts are not compatible with plain ones of the same bindings
+            const size_t flags_seed         = Hash64(&set_info.flags, sizeof(set_info.flags), DEFAULT_HASH_SEED);
+            RS->pSetLayouts[set_index].hash = Hash64(vkbindings, i_binding * sizeof(VkDescriptorSetLayoutBinding), flags_seed);
 
             if (bindings_count) free(vkbindings);
         }
@@ -1936,18 +3088,18 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
     }
     // Push constants
     // Collect push constants count
-    /* if (RS->super.push_constant_count > 0)
+    if (RS->super.push_constant_count > 0)
     {
-        RS->pPushConstRanges = (VkPushConstantRange*)cgpu_calloc(RS->super.push_constant_count, sizeof(VkPushConstantRange));
+        RS->pPushConstantRanges = (VkPushConstantRange*)calloc(RS->super.push_constant_count, sizeof(VkPushConstantRange));
         // Create Vk Objects
         for (uint32_t i_const = 0; i_const < RS->super.push_constant_count; i_const++)
         {
-            RS->pPushConstRanges[i_const].stageFlags =
-            VkUtil_TranslateShaderUsages(RS->super.push_constants[i_const].stages);
-            RS->pPushConstRanges[i_const].size   = RS->super.push_constants[i_const].size;
-            RS->pPushConstRanges[i_const].offset = RS->super.push_constants[i_const].offset;
+            RS->pPushConstantRanges[i_const].stageFlags =
+            VulkanUtil_TranslateShaderUsages(RS->super.push_constants[i_const].stages);
+            RS->pPushConstantRanges[i_const].size   = RS->super.push_constants[i_const].size;
+            RS->pPushConstantRanges[i_const].offset = RS->super.push_constants[i_const].offset;
         }
-    }*/
+    }
     // Record Descriptor Sets
     RS->pVkSetLayouts = (VkDescriptorSetLayout*)malloc(set_count * sizeof(VkDescriptorSetLayout));
     for (uint32_t i_set = 0; i_set < set_count; i_set++)
@@ -1963,11 +3115,15 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
         .setLayoutCount         = set_count,
         .pSetLayouts            = RS->pVkSetLayouts,
         .pushConstantRangeCount = RS->super.push_constant_count,
-        //.pPushConstantRanges    = RS->pPushConstRanges
+        .pPushConstantRanges    = RS->pPushConstantRanges
     };
     assert(D->mVkDeviceTable.vkCreatePipelineLayout(D->pDevice, &pipeline_info, GLOBAL_VkAllocationCallbacks, &RS->pPipelineLayout) == VK_SUCCESS);
-    // Create Update Templates
-    for (uint32_t i_table = 0; i_table < RS->super.table_count; i_table++)
+    if (D->graphicsPipelineLibrary && RS->super.pipeline_type == GPU_PIPELINE_TYPE_GRAPHICS)
+    {
+        RS->pPipelineLibraries = VulkanUtil_CreatePipelineLibraryCache();
+    }
+    // Create Update Templates, descriptor buffer sets are written directly
+    for (uint32_t i_table = 0; i_table < RS->super.table_count && !D->pDescriptorHeap; i_table++)
     {
         GPUParameterTable* param_table                    = &RS->super.tables[i_table];
         SetLayout_Vulkan* set_to_record                   = &RS->pSetLayouts[param_table->set_index];
@@ -1979,7 +3135,7 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
             uint32_t i_binding                          = param_table->resources[i_iter].binding;
             VkDescriptorUpdateTemplateEntry* this_entry = template_entries + i_iter;
             this_entry->descriptorCount                 = param_table->resources[i_iter].size;
-            this_entry->descriptorType                  = VulkanUtil_TranslateResourceType(param_table->resources[i_iter].type);
+            this_entry->descriptorType                  = VulkanUtil_TranslateShaderResourceType(&param_table->resources[i_iter]);
             this_entry->dstBinding                      = i_binding;
             this_entry->dstArrayElement                 = 0;
             this_entry->stride                          = sizeof(VkDescriptorUpdateData);
@@ -1992,7 +3148,7 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
                 .pNext                      = NULL,
                 .descriptorUpdateEntryCount = update_entry_count,
                 .pDescriptorUpdateEntries   = template_entries,
-                .templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR,
+                .templateType               = (RS->super.transient_set_mask & (1u << param_table->set_index)) ? VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR : VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR,
                 .descriptorSetLayout        = set_to_record->pLayout,
                 .pipelineBindPoint          = gPipelineBindPoint[RS->super.pipeline_type],
                 .pipelineLayout             = RS->pPipelineLayout,
@@ -2008,34 +3164,68 @@ GPURootSignatureID GPUCreateRootSignature_Vulkan(GPUDeviceID device, const struc
     // [RS POOL] INSERTION
     if (desc->pool)
     {
-        /*const bool result = CGPUUtil_AddSignature(desc->pool, &RS->super, desc);
-        cgpu_assert(result && "Root signature pool insertion failed!");*/
+        VulkanUtil_PoolAddSignature(desc->pool, RS, pool_hash, std::move(pool_key));
     }
     // [RS POOL] END INSERTION
     return &RS->super;
 }
 
-void GPUFreeRootSignature_Vulkan(GPURootSignatureID RS)
+static void VulkanUtil_DestroyRootSignatureObjects(const GPUDevice_Vulkan* D, GPURootSignature_Vulkan* vkRS)
 {
-    GPUDevice_Vulkan* D           = (GPUDevice_Vulkan*)RS->device;
-    GPURootSignature_Vulkan* vkRS = (GPURootSignature_Vulkan*)RS;
-    GPUUtil_FreeRSParamTables((GPURootSignature*)RS);
-
-    // Free Vk Objects
     for (uint32_t i_set = 0; i_set < vkRS->setLayoutsCount; i_set++)
     {
         SetLayout_Vulkan* set_to_free = &vkRS->pSetLayouts[i_set];
+        if (vkRS->super.bindless_heap && i_set == vkRS->super.bindless_set)
+            continue;
         if (set_to_free->pLayout != VK_NULL_HANDLE)
             D->mVkDeviceTable.vkDestroyDescriptorSetLayout(D->pDevice, set_to_free->pLayout, GLOBAL_VkAllocationCallbacks);
         if (set_to_free->pUpdateTemplate != VK_NULL_HANDLE)
             D->mVkDeviceTable.vkDestroyDescriptorUpdateTemplate(D->pDevice, set_to_free->pUpdateTemplate, GLOBAL_VkAllocationCallbacks);
+        if (set_to_free->pEmptyAllocation)
+            VulkanUtil_FreeDescriptors(D, set_to_free->pEmptyAllocation, set_to_free->emptyOffset);
+        GPU_SAFE_FREE(set_to_free->pBindingOffsets);
     }
     GPU_SAFE_FREE(vkRS->pVkSetLayouts);
     GPU_SAFE_FREE(vkRS->pSetLayouts);
     GPU_SAFE_FREE(vkRS->pPushConstantRanges);
+    if (vkRS->pPipelineLibraries) VulkanUtil_FreePipelineLibraryCache(D, vkRS->pPipelineLibraries);
     D->mVkDeviceTable.vkDestroyPipelineLayout(D->pDevice, vkRS->pPipelineLayout, GLOBAL_VkAllocationCallbacks);
+}
+
+void GPUFreeRootSignature_Vulkan(GPURootSignatureID RS)
+{
+    GPUDevice_Vulkan* D           = (GPUDevice_Vulkan*)RS->device;
+    GPURootSignature_Vulkan* vkRS = (GPURootSignature_Vulkan*)RS;
+    if (RS->pool)
+    {
+        // the vulkan objects belong to the pool signature
+        GPURootSignature_Vulkan* poolSig = VulkanUtil_PoolReleaseSignature(RS);
+        if (poolSig)
+        {
+            VulkanUtil_DestroyRootSignatureObjects(D, poolSig);
+            GPU_SAFE_FREE(poolSig);
+        }
+    }
+    else
+    {
+        VulkanUtil_DestroyRootSignatureObjects(D, vkRS);
+    }
+    GPUUtil_FreeRSParamTables((GPURootSignature*)RS);
     GPU_SAFE_FREE(vkRS);
+}
+
+GPURootSignaturePoolID GPUCreateRootSignaturePool_Vulkan(GPUDeviceID device, const struct GPURootSignaturePoolDescriptor* desc)
+{
+    void* ptr = calloc(1, sizeof(GPURootSignaturePool_Vulkan));
+    return &(new (ptr) GPURootSignaturePool_Vulkan())->super;
+}
 
+void GPUFreeRootSignaturePool_Vulkan(GPURootSignaturePoolID pool)
+{
+    GPURootSignaturePool_Vulkan* P = (GPURootSignaturePool_Vulkan*)pool;
+    assert(P->signatures.empty() && "root signatures of the pool are still alive!");
+    P->~GPURootSignaturePool_Vulkan();
+    GPU_SAFE_FREE(P);
 }
 
 bool CGPUUtil_ShaderResourceIsRootConst(GPUShaderResource* resource, const struct GPURootSignatureDescriptor* desc)
@@ -2049,6 +3239,20 @@ bool CGPUUtil_ShaderResourceIsRootConst(GPUShaderResource* resource, const struc
     return false;
 }
 
+bool CGPUUtil_ShaderResourceIsDynamicBuffer(GPUShaderResource* resource, const struct GPURootSignatureDescriptor* desc)
+{
+    for (uint32_t i = 0; i < desc->dynamic_buffer_count; i++)
+    {
+        if (strcmp((const char*)resource->name, (const char*)desc->dynamic_buffer_names[i]) == 0)
+        {
+            return resource->type == GPU_RESOURCE_TYPE_UNIFORM_BUFFER ||
+                   resource->type == GPU_RESOURCE_TYPE_BUFFER || resource->type == GPU_RESOURCE_TYPE_BUFFER_RAW ||
+                   resource->type == GPU_RESOURCE_TYPE_RW_BUFFER || resource->type == GPU_RESOURCE_TYPE_RW_BUFFER_RAW;
+        }
+    }
+    return false;
+}
+
 bool CGPUUtil_ShaderResourceIsStaticSampler(GPUShaderResource* resource, const struct GPURootSignatureDescriptor* desc)
 {
     for (uint32_t i = 0; i < desc->static_sampler_count; i++)
@@ -2112,6 +3316,9 @@ void CGPUUtil_InitRSParamTables(GPURootSignature* RS, const struct GPURootSignat
     }
     // Collect all resources
     RS->pipeline_type = GPU_PIPELINE_TYPE_NONE;
+    RS->bindless_heap      = desc->bindless_heap;
+    RS->bindless_set       = desc->bindless_set;
+    RS->transient_set_mask = desc->transient_set_mask;
     std::vector<GPUShaderResource> all_resources;
     std::vector<GPUShaderResource> all_push_constants;
     std::vector<GPUShaderResource> all_static_samplers;
@@ -2155,9 +3362,14 @@ void CGPUUtil_InitRSParamTables(GPURootSignature* RS, const struct GPURootSignat
                 if (!coincided)
                     all_static_samplers.emplace_back(resource);
             }
+            else if (desc->bindless_heap && resource.set == desc->bindless_set)
+            {
+                // described by the heap layout
+                continue;
+            }
             else
             {
-                all_resources.emplace_back(resource);
+                all_resources.emplace_back(resource).dynamic_offset = CGPUUtil_ShaderResourceIsDynamicBuffer(&resource, desc);
             }
         }
         // Pipeline Type
@@ -2362,7 +3574,8 @@ GPUCommandBufferID GPUCreateCommandBuffer_Vulkan(GPUCommandPoolID pool, const GP
     GPUCommandPool_Vulkan* P   = (GPUCommandPool_Vulkan*)pool;
     GPUCommandBuffer_Vulkan* B = (GPUCommandBuffer_Vulkan*)_aligned_malloc(sizeof(GPUCommandBuffer_Vulkan), _alignof(GPUCommandBuffer_Vulkan));
     memset(B, 0, sizeof(GPUCommandBuffer_Vulkan));
-    B->type = pool->queue->queueType;
+    B->type      = pool->queue->queueType;
+    B->secondary = desc->isSecondary;
 
     VkCommandBufferAllocateInfo info{};
     info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -2385,6 +3598,15 @@ void GPUFreeCommandBuffer_Vulkan(GPUCommandBufferID cmd)
     _aligned_free(B);
 }
 
+// bindings outlive passes in vulkan, so only a switch of bind point forgets them
+static void VulkanUtil_EnterBindPoint(GPUCommandBuffer_Vulkan* Cmd, VkPipelineBindPoint bindPoint)
+{
+    if (Cmd->bound.bindPointValid && Cmd->bound.bindPoint == bindPoint) return;
+    memset(&Cmd->bound, 0, sizeof(GPUVkBoundState));
+    Cmd->bound.bindPoint      = bindPoint;
+    Cmd->bound.bindPointValid = 1;
+}
+
 void GPUCmdBegin_Vulkan(GPUCommandBufferID cmdBuffer)
 {
     GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)cmdBuffer->device;
@@ -2395,7 +3617,7 @@ void GPUCmdBegin_Vulkan(GPUCommandBufferID cmdBuffer)
     info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
     assert(D->mVkDeviceTable.vkBeginCommandBuffer(CMD->pVkCmd, &info) == VK_SUCCESS);
-    CMD->pLayout = VK_NULL_HANDLE;
+    memset(&CMD->bound, 0, sizeof(GPUVkBoundState));
 }
 
 void GPUCmdEnd_Vulkan(GPUCommandBufferID cmdBuffer)
@@ -2405,52 +3627,185 @@ void GPUCmdEnd_Vulkan(GPUCommandBufferID cmdBuffer)
     assert(D->mVkDeviceTable.vkEndCommandBuffer(CMD->pVkCmd) == VK_SUCCESS);
 }
 
-void GPUCmdResourceBarrier_Vulkan(GPUCommandBufferID cmd, const GPUResourceBarrierDescriptor* desc)
+// synchronization2 path: every barrier carries its own stage/access pair
+static void VulkanUtil_CmdResourceBarrier2(GPUCommandBuffer_Vulkan* Cmd, const GPUResourceBarrierDescriptor* desc)
 {
-    GPUCommandBuffer_Vulkan* Cmd = (GPUCommandBuffer_Vulkan*)cmd;
-    GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)cmd->device;
-    GPUAdapter_Vulkan* A = (GPUAdapter_Vulkan*)cmd->device->pAdapter;
-    VkAccessFlags srcAccessFlags = 0;
-    VkAccessFlags dstAccessFlags = 0;
+    GPUDevice_Vulkan* D       = (GPUDevice_Vulkan*)Cmd->super.device;
+    GPUAdapter_Vulkan* A      = (GPUAdapter_Vulkan*)Cmd->super.device->pAdapter;
+    const EGPUQueueType queue = (EGPUQueueType)Cmd->type;
 
-    DECLEAR_ZERO_VAL(VkBufferMemoryBarrier, BBs, desc->buffer_barriers_count);
-    uint32_t bufferBarrierCount = 0;
+    DECLEAR_ZERO_VAL(VkBufferMemoryBarrier2, BBs, desc->buffer_barriers_count + 1);
     for (uint32_t i = 0; i < desc->buffer_barriers_count; i++)
     {
         const GPUBufferBarrier* buffer_barrier = &desc->buffer_barriers[i];
-        GPUBuffer_Vulkan* B = (GPUBuffer_Vulkan*)buffer_barrier->buffer;
-        VkBufferMemoryBarrier* pBufferBarrier = NULL;
+        GPUBuffer_Vulkan* B                    = (GPUBuffer_Vulkan*)buffer_barrier->buffer;
+        VkBufferMemoryBarrier2* pBufferBarrier = &BBs[i];
+        pBufferBarrier->sType                  = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        pBufferBarrier->pNext                  = NULL;
 
         if (GPU_RESOURCE_STATE_UNORDERED_ACCESS == buffer_barrier->src_state &&
             GPU_RESOURCE_STATE_UNORDERED_ACCESS == buffer_barrier->dst_state)
         {
-            pBufferBarrier = &BBs[bufferBarrierCount++];                     //-V522
-            pBufferBarrier->sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER; //-V522
-            pBufferBarrier->pNext = NULL;
-
-            pBufferBarrier->srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-            pBufferBarrier->dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+            pBufferBarrier->srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+            pBufferBarrier->dstAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT;
         }
         else
         {
-            pBufferBarrier = &BBs[bufferBarrierCount++];
-            pBufferBarrier->sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-            pBufferBarrier->pNext = NULL;
-
             pBufferBarrier->srcAccessMask = VulkanUtil_ResourceStateToVkAccessFlags(buffer_barrier->src_state);
             pBufferBarrier->dstAccessMask = VulkanUtil_ResourceStateToVkAccessFlags(buffer_barrier->dst_state);
         }
-
-        if (pBufferBarrier)
+        pBufferBarrier->srcStageMask = buffer_barrier->src_stages ?
+                                       VulkanUtil_PipelineStagesToVk(buffer_barrier->src_stages) :
+                                       VulkanUtil_ResourceStateToPipelineStage2(buffer_barrier->src_state, queue);
+        pBufferBarrier->dstStageMask = buffer_barrier->dst_stages ?
+                                       VulkanUtil_PipelineStagesToVk(buffer_barrier->dst_stages) :
+                                       VulkanUtil_ResourceStateToPipelineStage2(buffer_barrier->dst_state, queue);
+
+        pBufferBarrier->buffer = B->pVkBuffer;
+        pBufferBarrier->size   = VK_WHOLE_SIZE;
+        pBufferBarrier->offset = 0;
+        if (buffer_barrier->queue_acquire)
         {
-            pBufferBarrier->buffer = B->pVkBuffer;
-            pBufferBarrier->size = VK_WHOLE_SIZE;
-            pBufferBarrier->offset = 0;
+            pBufferBarrier->dstQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[Cmd->type];
+            pBufferBarrier->srcQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[buffer_barrier->queue_type];
+        }
+        else if (buffer_barrier->queue_release)
+        {
+            pBufferBarrier->srcQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[Cmd->type];
+            pBufferBarrier->dstQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[buffer_barrier->queue_type];
+        }
+        else
+        {
+            pBufferBarrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            pBufferBarrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        }
+    }
 
-            if (buffer_barrier->queue_acquire)
-            {
-                pBufferBarrier->dstQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[Cmd->type];
-                pBufferBarrier->srcQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[buffer_barrier->queue_type];
+    DECLEAR_ZERO_VAL(VkImageMemoryBarrier2, TBs, desc->texture_barriers_count + 1);
+    for (uint32_t i = 0; i < desc->texture_barriers_count; i++)
+    {
+        const GPUTextureBarrier* texture_barrier = &desc->texture_barriers[i];
+        GPUTexture_Vulkan* T                     = (GPUTexture_Vulkan*)texture_barrier->texture;
+        VkImageMemoryBarrier2* pImageBarrier     = &TBs[i];
+        pImageBarrier->sType                     = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        pImageBarrier->pNext                     = NULL;
+
+        if (GPU_RESOURCE_STATE_UNORDERED_ACCESS == texture_barrier->src_state &&
+            GPU_RESOURCE_STATE_UNORDERED_ACCESS == texture_barrier->dst_state)
+        {
+            pImageBarrier->srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+            pImageBarrier->dstAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT;
+            pImageBarrier->oldLayout     = VK_IMAGE_LAYOUT_GENERAL;
+            pImageBarrier->newLayout     = VK_IMAGE_LAYOUT_GENERAL;
+        }
+        else
+        {
+            pImageBarrier->srcAccessMask = VulkanUtil_ResourceStateToVkAccessFlags(texture_barrier->src_state);
+            pImageBarrier->dstAccessMask = VulkanUtil_ResourceStateToVkAccessFlags(texture_barrier->dst_state);
+            if (texture_barrier->dst_state == GPU_RESOURCE_STATE_PRESENT)
+                pImageBarrier->dstAccessMask = VK_ACCESS_2_NONE; //PR table says "Must be 0"
+            pImageBarrier->oldLayout = VulkanUtil_ResourceStateToImageLayout(texture_barrier->src_state);
+            pImageBarrier->newLayout = VulkanUtil_ResourceStateToImageLayout(texture_barrier->dst_state);
+        }
+        pImageBarrier->srcStageMask = texture_barrier->src_stages ?
+                                      VulkanUtil_PipelineStagesToVk(texture_barrier->src_stages) :
+                                      VulkanUtil_ResourceStateToPipelineStage2(texture_barrier->src_state, queue);
+        pImageBarrier->dstStageMask = texture_barrier->dst_stages ?
+                                      VulkanUtil_PipelineStagesToVk(texture_barrier->dst_stages) :
+                                      VulkanUtil_ResourceStateToPipelineStage2(texture_barrier->dst_state, queue);
+
+        pImageBarrier->image                           = T->pVkImage;
+        pImageBarrier->subresourceRange.aspectMask     = (VkImageAspectFlags)T->super.aspectMask;
+        pImageBarrier->subresourceRange.baseMipLevel   = texture_barrier->subresource_barrier ? texture_barrier->mip_level : 0;
+        pImageBarrier->subresourceRange.levelCount     = texture_barrier->subresource_barrier ? 1 : VK_REMAINING_MIP_LEVELS;
+        pImageBarrier->subresourceRange.baseArrayLayer = texture_barrier->subresource_barrier ? texture_barrier->array_layer : 0;
+        pImageBarrier->subresourceRange.layerCount     = texture_barrier->subresource_barrier ? 1 : VK_REMAINING_ARRAY_LAYERS;
+        if (texture_barrier->queue_acquire &&
+            texture_barrier->src_state != GPU_RESOURCE_STATE_UNDEFINED)
+        {
+            pImageBarrier->dstQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[Cmd->type];
+            pImageBarrier->srcQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[texture_barrier->queue_type];
+        }
+        else if (texture_barrier->queue_release &&
+                 texture_barrier->src_state != GPU_RESOURCE_STATE_UNDEFINED)
+        {
+            pImageBarrier->srcQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[Cmd->type];
+            pImageBarrier->dstQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[texture_barrier->queue_type];
+        }
+        else
+        {
+            pImageBarrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            pImageBarrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        }
+    }
+
+    if (desc->buffer_barriers_count || desc->texture_barriers_count)
+    {
+        VkDependencyInfo dependency{};
+        dependency.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.bufferMemoryBarrierCount = desc->buffer_barriers_count;
+        dependency.pBufferMemoryBarriers    = BBs;
+        dependency.imageMemoryBarrierCount  = desc->texture_barriers_count;
+        dependency.pImageMemoryBarriers     = TBs;
+        D->mVkDeviceTable.vkCmdPipelineBarrier2(Cmd->pVkCmd, &dependency);
+    }
+}
+
+void GPUCmdResourceBarrier_Vulkan(GPUCommandBufferID cmd, const GPUResourceBarrierDescriptor* desc)
+{
+    GPUCommandBuffer_Vulkan* Cmd = (GPUCommandBuffer_Vulkan*)cmd;
+    GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)cmd->device;
+    GPUAdapter_Vulkan* A = (GPUAdapter_Vulkan*)cmd->device->pAdapter;
+    if (A->adapterDetail.support_synchronization2 && D->mVkDeviceTable.vkCmdPipelineBarrier2)
+    {
+        VulkanUtil_CmdResourceBarrier2(Cmd, desc);
+        return;
+    }
+
+    // legacy path: one stage mask pair for the whole batch
+    VkAccessFlags srcAccessFlags = 0;
+    VkAccessFlags dstAccessFlags = 0;
+    VkPipelineStageFlags srcStageHints = 0;
+    VkPipelineStageFlags dstStageHints = 0;
+
+    DECLEAR_ZERO_VAL(VkBufferMemoryBarrier, BBs, desc->buffer_barriers_count);
+    uint32_t bufferBarrierCount = 0;
+    for (uint32_t i = 0; i < desc->buffer_barriers_count; i++)
+    {
+        const GPUBufferBarrier* buffer_barrier = &desc->buffer_barriers[i];
+        GPUBuffer_Vulkan* B = (GPUBuffer_Vulkan*)buffer_barrier->buffer;
+        VkBufferMemoryBarrier* pBufferBarrier = NULL;
+
+        if (GPU_RESOURCE_STATE_UNORDERED_ACCESS == buffer_barrier->src_state &&
+            GPU_RESOURCE_STATE_UNORDERED_ACCESS == buffer_barrier->dst_state)
+        {
+            pBufferBarrier = &BBs[bufferBarrierCount++];                     //-V522
+            pBufferBarrier->sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER; //-V522
+            pBufferBarrier->pNext = NULL;
+
+            pBufferBarrier->srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            pBufferBarrier->dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+        }
+        else
+        {
+            pBufferBarrier = &BBs[bufferBarrierCount++];
+            pBufferBarrier->sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            pBufferBarrier->pNext = NULL;
+
+            pBufferBarrier->srcAccessMask = VulkanUtil_ResourceStateToVkAccessFlags(buffer_barrier->src_state);
+            pBufferBarrier->dstAccessMask = VulkanUtil_ResourceStateToVkAccessFlags(buffer_barrier->dst_state);
+        }
+
+        if (pBufferBarrier)
+        {
+            pBufferBarrier->buffer = B->pVkBuffer;
+            pBufferBarrier->size = VK_WHOLE_SIZE;
+            pBufferBarrier->offset = 0;
+
+            if (buffer_barrier->queue_acquire)
+            {
+                pBufferBarrier->dstQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[Cmd->type];
+                pBufferBarrier->srcQueueFamilyIndex = (uint32_t)A->queueFamilyIndices[buffer_barrier->queue_type];
             }
             else if (buffer_barrier->queue_release)
             {
@@ -2464,6 +3819,8 @@ void GPUCmdResourceBarrier_Vulkan(GPUCommandBufferID cmd, const GPUResourceBarri
             }
             srcAccessFlags |= pBufferBarrier->srcAccessMask;
             dstAccessFlags |= pBufferBarrier->dstAccessMask;
+            srcStageHints |= (VkPipelineStageFlags)buffer_barrier->src_stages;
+            dstStageHints |= (VkPipelineStageFlags)buffer_barrier->dst_stages;
         }
     }
 
@@ -2529,14 +3886,16 @@ void GPUCmdResourceBarrier_Vulkan(GPUCommandBufferID cmd, const GPUResourceBarri
 
             srcAccessFlags |= pImageBarrier->srcAccessMask;
             dstAccessFlags |= pImageBarrier->dstAccessMask;
+            srcStageHints |= (VkPipelineStageFlags)texture_barrier->src_stages;
+            dstStageHints |= (VkPipelineStageFlags)texture_barrier->dst_stages;
         }
     }
 
     // Commit barriers
     VkPipelineStageFlags srcStageMask =
-        VulkanUtil_DeterminePipelineStageFlags(A, srcAccessFlags, (EGPUQueueType)Cmd->type);
+        VulkanUtil_DeterminePipelineStageFlags(A, srcAccessFlags, (EGPUQueueType)Cmd->type) | srcStageHints;
     VkPipelineStageFlags dstStageMask =
-        VulkanUtil_DeterminePipelineStageFlags(A, dstAccessFlags, (EGPUQueueType)Cmd->type);
+        VulkanUtil_DeterminePipelineStageFlags(A, dstAccessFlags, (EGPUQueueType)Cmd->type) | dstStageHints;
     if (bufferBarrierCount || imageBarrierCount)
     {
         D->mVkDeviceTable.vkCmdPipelineBarrier(Cmd->pVkCmd,
@@ -2548,83 +3907,152 @@ void GPUCmdResourceBarrier_Vulkan(GPUCommandBufferID cmd, const GPUResourceBarri
 }
 
 void GPUCmdTransferBufferToTexture_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToTextureTransfer* desc)
+{
+    GPUBufferToTextureRegion region{};
+    region.src_offset      = desc->src_offset;
+    region.dst_subresource = desc->dst_subresource;
+
+    GPUBufferToTextureRegions regions{};
+    regions.dst           = desc->dst;
+    regions.src           = desc->src;
+    regions.regions       = &region;
+    regions.regions_count = 1;
+    GPUCmdTransferBufferToTextureRegions_Vulkan(cmd, &regions);
+}
+
+void GPUCmdTransferBufferToBuffer_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToBufferTransfer* desc)
+{
+    GPUBufferToBufferRegion region{};
+    region.src_offset = desc->src_offset;
+    region.dst_offset = desc->dst_offset;
+    region.size       = desc->size;
+
+    GPUBufferToBufferRegions regions{};
+    regions.dst           = desc->dst;
+    regions.src           = desc->src;
+    regions.regions       = &region;
+    regions.regions_count = 1;
+    GPUCmdTransferBufferToBufferRegions_Vulkan(cmd, &regions);
+}
+
+void GPUCmdTransferTextureToTexture_Vulkan(GPUCommandBufferID cmd, const struct GPUTextureToTextureTransfer* desc)
+{
+    GPUTextureToTextureRegion region{};
+    region.src_subresource = desc->src_subresource;
+    region.dst_subresource = desc->dst_subresource;
+
+    GPUTextureToTextureRegions regions{};
+    regions.src           = desc->src;
+    regions.dst           = desc->dst;
+    regions.regions       = &region;
+    regions.regions_count = 1;
+    GPUCmdTransferTextureToTextureRegions_Vulkan(cmd, &regions);
+}
+
+// zero extent components run to the end of the mip level
+static VkExtent3D VulkanUtil_RegionExtent(GPUTextureID texture, uint32_t mip, const GPUTextureOffset& offset, const GPUTextureExtent& extent)
+{
+    const uint32_t width  = gpu_max(1, texture->width >> mip);
+    const uint32_t height = gpu_max(1, texture->height >> mip);
+    const uint32_t depth  = gpu_max(1, texture->depth >> mip);
+    VkExtent3D result;
+    result.width  = extent.width ? extent.width : width - offset.x;
+    result.height = extent.height ? extent.height : height - offset.y;
+    result.depth  = extent.depth ? extent.depth : depth - offset.z;
+    return result;
+}
+
+void GPUCmdTransferBufferToTextureRegions_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToTextureRegions* desc)
 {
     GPUCommandBuffer_Vulkan* Cmd = (GPUCommandBuffer_Vulkan*)cmd;
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)cmd->device;
     GPUTexture_Vulkan* Dst       = (GPUTexture_Vulkan*)desc->dst;
     GPUBuffer_Vulkan* Src        = (GPUBuffer_Vulkan*)desc->src;
-    const bool isSinglePlane     = true;
     const EGPUFormat fmt         = (EGPUFormat)desc->dst->format;
-    if (isSinglePlane)
-    {
-        const uint32_t width  = gpu_max(1, desc->dst->width >> desc->dst_subresource.mip_level);
-        const uint32_t height = gpu_max(1, desc->dst->height >> desc->dst_subresource.mip_level);
-        const uint32_t depth  = gpu_max(1, desc->dst->depth >> desc->dst_subresource.mip_level);
-
-        const uint32_t xBlocksCount = width / 1;//TODO: FormatUtil_WidthOfBlock
-        const uint32_t yBlocksCount = height / 1;
-
-        VkBufferImageCopy copy = {};
-        copy.bufferOffset                    = desc->src_offset;
-        copy.bufferRowLength                 = xBlocksCount * 1;//指定像素在内存中的布局方式, 指定0表示像素紧密打包, 和imageExtent.width相等
-        copy.bufferImageHeight               = yBlocksCount * 1;//指定像素在内存中的布局方式, 指定0表示像素紧密打包，和imageExtent.height相等
-        copy.imageSubresource.aspectMask     = (VkImageAspectFlags)desc->dst->aspectMask;
-        copy.imageSubresource.mipLevel       = desc->dst_subresource.mip_level;
-        copy.imageSubresource.baseArrayLayer = desc->dst_subresource.base_array_layer;
-        copy.imageSubresource.layerCount     = desc->dst_subresource.layer_count;
-        copy.imageOffset.x                   = 0;
-        copy.imageOffset.y                   = 0;
-        copy.imageOffset.z                   = 0;
-        copy.imageExtent.width               = width;
-        copy.imageExtent.height              = height;
-        copy.imageExtent.depth               = depth;
-        D->mVkDeviceTable.vkCmdCopyBufferToImage(Cmd->pVkCmd,
-                                                 Src->pVkBuffer, Dst->pVkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-                                                 &copy);
+    const uint32_t blockWidth    = Utils::FormatUtil_WidthOfBlock(fmt);
+    const uint32_t blockHeight   = Utils::FormatUtil_HeightOfBlock(fmt);
+    const uint32_t blockBytes    = Utils::FormatUtil_BitSizeOfBlock(fmt) / 8;
+
+    VkBufferImageCopy stackCopies[16];
+    std::vector<VkBufferImageCopy> heapCopies;
+    VkBufferImageCopy* pCopies = stackCopies;
+    if (desc->regions_count > 16)
+    {
+        heapCopies.resize(desc->regions_count);
+        pCopies = heapCopies.data();
+    }
+    for (uint32_t i = 0; i < desc->regions_count; i++)
+    {
+        const GPUBufferToTextureRegion& region = desc->regions[i];
+        assert((!region.row_pitch || blockBytes) && "row pitch needs the block size of the format!");
+        VkBufferImageCopy& copy              = pCopies[i];
+        copy.bufferOffset                    = region.src_offset;
+        // Vulkan measures the buffer layout in texels, 0 means tightly packed
+        copy.bufferRowLength                 = region.row_pitch ? region.row_pitch / blockBytes * blockWidth : 0;
+        copy.bufferImageHeight               = region.rows_per_image * blockHeight;
+        // an explicit aspect selects the depth or stencil plane, 0 keeps the aspects of the texture
+        copy.imageSubresource.aspectMask     = region.dst_subresource.aspects ? (VkImageAspectFlags)region.dst_subresource.aspects : (VkImageAspectFlags)desc->dst->aspectMask;
+        copy.imageSubresource.mipLevel       = region.dst_subresource.mip_level;
+        copy.imageSubresource.baseArrayLayer = region.dst_subresource.base_array_layer;
+        copy.imageSubresource.layerCount     = region.dst_subresource.layer_count;
+        copy.imageOffset                     = { region.dst_offset.x, region.dst_offset.y, region.dst_offset.z };
+        copy.imageExtent                     = VulkanUtil_RegionExtent(desc->dst, region.dst_subresource.mip_level, region.dst_offset, region.extent);
     }
+    D->mVkDeviceTable.vkCmdCopyBufferToImage(Cmd->pVkCmd,
+                                             Src->pVkBuffer, Dst->pVkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                             desc->regions_count, pCopies);
 }
 
-void GPUCmdTransferBufferToBuffer_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToBufferTransfer* desc)
+void GPUCmdTransferBufferToBufferRegions_Vulkan(GPUCommandBufferID cmd, const struct GPUBufferToBufferRegions* desc)
 {
     GPUCommandBuffer_Vulkan* Cmd = (GPUCommandBuffer_Vulkan*)cmd;
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)cmd->device;
     GPUBuffer_Vulkan* Src        = (GPUBuffer_Vulkan*)desc->src;
     GPUBuffer_Vulkan* Dst        = (GPUBuffer_Vulkan*)desc->dst;
-    VkBufferCopy copy{};
-    copy.srcOffset = desc->src_offset;
-    copy.dstOffset = desc->dst_offset;
-    copy.size      = desc->size;
-    D->mVkDeviceTable.vkCmdCopyBuffer(Cmd->pVkCmd, Src->pVkBuffer, Dst->pVkBuffer, 1, &copy);
+    // same layout as VkBufferCopy
+    static_assert(sizeof(GPUBufferToBufferRegion) == sizeof(VkBufferCopy));
+    static_assert(offsetof(GPUBufferToBufferRegion, src_offset) == offsetof(VkBufferCopy, srcOffset));
+    static_assert(offsetof(GPUBufferToBufferRegion, dst_offset) == offsetof(VkBufferCopy, dstOffset));
+    static_assert(offsetof(GPUBufferToBufferRegion, size) == offsetof(VkBufferCopy, size));
+    D->mVkDeviceTable.vkCmdCopyBuffer(Cmd->pVkCmd, Src->pVkBuffer, Dst->pVkBuffer, desc->regions_count, (const VkBufferCopy*)desc->regions);
 }
 
- void GPUCmdTransferTextureToTexture_Vulkan(GPUCommandBufferID cmd, const struct GPUTextureToTextureTransfer* desc)
- {
+void GPUCmdTransferTextureToTextureRegions_Vulkan(GPUCommandBufferID cmd, const struct GPUTextureToTextureRegions* desc)
+{
     GPUCommandBuffer_Vulkan* Cmd = (GPUCommandBuffer_Vulkan*)cmd;
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)cmd->device;
     GPUTexture_Vulkan* Src       = (GPUTexture_Vulkan*)desc->src;
     GPUTexture_Vulkan* Dst       = (GPUTexture_Vulkan*)desc->dst;
 
-    const bool isSinglePlane = true;
-    if (isSinglePlane)
-    {
-        const uint32_t width  = gpu_max(1, desc->dst->width >> desc->dst_subresource.mip_level);
-        const uint32_t height = gpu_max(1, desc->dst->height >> desc->dst_subresource.mip_level);
-        const uint32_t depth  = gpu_max(1, desc->dst->depth >> desc->dst_subresource.mip_level);
-        VkImageCopy copy;
-        copy.srcSubresource.aspectMask     = (VkImageAspectFlags)desc->src_subresource.aspects;
-        copy.srcSubresource.mipLevel       = desc->src_subresource.mip_level;
-        copy.srcSubresource.baseArrayLayer = desc->src_subresource.base_array_layer;
-        copy.srcSubresource.layerCount     = desc->src_subresource.layer_count;
-        copy.srcOffset                     = { 0, 0, 0 };
-        copy.dstSubresource.aspectMask     = (VkImageAspectFlags)desc->dst_subresource.aspects;
-        copy.dstSubresource.mipLevel       = desc->dst_subresource.mip_level;
-        copy.dstSubresource.baseArrayLayer = desc->dst_subresource.base_array_layer;
-        copy.dstSubresource.layerCount     = desc->dst_subresource.layer_count;
-        copy.dstOffset                     = { 0, 0, 0 };
-        copy.extent                        = { width, height, depth };
-        D->mVkDeviceTable.vkCmdCopyImage(Cmd->pVkCmd, Src->pVkImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, Dst->pVkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
-    }
- }
+    VkImageCopy stackCopies[16];
+    std::vector<VkImageCopy> heapCopies;
+    VkImageCopy* pCopies = stackCopies;
+    if (desc->regions_count > 16)
+    {
+        heapCopies.resize(desc->regions_count);
+        pCopies = heapCopies.data();
+    }
+    for (uint32_t i = 0; i < desc->regions_count; i++)
+    {
+        const GPUTextureToTextureRegion& region = desc->regions[i];
+        VkImageCopy& copy                  = pCopies[i];
+        copy.srcSubresource.aspectMask     = (VkImageAspectFlags)region.src_subresource.aspects;
+        copy.srcSubresource.mipLevel       = region.src_subresource.mip_level;
+        copy.srcSubresource.baseArrayLayer = region.src_subresource.base_array_layer;
+        copy.srcSubresource.layerCount     = region.src_subresource.layer_count;
+        copy.srcOffset                     = { region.src_offset.x, region.src_offset.y, region.src_offset.z };
+        copy.dstSubresource.aspectMask     = (VkImageAspectFlags)region.dst_subresource.aspects;
+        copy.dstSubresource.mipLevel       = region.dst_subresource.mip_level;
+        copy.dstSubresource.baseArrayLayer = region.dst_subresource.base_array_layer;
+        copy.dstSubresource.layerCount     = region.dst_subresource.layer_count;
+        copy.dstOffset                     = { region.dst_offset.x, region.dst_offset.y, region.dst_offset.z };
+        copy.extent                        = VulkanUtil_RegionExtent(desc->dst, region.dst_subresource.mip_level, region.dst_offset, region.extent);
+    }
+    D->mVkDeviceTable.vkCmdCopyImage(Cmd->pVkCmd,
+                                     Src->pVkImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                     Dst->pVkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                     desc->regions_count, pCopies);
+}
 
 GPUFenceID GPUCreateFence_Vulkan(GPUDeviceID device)
 {
@@ -2709,12 +4137,68 @@ void GPUFreeSemaphore_Vulkan(GPUSemaphoreID semaphore)
     GPU_SAFE_FREE(S);
 }
 
-GPURenderPassEncoderID GPUCmdBeginRenderPass_Vulkan(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc)
+GPUSemaphoreID GPUCreateTimelineSemaphore_Vulkan(GPUDeviceID device, uint64_t initialValue)
 {
-    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)cmd->device;
-    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)cmd;
+    GPUDevice_Vulkan* D    = (GPUDevice_Vulkan*)device;
+    GPUSemaphore_Vulkan* s = (GPUSemaphore_Vulkan*)calloc(1, sizeof(GPUSemaphore_Vulkan));
 
-    uint32_t Width, Height;
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue  = initialValue;
+    VkSemaphoreCreateInfo info{};
+    info.sType  = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    info.pNext  = &typeInfo;
+    VkResult rs = D->mVkDeviceTable.vkCreateSemaphore(D->pDevice, &info, GLOBAL_VkAllocationCallbacks, &s->pVkSemaphore);
+    assert(rs == VK_SUCCESS);
+
+    return &s->super;
+}
+
+void GPUSignalSemaphore_Vulkan(GPUSemaphoreID semaphore, uint64_t value)
+{
+    GPUDevice_Vulkan* D    = (GPUDevice_Vulkan*)semaphore->device;
+    GPUSemaphore_Vulkan* S = (GPUSemaphore_Vulkan*)semaphore;
+    VkSemaphoreSignalInfo info{};
+    info.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+    info.semaphore = S->pVkSemaphore;
+    info.value     = value;
+    VkResult rs    = D->mVkDeviceTable.vkSignalSemaphore(D->pDevice, &info);
+    assert(rs == VK_SUCCESS);
+}
+
+bool GPUWaitSemaphores_Vulkan(const GPUSemaphoreID* semaphores, const uint64_t* values, uint32_t count, uint64_t timeout)
+{
+    GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)semaphores[0]->device;
+    DECLEAR_ZERO_VAL(VkSemaphore, vkSemaphores, count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        assert(semaphores[i]->timeline);
+        vkSemaphores[i] = ((GPUSemaphore_Vulkan*)semaphores[i])->pVkSemaphore;
+    }
+    VkSemaphoreWaitInfo info{};
+    info.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    info.semaphoreCount = count;
+    info.pSemaphores    = vkSemaphores;
+    info.pValues        = values;
+    VkResult rs         = D->mVkDeviceTable.vkWaitSemaphores(D->pDevice, &info, timeout);
+    assert(rs == VK_SUCCESS || rs == VK_TIMEOUT);
+    return rs == VK_SUCCESS;
+}
+
+uint64_t GPUQuerySemaphoreValue_Vulkan(GPUSemaphoreID semaphore)
+{
+    GPUDevice_Vulkan* D    = (GPUDevice_Vulkan*)semaphore->device;
+    GPUSemaphore_Vulkan* S = (GPUSemaphore_Vulkan*)semaphore;
+    uint64_t value         = 0;
+    VkResult rs            = D->mVkDeviceTable.vkGetSemaphoreCounterValue(D->pDevice, S->pVkSemaphore, &value);
+    assert(rs == VK_SUCCESS);
+    return value;
+}
+
+// bundles only need a compatible render pass, so they look it up the same way the passes do
+static VkRenderPass VulkanUtil_FindRenderPass(GPUDevice_Vulkan* D, const struct GPURenderPassDescriptor* desc)
+{
     VkRenderPass render_pass = VK_NULL_HANDLE;
     VulkanRenderPassDescriptor r_desc{};
     r_desc.attachmentCount = desc->render_target_count;
@@ -2723,8 +4207,6 @@ GPURenderPassEncoderID GPUCmdBeginRenderPass_Vulkan(GPUCommandBufferID cmd, cons
         r_desc.pColorFormat[i]   = desc->color_attachments[i].view->desc.format;
         r_desc.pColorLoadOps[i]  = desc->color_attachments[i].load_action;
         r_desc.pColorStoreOps[i] = desc->color_attachments[i].store_action;
-        Width                    = desc->color_attachments[i].view->desc.pTexture->width;
-        Height                   = desc->color_attachments[i].view->desc.pTexture->height;
     }
     r_desc.depthFormat    = desc->depth_stencil ? (desc->depth_stencil->view ? desc->depth_stencil->view->desc.format : GPU_FORMAT_UNDEFINED) : GPU_FORMAT_UNDEFINED;
     r_desc.sampleCount    = desc->sample_count;
@@ -2733,6 +4215,21 @@ GPURenderPassEncoderID GPUCmdBeginRenderPass_Vulkan(GPUCommandBufferID cmd, cons
     r_desc.stencilLoadOp  = desc->depth_stencil ? desc->depth_stencil->stencil_load_action : GPU_LOAD_ACTION_DONTCARE;
     r_desc.stencilStoreOp = desc->depth_stencil ? desc->depth_stencil->stencil_store_action : GPU_STORE_ACTION_STORE;
     FindOrCreateRenderPass(D, &r_desc, &render_pass);
+    return render_pass;
+}
+
+GPURenderPassEncoderID GPUCmdBeginRenderPass_Vulkan(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)cmd->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)cmd;
+
+    uint32_t Width, Height;
+    for (uint32_t i = 0; i < desc->render_target_count; i++)
+    {
+        Width  = desc->color_attachments[i].view->desc.pTexture->width;
+        Height = desc->color_attachments[i].view->desc.pTexture->height;
+    }
+    VkRenderPass render_pass = VulkanUtil_FindRenderPass(D, desc);
 
     VkFramebuffer framebuffer = VK_NULL_HANDLE;
     VulkanFramebufferDesriptor fb_desc{};
@@ -2793,8 +4290,10 @@ GPURenderPassEncoderID GPUCmdBeginRenderPass_Vulkan(GPUCommandBufferID cmd, cons
     beginInfo.clearValueCount = idx;
     beginInfo.pClearValues    = pClearValues;
 
-    D->mVkDeviceTable.vkCmdBeginRenderPass(CMD->pVkCmd, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
-    CMD->pPass = render_pass;
+    D->mVkDeviceTable.vkCmdBeginRenderPass(CMD->pVkCmd, &beginInfo, desc->bundled ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+    CMD->pPass   = render_pass;
+    CMD->bundled = desc->bundled;
+    VulkanUtil_EnterBindPoint(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
     return (GPURenderPassEncoderID)cmd;
 }
 
@@ -2803,9 +4302,168 @@ void GPUCmdEndRenderPass_Vulkan(GPUCommandBufferID cmd, GPURenderPassEncoderID e
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)cmd->device;
     GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)cmd;
     D->mVkDeviceTable.vkCmdEndRenderPass(CMD->pVkCmd);
+    CMD->pPass   = VK_NULL_HANDLE;
+    CMD->bundled = false;
+}
+
+GPURenderPassEncoderID GPUCmdBeginRenderBundle_Vulkan(GPUCommandBufferID cmd, const struct GPURenderPassDescriptor* desc)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)cmd->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)cmd;
+    assert(CMD->secondary && "render bundles record into secondary command buffers!");
+
+    // no framebuffer, the bundle runs inside any pass with compatible attachments
+    VkCommandBufferInheritanceInfo inheritance{};
+    inheritance.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.renderPass  = VulkanUtil_FindRenderPass(D, desc);
+    inheritance.subpass     = 0;
+    inheritance.framebuffer = VK_NULL_HANDLE;
+
+    VkCommandBufferBeginInfo info{};
+    info.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    info.flags            = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+    info.pInheritanceInfo = &inheritance;
+    VkResult rs           = D->mVkDeviceTable.vkBeginCommandBuffer(CMD->pVkCmd, &info);
+    assert(rs == VK_SUCCESS);
+
+    memset(&CMD->bound, 0, sizeof(CMD->bound));
+    CMD->pPass = inheritance.renderPass;
+    VulkanUtil_EnterBindPoint(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    return (GPURenderPassEncoderID)cmd;
+}
+
+void GPUCmdEndRenderBundle_Vulkan(GPUCommandBufferID cmd, GPURenderPassEncoderID encoder)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)cmd->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)cmd;
+    VkResult rs                  = D->mVkDeviceTable.vkEndCommandBuffer(CMD->pVkCmd);
+    assert(rs == VK_SUCCESS);
     CMD->pPass = VK_NULL_HANDLE;
 }
 
+void GPURenderEncoderExecuteBundles_Vulkan(GPURenderPassEncoderID encoder, const GPUCommandBufferID* bundles, uint32_t count)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    assert(CMD->bundled && "bundles only execute in passes begun with bundled!");
+    if (count == 0) return;
+
+    DECLEAR_ZERO_VAL(VkCommandBuffer, cmds, count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const GPUCommandBuffer_Vulkan* B = (const GPUCommandBuffer_Vulkan*)bundles[i];
+        assert(B->secondary);
+        cmds[i] = B->pVkCmd;
+    }
+    D->mVkDeviceTable.vkCmdExecuteCommands(CMD->pVkCmd, count, cmds);
+    // the state the bundles leave behind is undefined in the primary
+    memset(&CMD->bound, 0, sizeof(CMD->bound));
+    VulkanUtil_EnterBindPoint(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
+}
+
+// sets [0, n) bound against one layout stay valid under another if both agree on them
+static uint32_t VulkanUtil_CompatibleSetCount(const GPURootSignature_Vulkan* a, const GPURootSignature_Vulkan* b)
+{
+    if (a == b) return a ? a->setLayoutsCount : 0;
+    // signatures sharing a pool signature have the same pipeline layout
+    if (a && b && a->super.pool_sig && a->super.pool_sig == b->super.pool_sig) return a->setLayoutsCount;
+    if (!a || !b || a->super.push_constant_count != b->super.push_constant_count) return 0;
+    if (a->super.push_constant_count && memcmp(a->pPushConstantRanges, b->pPushConstantRanges, a->super.push_constant_count * sizeof(VkPushConstantRange))) return 0;
+    const uint32_t count = a->setLayoutsCount < b->setLayoutsCount ? a->setLayoutsCount : b->setLayoutsCount;
+    uint32_t n           = 0;
+    while (n < count && a->pSetLayouts[n].hash == b->pSetLayouts[n].hash) n++;
+    return n;
+}
+
+static void VulkanUtil_SwitchRootSignature(GPUCommandBuffer_Vulkan* Cmd, const GPURootSignature_Vulkan* RS)
+{
+    GPUVkBoundState& bound = Cmd->bound;
+    if (bound.pRootSignature == RS) return;
+    const uint32_t keep = VulkanUtil_CompatibleSetCount(bound.pRootSignature, RS);
+    for (uint32_t i = keep; i < GPU_VK_MAX_BOUND_SETS; i++)
+    {
+        bound.pSets[i] = VK_NULL_HANDLE;
+    }
+    bound.boundSets     &= (1u << keep) - 1;
+    bound.dirtySets     &= (1u << keep) - 1;
+    bound.pRootSignature = RS;
+}
+
+// issues the pending descriptor sets before a draw/dispatch, one vkCmdBindDescriptorSets per contiguous range
+static void VulkanUtil_FlushDescriptorSets(GPUCommandBuffer_Vulkan* Cmd, VkPipelineBindPoint bindPoint)
+{
+    const GPUDevice_Vulkan* D         = (GPUDevice_Vulkan*)Cmd->super.device;
+    GPUVkBoundState& bound            = Cmd->bound;
+    const GPURootSignature_Vulkan* RS = bound.pRootSignature;
+    if (!RS) return;
+
+    // VK Must Fill All DescriptorSetLayouts at first dispach/draw.
+    // Example: If shader uses only set 2, we still have to bind empty sets for set=0 and set=1
+    for (uint32_t i = 0; i < RS->setLayoutsCount; i++)
+    {
+        if (!(bound.boundSets & (1u << i)) && RS->pSetLayouts[i].pLayout != VK_NULL_HANDLE && !(RS->super.transient_set_mask & (1u << i)))
+        {
+            bound.pSets[i]      = RS->pSetLayouts[i].pEmptyDescSet;
+            bound.setOffsets[i] = RS->pSetLayouts[i].emptyOffset;
+            bound.boundSets    |= 1u << i;
+            bound.dirtySets    |= 1u << i;
+            memset(bound.dynamicOffsets[i], 0, sizeof(bound.dynamicOffsets[i]));
+        }
+    }
+
+    // descriptor buffer mode, the heap is bound once and sets are offsets into it
+    if (D->pDescriptorHeap && bound.dirtySets && !bound.descriptorHeapBound)
+    {
+        VkDescriptorBufferBindingInfoEXT binding{};
+        binding.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+        binding.address = D->pDescriptorHeap->address;
+        binding.usage   = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
+        D->mVkDeviceTable.vkCmdBindDescriptorBuffersEXT(Cmd->pVkCmd, 1, &binding);
+        bound.descriptorHeapBound = 1;
+    }
+
+    uint32_t first = 0;
+    while (bound.dirtySets >> first)
+    {
+        while (!(bound.dirtySets & (1u << first))) first++;
+        uint32_t last = first;
+        while (bound.dirtySets & (1u << last)) last++;
+        if (D->pDescriptorHeap)
+        {
+            const uint32_t bufferIndices[GPU_VK_MAX_BOUND_SETS] = {};
+            D->mVkDeviceTable.vkCmdSetDescriptorBufferOffsetsEXT(Cmd->pVkCmd,
+                                                                 bindPoint, RS->pPipelineLayout,
+                                                                 first, last - first, bufferIndices, &bound.setOffsets[first]);
+        }
+        else
+        {
+            uint32_t offsets[GPU_VK_MAX_BOUND_SETS * GPU_VK_MAX_DYNAMIC_OFFSETS];
+            uint32_t offsetCount = 0;
+            for (uint32_t i = first; i < last; i++)
+            {
+                const uint32_t count = RS->pSetLayouts[i].dynamicOffsetCount;
+                memcpy(offsets + offsetCount, bound.dynamicOffsets[i], count * sizeof(uint32_t));
+                offsetCount += count;
+            }
+            D->mVkDeviceTable.vkCmdBindDescriptorSets(Cmd->pVkCmd,
+                                                      bindPoint, RS->pPipelineLayout,
+                                                      first, last - first, &bound.pSets[first],
+                                                      offsetCount, offsets);
+        }
+        first = last;
+    }
+    bound.dirtySets = 0;
+}
+
+static void VulkanUtil_BindPipeline(GPUCommandBuffer_Vulkan* Cmd, VkPipeline pipeline, GPURootSignatureID rs, VkPipelineBindPoint bindPoint)
+{
+    const GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)Cmd->super.device;
+    if (Cmd->bound.pPipeline == pipeline) return;
+    Cmd->bound.pPipeline = pipeline;
+    VulkanUtil_SwitchRootSignature(Cmd, (const GPURootSignature_Vulkan*)rs);
+    D->mVkDeviceTable.vkCmdBindPipeline(Cmd->pVkCmd, bindPoint, pipeline);
+}
+
 void GPURenderEncoderSetViewport_Vulkan(GPURenderPassEncoderID encoder, float x, float y, float width, float height, float min_depth, float max_depth)
 {
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
@@ -2817,6 +4475,9 @@ void GPURenderEncoderSetViewport_Vulkan(GPURenderPassEncoderID encoder, float x,
     viewport.height   = height;
     viewport.minDepth = min_depth;
     viewport.maxDepth = max_depth;
+    if (CMD->bound.viewportValid && !memcmp(&CMD->bound.viewport, &viewport, sizeof(VkViewport))) return;
+    CMD->bound.viewport      = viewport;
+    CMD->bound.viewportValid = 1;
     D->mVkDeviceTable.vkCmdSetViewport(CMD->pVkCmd, 0, 1, &viewport);
 }
 
@@ -2827,28 +4488,155 @@ void GPURenderEncoderSetScissor_Vulkan(GPURenderPassEncoderID encoder, uint32_t
     VkRect2D scissor{};
     scissor.offset = { (int32_t)x, (int32_t)y };
     scissor.extent = { width, height };
+    if (CMD->bound.scissorValid && !memcmp(&CMD->bound.scissor, &scissor, sizeof(VkRect2D))) return;
+    CMD->bound.scissor      = scissor;
+    CMD->bound.scissorValid = 1;
     D->mVkDeviceTable.vkCmdSetScissor(CMD->pVkCmd, 0, 1, &scissor);
 }
 
+// emits the dynamic states that differ from the bound ones, everything on the first call of a pass
+static void VulkanUtil_ApplyDynamicState(GPUCommandBuffer_Vulkan* Cmd, const GPUVkDynamicState& state)
+{
+    const GPUDevice_Vulkan* D     = (GPUDevice_Vulkan*)Cmd->super.device;
+    const VolkDeviceTable& T      = D->mVkDeviceTable;
+    const VkCommandBuffer C       = Cmd->pVkCmd;
+    const GPUVkDynamicState& last = Cmd->bound.dynamicState;
+    const bool all                = !Cmd->bound.dynamicStateValid;
+    if (all || last.cullMode != state.cullMode) T.vkCmdSetCullModeEXT(C, state.cullMode);
+    if (all || last.frontFace != state.frontFace) T.vkCmdSetFrontFaceEXT(C, state.frontFace);
+    if (all || last.topology != state.topology) T.vkCmdSetPrimitiveTopologyEXT(C, state.topology);
+    if (all || last.depthTest != state.depthTest) T.vkCmdSetDepthTestEnableEXT(C, state.depthTest);
+    if (all || last.depthWrite != state.depthWrite) T.vkCmdSetDepthWriteEnableEXT(C, state.depthWrite);
+    if (all || last.depthCompareOp != state.depthCompareOp) T.vkCmdSetDepthCompareOpEXT(C, state.depthCompareOp);
+    if (all || last.stencilTest != state.stencilTest) T.vkCmdSetStencilTestEnableEXT(C, state.stencilTest);
+    if (all || memcmp(&last.front, &state.front, sizeof(VkStencilOpState)))
+    {
+        T.vkCmdSetStencilOpEXT(C, VK_STENCIL_FACE_FRONT_BIT, state.front.failOp, state.front.passOp, state.front.depthFailOp, state.front.compareOp);
+    }
+    if (all || memcmp(&last.back, &state.back, sizeof(VkStencilOpState)))
+    {
+        T.vkCmdSetStencilOpEXT(C, VK_STENCIL_FACE_BACK_BIT, state.back.failOp, state.back.passOp, state.back.depthFailOp, state.back.compareOp);
+    }
+    if (D->extendedDynamicState2)
+    {
+        if (all || last.depthBias != state.depthBias) T.vkCmdSetDepthBiasEnableEXT(C, state.depthBias);
+    }
+    if (D->extendedDynamicState3)
+    {
+        if (all || last.polygonMode != state.polygonMode) T.vkCmdSetPolygonModeEXT(C, state.polygonMode);
+        if (all || last.depthClamp != state.depthClamp) T.vkCmdSetDepthClampEnableEXT(C, state.depthClamp);
+    }
+    Cmd->bound.dynamicState      = state;
+    Cmd->bound.dynamicStateValid = 1;
+}
+
 void GPURenderEncoderBindPipeline_Vulkan(GPURenderPassEncoderID encoder, GPURenderPipelineID pipeline)
 {
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
     GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
     GPURenderPipeline_Vulkan* PP = (GPURenderPipeline_Vulkan*)pipeline;
-    D->mVkDeviceTable.vkCmdBindPipeline(CMD->pVkCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, PP->pPipeline);
+    VulkanUtil_BindPipeline(CMD, PP->pPipeline, pipeline->pRootSignature, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    if (D->extendedDynamicState) VulkanUtil_ApplyDynamicState(CMD, PP->dynamicState);
+}
+
+void GPURenderEncoderSetRasterizerState_Vulkan(GPURenderPassEncoderID encoder, const GPURasterizerStateDescriptor* state)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    assert(D->extendedDynamicState && "device was created without extended dynamic state!");
+    assert(CMD->bound.dynamicStateValid && "bind a pipeline before overriding its states!");
+    VkPipelineRasterizationStateCreateInfo rs{};
+    VulkanUtil_TranslateRasterizerState(state, &rs);
+    GPUVkDynamicState wanted = CMD->bound.dynamicState;
+    wanted.cullMode          = rs.cullMode;
+    wanted.frontFace         = rs.frontFace;
+    wanted.depthBias         = rs.depthBiasEnable;
+    wanted.polygonMode       = rs.polygonMode;
+    wanted.depthClamp        = rs.depthClampEnable;
+    assert((D->extendedDynamicState2 || wanted.depthBias == CMD->bound.dynamicState.depthBias) && "depth bias enable needs extended dynamic state 2!");
+    assert((D->extendedDynamicState3 || (wanted.polygonMode == CMD->bound.dynamicState.polygonMode && wanted.depthClamp == CMD->bound.dynamicState.depthClamp)) &&
+           "fill mode and depth clamp need extended dynamic state 3!");
+    VulkanUtil_ApplyDynamicState(CMD, wanted);
+}
+
+void GPURenderEncoderSetDepthState_Vulkan(GPURenderPassEncoderID encoder, const GPUDepthStateDesc* state)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    assert(D->extendedDynamicState && "device was created without extended dynamic state!");
+    assert(CMD->bound.dynamicStateValid && "bind a pipeline before overriding its states!");
+    VkPipelineDepthStencilStateCreateInfo dss{};
+    VulkanUtil_TranslateDepthState(state, &dss);
+    GPUVkDynamicState wanted = CMD->bound.dynamicState;
+    wanted.depthTest         = dss.depthTestEnable;
+    wanted.depthWrite        = dss.depthWriteEnable;
+    wanted.depthCompareOp    = dss.depthCompareOp;
+    wanted.stencilTest       = dss.stencilTestEnable;
+    wanted.front.failOp      = dss.front.failOp;
+    wanted.front.passOp      = dss.front.passOp;
+    wanted.front.depthFailOp = dss.front.depthFailOp;
+    wanted.front.compareOp   = dss.front.compareOp;
+    wanted.back.failOp       = dss.back.failOp;
+    wanted.back.passOp       = dss.back.passOp;
+    wanted.back.depthFailOp  = dss.back.depthFailOp;
+    wanted.back.compareOp    = dss.back.compareOp;
+    VulkanUtil_ApplyDynamicState(CMD, wanted);
+}
+
+// without dynamicPrimitiveTopologyUnrestricted the dynamic topology has to stay in the pipeline's class
+static uint32_t VulkanUtil_PrimitiveTopologyClass(VkPrimitiveTopology topology)
+{
+    switch (topology)
+    {
+        case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+            return 0;
+        case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+        case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+            return 1;
+        case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+void GPURenderEncoderSetPrimitiveTopology_Vulkan(GPURenderPassEncoderID encoder, EGPUPrimitiveTopology topology)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    assert(D->extendedDynamicState && "device was created without extended dynamic state!");
+    assert(CMD->bound.dynamicStateValid && "bind a pipeline before overriding its states!");
+    GPUVkDynamicState wanted = CMD->bound.dynamicState;
+    wanted.topology          = VulkanUtil_PrimitiveTopologyToVk(topology);
+    // every override stays in the class, so the bound topology has the pipeline's class
+    assert(VulkanUtil_PrimitiveTopologyClass(wanted.topology) == VulkanUtil_PrimitiveTopologyClass(CMD->bound.dynamicState.topology) &&
+           "primitive topology has to stay in the pipeline's topology class!");
+    VulkanUtil_ApplyDynamicState(CMD, wanted);
 }
 
 void GPURenderEncoderDraw_Vulkan(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t first_vertex)
 {
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
     GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
     D->mVkDeviceTable.vkCmdDraw(CMD->pVkCmd, vertex_count, 1, first_vertex, 0);
 }
 
+void GPURenderEncoderDrawInstanced_Vulkan(GPURenderPassEncoderID encoder, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    D->mVkDeviceTable.vkCmdDraw(CMD->pVkCmd, vertex_count, instance_count, first_vertex, first_instance);
+}
+
 void GPURenderEncoderDrawIndexed_Vulkan(GPURenderPassEncoderID encoder, uint32_t indexCount, uint32_t firstIndex, uint32_t vertexOffset)
 {
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
     GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
     D->mVkDeviceTable.vkCmdDrawIndexed(CMD->pVkCmd, indexCount, 1, firstIndex, vertexOffset, 0);
 }
 
@@ -2856,9 +4644,52 @@ void GPURenderEncoderDrawIndexedInstanced_Vulkan(GPURenderPassEncoderID encoder,
 {
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
     GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
     D->mVkDeviceTable.vkCmdDrawIndexed(CMD->pVkCmd, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
+void GPURenderEncoderDrawIndirect_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    GPUBuffer_Vulkan* B          = (GPUBuffer_Vulkan*)buffer;
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    D->mVkDeviceTable.vkCmdDrawIndirect(CMD->pVkCmd, B->pVkBuffer, offset, drawCount, stride);
+}
+
+void GPURenderEncoderDrawIndexedIndirect_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, uint32_t drawCount, uint32_t stride)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    GPUBuffer_Vulkan* B          = (GPUBuffer_Vulkan*)buffer;
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    D->mVkDeviceTable.vkCmdDrawIndexedIndirect(CMD->pVkCmd, B->pVkBuffer, offset, drawCount, stride);
+}
+
+void GPURenderEncoderDrawIndirectCount_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUAdapter_Vulkan* A         = (GPUAdapter_Vulkan*)encoder->device->pAdapter;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    GPUBuffer_Vulkan* B          = (GPUBuffer_Vulkan*)buffer;
+    GPUBuffer_Vulkan* CB         = (GPUBuffer_Vulkan*)countBuffer;
+    assert(A->adapterDetail.support_draw_indirect_count && "drawIndirectCount is not supported!");
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    D->mVkDeviceTable.vkCmdDrawIndirectCount(CMD->pVkCmd, B->pVkBuffer, offset, CB->pVkBuffer, countOffset, maxDrawCount, stride);
+}
+
+void GPURenderEncoderDrawIndexedIndirectCount_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint64_t offset, GPUBufferID countBuffer, uint64_t countOffset, uint32_t maxDrawCount, uint32_t stride)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUAdapter_Vulkan* A         = (GPUAdapter_Vulkan*)encoder->device->pAdapter;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    GPUBuffer_Vulkan* B          = (GPUBuffer_Vulkan*)buffer;
+    GPUBuffer_Vulkan* CB         = (GPUBuffer_Vulkan*)countBuffer;
+    assert(A->adapterDetail.support_draw_indirect_count && "drawIndirectCount is not supported!");
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_GRAPHICS);
+    D->mVkDeviceTable.vkCmdDrawIndexedIndirectCount(CMD->pVkCmd, B->pVkBuffer, offset, CB->pVkBuffer, countOffset, maxDrawCount, stride);
+}
+
 void GPURenderEncoderBindVertexBuffers_Vulkan(GPURenderPassEncoderID encoder, uint32_t buffer_count,
                                               const GPUBufferID* buffers, const uint32_t* strides, const uint32_t* offsets)
 {
@@ -2868,16 +4699,26 @@ void GPURenderEncoderBindVertexBuffers_Vulkan(GPURenderPassEncoderID encoder, ui
     const GPUBuffer_Vulkan** Buffers  = (const GPUBuffer_Vulkan**)buffers;
     const uint32_t final_buffer_count = buffer_count < A->physicalDeviceProperties.properties.limits.maxVertexInputBindings ? buffer_count : A->physicalDeviceProperties.properties.limits.maxVertexInputBindings;
 
-    VkBuffer vkBuffers[64]     = {};
-    VkDeviceSize vkOffsets[64] = {};
+    GPUVkBoundState& bound            = Cmd->bound;
+    assert(final_buffer_count <= GPU_VK_MAX_VERTEX_BINDINGS);
 
+    // only the bindings from the first changed one on are re-issued
+    uint32_t first = final_buffer_count;
     for (uint32_t i = 0; i < final_buffer_count; ++i)
     {
-        vkBuffers[i] = Buffers[i]->pVkBuffer;
-        vkOffsets[i] = (offsets ? offsets[i] : 0);
+        const VkBuffer vkBuffer     = Buffers[i]->pVkBuffer;
+        const VkDeviceSize vkOffset = (offsets ? offsets[i] : 0);
+        if (i >= bound.vertexBufferCount || bound.pVertexBuffers[i] != vkBuffer || bound.vertexOffsets[i] != vkOffset)
+        {
+            if (first == final_buffer_count) first = i;
+            bound.pVertexBuffers[i] = vkBuffer;
+            bound.vertexOffsets[i]  = vkOffset;
+        }
     }
+    if (final_buffer_count > bound.vertexBufferCount) bound.vertexBufferCount = final_buffer_count;
+    if (first == final_buffer_count) return;
 
-    D->mVkDeviceTable.vkCmdBindVertexBuffers(Cmd->pVkCmd, 0, final_buffer_count, vkBuffers, vkOffsets);
+    D->mVkDeviceTable.vkCmdBindVertexBuffers(Cmd->pVkCmd, first, final_buffer_count - first, &bound.pVertexBuffers[first], &bound.vertexOffsets[first]);
 }
 
 void GPURenderEncoderBindIndexBuffer_Vulkan(GPURenderPassEncoderID encoder, GPUBufferID buffer, uint32_t offset, uint64_t indexStride)
@@ -2889,38 +4730,131 @@ void GPURenderEncoderBindIndexBuffer_Vulkan(GPURenderPassEncoderID encoder, GPUB
     VkIndexType indexType = 
         (sizeof(uint16_t) == indexStride) ? VK_INDEX_TYPE_UINT16 : 
         ((sizeof(uint8_t) == indexStride) ? VK_INDEX_TYPE_UINT8_EXT : VK_INDEX_TYPE_UINT32);
+    GPUVkBoundState& bound = Cmd->bound;
+    if (bound.pIndexBuffer == B->pVkBuffer && bound.indexOffset == offset && bound.indexType == indexType) return;
+    bound.pIndexBuffer = B->pVkBuffer;
+    bound.indexOffset  = offset;
+    bound.indexType    = indexType;
     D->mVkDeviceTable.vkCmdBindIndexBuffer(Cmd->pVkCmd, B->pVkBuffer, offset, indexType);
 }
 
+static void VulkanUtil_BindDescriptorSet(GPUCommandBuffer_Vulkan* Cmd, GPUDescriptorSetID set, const uint32_t* dynamicOffsets, uint32_t dynamicOffsetCount)
+{
+    GPUDescriptorSet_Vulkan* S  = (GPUDescriptorSet_Vulkan*)set;
+    GPURootSignature_Vulkan* RS = (GPURootSignature_Vulkan*)S->super.root_signature;
+    GPUVkBoundState& bound      = Cmd->bound;
+    const uint32_t index        = S->super.index;
+    assert(index < GPU_VK_MAX_BOUND_SETS);
+    assert(dynamicOffsetCount <= RS->pSetLayouts[index].dynamicOffsetCount);
+    const VkPhysicalDeviceLimits& limits = ((const GPUAdapter_Vulkan*)Cmd->super.device->pAdapter)->physicalDeviceProperties.properties.limits;
+    for (uint32_t i = 0; i < dynamicOffsetCount; i++)
+    {
+        assert(dynamicOffsets[i] % ((RS->pSetLayouts[index].storageDynamicOffsetMask >> i) & 1 ? limits.minStorageBufferOffsetAlignment :
+                                                                                                 limits.minUniformBufferOffsetAlignment) == 0 &&
+               "dynamic offset is not aligned to the buffer offset alignment!");
+    }
+
+    VulkanUtil_SwitchRootSignature(Cmd, RS);
+    // offsets left out are bound as 0
+    uint32_t offsets[GPU_VK_MAX_DYNAMIC_OFFSETS] = {};
+    if (dynamicOffsetCount) memcpy(offsets, dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
+    if ((bound.boundSets & (1u << index)) && bound.pSets[index] == S->pSet && bound.setOffsets[index] == S->mHeapOffset &&
+        !memcmp(bound.dynamicOffsets[index], offsets, sizeof(offsets))) return;
+    bound.pSets[index]      = S->pSet;
+    bound.setOffsets[index] = S->mHeapOffset;
+    bound.boundSets        |= 1u << index;
+    memcpy(bound.dynamicOffsets[index], offsets, sizeof(offsets));
+    bound.dirtySets |= 1u << index;
+}
+
 void GPURenderEncoderBindDescriptorSet_Vulkan(GPURenderPassEncoderID encoder, GPUDescriptorSetID set)
 {
-    GPUCommandBuffer_Vulkan* Cmd = (GPUCommandBuffer_Vulkan*)encoder;
-    const GPUDevice_Vulkan* D    = (GPUDevice_Vulkan*)Cmd->super.device;
-    GPUDescriptorSet_Vulkan* S   = (GPUDescriptorSet_Vulkan*)set;
-    GPURootSignature_Vulkan* RS  = (GPURootSignature_Vulkan*)S->super.root_signature;
+    VulkanUtil_BindDescriptorSet((GPUCommandBuffer_Vulkan*)encoder, set, NULL, 0);
+}
 
-    // VK Must Fill All DescriptorSetLayouts at first dispach/draw.
-    // Example: If shader uses only set 2, we still have to bind empty sets for set=0 and set=1
-    if (Cmd->pLayout != RS->pPipelineLayout)
+void GPURenderEncoderBindDescriptorSetWithOffsets_Vulkan(GPURenderPassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count)
+{
+    VulkanUtil_BindDescriptorSet((GPUCommandBuffer_Vulkan*)encoder, set, dynamic_offsets, dynamic_offset_count);
+}
+
+static void VulkanUtil_PushConstants(GPUCommandBuffer_Vulkan* Cmd, GPURootSignatureID rs, const char8_t* name, const void* data)
+{
+    const GPUDevice_Vulkan* D   = (GPUDevice_Vulkan*)Cmd->super.device;
+    GPURootSignature_Vulkan* RS = (GPURootSignature_Vulkan*)rs;
+    const uint64_t name_hash    = GPUNameHash((const char*)name);
+    for (uint32_t i = 0; i < rs->push_constant_count; i++)
     {
-        Cmd->pLayout = RS->pPipelineLayout;
-        for (uint32_t i = 0; i < RS->setLayoutsCount; i++)
+        const GPUShaderResource& root_const = rs->push_constants[i];
+        if (root_const.name_hash != name_hash) continue;
+        // every stage whose range overlaps the written bytes has to be named
+        VkShaderStageFlags stages = 0;
+        for (uint32_t j = 0; j < rs->push_constant_count; j++)
         {
-            if (RS->pSetLayouts[i].pEmptyDescSet != VK_NULL_HANDLE &&
-                S->super.index != i)
-            {
-                D->mVkDeviceTable.vkCmdBindDescriptorSets(Cmd->pVkCmd,
-                                                          VK_PIPELINE_BIND_POINT_GRAPHICS, RS->pPipelineLayout, i,
-                                                          1, &RS->pSetLayouts[i].pEmptyDescSet, 0, NULL);
-            }
+            const VkPushConstantRange& range = RS->pPushConstantRanges[j];
+            if (range.offset < root_const.offset + root_const.size && root_const.offset < range.offset + range.size)
+                stages |= range.stageFlags;
         }
+        D->mVkDeviceTable.vkCmdPushConstants(Cmd->pVkCmd, RS->pPipelineLayout, stages, root_const.offset, root_const.size, data);
+        return;
     }
+    assert(0 && "push constant not found in root signature!");
+}
+
+void GPURenderEncoderPushConstants_Vulkan(GPURenderPassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data)
+{
+    VulkanUtil_PushConstants((GPUCommandBuffer_Vulkan*)encoder, rs, name, data);
+}
+
+GPUComputePassEncoderID GPUCmdBeginComputePass_Vulkan(GPUCommandBufferID cmd, const struct GPUComputePassDescriptor* desc)
+{
+    // compute has no pass object in vulkan, the encoder is the command buffer
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)cmd;
+    VulkanUtil_EnterBindPoint(CMD, VK_PIPELINE_BIND_POINT_COMPUTE);
+    return (GPUComputePassEncoderID)cmd;
+}
+
+void GPUCmdEndComputePass_Vulkan(GPUCommandBufferID cmd, GPUComputePassEncoderID encoder)
+{
+    // nothing to close, the bindings stay valid for the next compute pass
+}
+
+void GPUComputeEncoderBindPipeline_Vulkan(GPUComputePassEncoderID encoder, GPUComputePipelineID pipeline)
+{
+    GPUCommandBuffer_Vulkan* CMD  = (GPUCommandBuffer_Vulkan*)encoder;
+    GPUComputePipeline_Vulkan* PP = (GPUComputePipeline_Vulkan*)pipeline;
+    VulkanUtil_BindPipeline(CMD, PP->pPipeline, pipeline->pRootSignature, VK_PIPELINE_BIND_POINT_COMPUTE);
+}
+
+void GPUComputeEncoderBindDescriptorSet_Vulkan(GPUComputePassEncoderID encoder, GPUDescriptorSetID set)
+{
+    VulkanUtil_BindDescriptorSet((GPUCommandBuffer_Vulkan*)encoder, set, NULL, 0);
+}
+
+void GPUComputeEncoderBindDescriptorSetWithOffsets_Vulkan(GPUComputePassEncoderID encoder, GPUDescriptorSetID set, const uint32_t* dynamic_offsets, uint32_t dynamic_offset_count)
+{
+    VulkanUtil_BindDescriptorSet((GPUCommandBuffer_Vulkan*)encoder, set, dynamic_offsets, dynamic_offset_count);
+}
+
+void GPUComputeEncoderPushConstants_Vulkan(GPUComputePassEncoderID encoder, GPURootSignatureID rs, const char8_t* name, const void* data)
+{
+    VulkanUtil_PushConstants((GPUCommandBuffer_Vulkan*)encoder, rs, name, data);
+}
+
+void GPUComputeEncoderDispatch_Vulkan(GPUComputePassEncoderID encoder, uint32_t x, uint32_t y, uint32_t z)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_COMPUTE);
+    D->mVkDeviceTable.vkCmdDispatch(CMD->pVkCmd, x, y, z);
+}
 
-    D->mVkDeviceTable.vkCmdBindDescriptorSets(Cmd->pVkCmd,
-                                              VK_PIPELINE_BIND_POINT_GRAPHICS, RS->pPipelineLayout,
-                                              S->super.index, 1, &S->pSet,
-                                              // TODO: Dynamic Offset
-                                              0, NULL);
+void GPUComputeEncoderDispatchIndirect_Vulkan(GPUComputePassEncoderID encoder, GPUBufferID buffer, uint64_t offset)
+{
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)encoder->device;
+    GPUCommandBuffer_Vulkan* CMD = (GPUCommandBuffer_Vulkan*)encoder;
+    GPUBuffer_Vulkan* B          = (GPUBuffer_Vulkan*)buffer;
+    VulkanUtil_FlushDescriptorSets(CMD, VK_PIPELINE_BIND_POINT_COMPUTE);
+    D->mVkDeviceTable.vkCmdDispatchIndirect(CMD->pVkCmd, B->pVkBuffer, offset);
 }
 
 GPUBufferID GPUCreateBuffer_Vulkan(GPUDeviceID device, const GPUBufferDescriptor* desc)
@@ -2939,6 +4873,14 @@ GPUBufferID GPUCreateBuffer_Vulkan(GPUDeviceID device, const GPUBufferDescriptor
     info.pQueueFamilyIndices   = nullptr;
     if (desc->memory_usage == GPU_MEM_USAGE_GPU_ONLY || desc->memory_usage == GPU_MEM_USAGE_GPU_TO_CPU)
         info.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    // descriptor buffers reference uniform/storage buffers by address
+    if (D->pDescriptorHeap && (info.usage & (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)))
+        info.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    if (desc->flags & GPU_BCF_DEVICE_ADDRESS_BIT)
+    {
+        assert(D->bufferDeviceAddress && "device was not created with enableBufferDeviceAddress!");
+        info.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
 
     VmaAllocationCreateInfo vma{};
     vma.usage                = (VmaMemoryUsage)desc->memory_usage;
@@ -2990,34 +4932,29 @@ GPUBufferID GPUCreateBuffer_Vulkan(GPUDeviceID device, const GPUBufferDescriptor
     GPUBuffer_Vulkan* buffer = (GPUBuffer_Vulkan*)_aligned_malloc(sizeof(GPUBuffer_Vulkan), _alignof(GPUBuffer_Vulkan));
     buffer->pVkBuffer                = pBuffer;
     buffer->pVkAllocation            = allocation;
+    buffer->mOffset                  = 0;
     buffer->super.cpu_mapped_address = alloc_info.pMappedData;
+    buffer->super.gpu_address        = 0;
     buffer->super.size               = desc->size;
     buffer->super.descriptors        = desc->descriptors;
     buffer->super.memory_usage       = desc->memory_usage;
+    if (info.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+    {
+        VkBufferDeviceAddressInfo address_info{};
+        address_info.sType        = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        address_info.buffer       = pBuffer;
+        buffer->super.gpu_address = D->mVkDeviceTable.vkGetBufferDeviceAddress(D->pDevice, &address_info);
+    }
 
     GPUQueue_Vulkan* Q = (GPUQueue_Vulkan*)desc->owner_queue;
     if (Q && pBuffer != VK_NULL_HANDLE && allocation != VK_NULL_HANDLE)
     {
-        GPUResetCommandPool(Q->pInnerCmdPool);
-        GPUCmdBegin(Q->pInnerCmdBuffer);
-        {
-            GPUBufferBarrier init_barrier{};
-            init_barrier.buffer = &buffer->super;
-            init_barrier.src_state = GPU_RESOURCE_STATE_UNDEFINED;
-            init_barrier.dst_state = desc->start_state;
-            GPUResourceBarrierDescriptor barrier_desc{};
-            barrier_desc.buffer_barriers = &init_barrier;
-            barrier_desc.buffer_barriers_count = 1;
-            GPUCmdResourceBarrier(Q->pInnerCmdBuffer, &barrier_desc);
-        }
-        GPUCmdEnd(Q->pInnerCmdBuffer);
-
-        GPUQueueSubmitDescriptor submit_desc{};
-        submit_desc.cmds = &Q->pInnerCmdBuffer;
-        submit_desc.cmds_count = 1;
-        submit_desc.signal_fence = Q->pInnerFence;
-        GPUSubmitQueue(desc->owner_queue, &submit_desc);
-        GPUWaitFences(&Q->pInnerFence, 1);
+        GPUBufferBarrier init_barrier{};
+        init_barrier.buffer    = &buffer->super;
+        init_barrier.src_state = GPU_RESOURCE_STATE_UNDEFINED;
+        init_barrier.dst_state = desc->start_state;
+        std::lock_guard<std::mutex> guard(D->pTransitionTable->lock);
+        D->pTransitionTable->buffers.emplace_back(desc->owner_queue, init_barrier);
     }
 
     return &buffer->super;
@@ -3028,6 +4965,11 @@ void GPUFreeBuffer_Vulkan(GPUBufferID buffer)
     GPUBuffer_Vulkan* B = (GPUBuffer_Vulkan*)buffer;
     GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)buffer->device;
     assert(B->pVkAllocation);
+    {
+        std::lock_guard<std::mutex> guard(D->pTransitionTable->lock);
+        auto& pending = D->pTransitionTable->buffers;
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [buffer](const auto& iter) { return iter.second.buffer == buffer; }), pending.end());
+    }
     vmaDestroyBuffer(D->pVmaAllocator, B->pVkBuffer, B->pVkAllocation);
     _aligned_free(B);
 }
@@ -3121,7 +5063,16 @@ GPUDescriptorSetID GPUCreateDescriptorSet_Vulkan(GPUDeviceID device, const struc
     memset(Set, 0, totalSize);
     char8_t* pMem = (char8_t*)(Set + 1);
     // Allocate Descriptor Set
-    VulkanUtil_ConsumeDescriptorSets(D->pDescriptorPool, &SetLayout->pLayout, &Set->pSet, 1);
+    if (D->pDescriptorHeap)
+    {
+        // a copy of the empty set, static samplers included
+        Set->mHeapOffset = VulkanUtil_AllocateDescriptors(D, SetLayout->descriptorSize, SetLayout->samplerDescriptors, &Set->pHeapAllocation);
+        memcpy(D->pDescriptorHeap->pMapped + Set->mHeapOffset, D->pDescriptorHeap->pMapped + SetLayout->emptyOffset, SetLayout->descriptorSize);
+    }
+    else
+    {
+        VulkanUtil_ConsumeDescriptorSets(D->pDescriptorPool, &SetLayout->pLayout, &Set->pSet, 1);
+    }
     // Fill Update Template Data
     Set->pUpdateData = (VkDescriptorUpdateData*)pMem;
     memset(Set->pUpdateData, 0, UpdateTemplateSize);
@@ -3132,27 +5083,17 @@ void GPUFreeDescriptorSet_Vulkan(GPUDescriptorSetID set)
 {
     GPUDescriptorSet_Vulkan* Set = (GPUDescriptorSet_Vulkan*)set;
     GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)set->root_signature->device;
-    VulkanUtil_ReturnDescriptorSets(D->pDescriptorPool, &Set->pSet, 1);
+    if (D->pDescriptorHeap)
+        VulkanUtil_FreeDescriptors(D, Set->pHeapAllocation, Set->mHeapOffset);
+    else
+        VulkanUtil_ReturnDescriptorSets(D->pDescriptorPool, &Set->pSet, 1);
     _aligned_free(Set);
 }
 
-void GPUUpdateDescriptorSet_Vulkan(GPUDescriptorSetID set, const GPUDescriptorData* datas, uint32_t count)
+// fills the template data of a set, and its descriptor buffer range when there is one
+static bool VulkanUtil_FillUpdateData(const GPUDevice_Vulkan* D, const GPUParameterTable* ParamTable, const SetLayout_Vulkan* SetLayout,
+                                      VkDescriptorUpdateData* pUpdateData, uint8_t* pHeapSet, const GPUDescriptorData* datas, uint32_t count)
 {
-    GPUDescriptorSet_Vulkan* Set = (GPUDescriptorSet_Vulkan*)set;
-    GPURootSignature_Vulkan* RS  = (GPURootSignature_Vulkan*)set->root_signature;
-    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)set->root_signature->device;
-    uint32_t table_index          = 0;
-    for (uint32_t i = 0; i < RS->super.table_count; i++)
-    {
-        if (RS->super.tables[i].set_index == set->index)
-        {
-            table_index = i;
-        }
-    }
-    SetLayout_Vulkan* SetLayout         = &RS->pSetLayouts[set->index];
-    const GPUParameterTable* ParamTable = &RS->super.tables[table_index];
-    VkDescriptorUpdateData* pUpdateData = Set->pUpdateData;
-    memset(pUpdateData, 0, count * sizeof(VkDescriptorUpdateData));
     bool dirty = false;
     for (uint32_t i = 0; i < count; i++)
     {
@@ -3185,6 +5126,7 @@ void GPUUpdateDescriptorSet_Vulkan(GPUDescriptorSetID set, const GPUDescriptorDa
         // Update Info
         const uint32_t arrayCount           = pParam->count > 1U ? pParam->count : 1U;
         const EGPUResourceType resourceType = (EGPUResourceType)ResData->type;
+        const VkDescriptorType vkType       = VulkanUtil_TranslateShaderResourceType(ResData);
         switch (resourceType)
         {
             case GPU_RESOURCE_TYPE_RW_TEXTURE:
@@ -3218,6 +5160,7 @@ void GPUUpdateDescriptorSet_Vulkan(GPUDescriptorSetID set, const GPUDescriptorDa
                     Data->mImageInfo.imageLayout = ResData->type == GPU_RESOURCE_TYPE_RW_TEXTURE ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
                     Data->mImageInfo.sampler     = VK_NULL_HANDLE;
                     dirty                        = true;
+                    if (pHeapSet) VulkanUtil_WriteDescriptor(D, pHeapSet + SetLayout->pBindingOffsets[ResData->binding] + arr * VulkanUtil_DescriptorStride(D, vkType), vkType, &Data->mImageInfo, NULL);
                 }
                 break;
             }
@@ -3230,6 +5173,7 @@ void GPUUpdateDescriptorSet_Vulkan(GPUDescriptorSetID set, const GPUDescriptorDa
                     VkDescriptorUpdateData* Data = &pUpdateData[ResData->binding + arr];
                     Data->mImageInfo.sampler     = Samplers[arr]->pSampler;
                     dirty                        = true;
+                    if (pHeapSet) VulkanUtil_WriteDescriptor(D, pHeapSet + SetLayout->pBindingOffsets[ResData->binding] + arr * VulkanUtil_DescriptorStride(D, vkType), vkType, &Data->mImageInfo, NULL);
                 }
                 break;
             }
@@ -3252,7 +5196,17 @@ void GPUUpdateDescriptorSet_Vulkan(GPUDescriptorSetID set, const GPUDescriptorDa
                         Data->mBufferInfo.offset = pParam->buffers_params.offsets[arr];
                         Data->mBufferInfo.range  = pParam->buffers_params.sizes[arr];
                     }
+                    // the dynamic offset moves the window, a whole-size range would run past the end
+                    assert((!ResData->dynamic_offset || pParam->buffers_params.sizes) && "dynamic buffers need an explicit range!");
                     dirty = true;
+                    if (pHeapSet)
+                    {
+                        VkDescriptorAddressInfoEXT address{};
+                        address.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+                        address.address = Buffers[arr]->super.gpu_address + Data->mBufferInfo.offset;
+                        address.range   = Data->mBufferInfo.range == VK_WHOLE_SIZE ? Buffers[arr]->super.size - Data->mBufferInfo.offset : Data->mBufferInfo.range;
+                        VulkanUtil_WriteDescriptor(D, pHeapSet + SetLayout->pBindingOffsets[ResData->binding] + arr * VulkanUtil_DescriptorStride(D, vkType), vkType, NULL, &address);
+                    }
                 }
                 break;
             }
@@ -3261,8 +5215,309 @@ void GPUUpdateDescriptorSet_Vulkan(GPUDescriptorSetID set, const GPUDescriptorDa
                 break;
         }
     }
-    if (dirty)
+    return dirty;
+}
+
+void GPUUpdateDescriptorSet_Vulkan(GPUDescriptorSetID set, const GPUDescriptorData* datas, uint32_t count)
+{
+    GPUDescriptorSet_Vulkan* Set = (GPUDescriptorSet_Vulkan*)set;
+    GPURootSignature_Vulkan* RS  = (GPURootSignature_Vulkan*)set->root_signature;
+    GPUDevice_Vulkan* D          = (GPUDevice_Vulkan*)set->root_signature->device;
+    uint32_t table_index          = 0;
+    for (uint32_t i = 0; i < RS->super.table_count; i++)
+    {
+        if (RS->super.tables[i].set_index == set->index)
+        {
+            table_index = i;
+        }
+    }
+    SetLayout_Vulkan* SetLayout         = &RS->pSetLayouts[set->index];
+    const GPUParameterTable* ParamTable = &RS->super.tables[table_index];
+    VkDescriptorUpdateData* pUpdateData = Set->pUpdateData;
+    memset(pUpdateData, 0, count * sizeof(VkDescriptorUpdateData));
+    // descriptor buffer mode writes straight into the mapped set
+    uint8_t* pHeapSet = D->pDescriptorHeap ? D->pDescriptorHeap->pMapped + Set->mHeapOffset : nullptr;
+    const bool dirty  = VulkanUtil_FillUpdateData(D, ParamTable, SetLayout, pUpdateData, pHeapSet, datas, count);
+    if (dirty && !pHeapSet)
     {
         D->mVkDeviceTable.vkUpdateDescriptorSetWithTemplateKHR(D->pDevice, Set->pSet, SetLayout->pUpdateTemplate, Set->pUpdateData);
     }
-}
\ No newline at end of file
+}
+
+// transient sets are recorded into the command buffer through their push template
+static void VulkanUtil_PushDescriptorSet(GPUCommandBuffer_Vulkan* Cmd, GPURootSignatureID rs, uint32_t setIndex, const GPUDescriptorData* datas, uint32_t count)
+{
+    const GPUDevice_Vulkan* D           = (GPUDevice_Vulkan*)Cmd->super.device;
+    GPURootSignature_Vulkan* RS         = (GPURootSignature_Vulkan*)rs;
+    const GPUParameterTable* ParamTable = nullptr;
+    for (uint32_t i = 0; i < RS->super.table_count; i++)
+    {
+        if (RS->super.tables[i].set_index == setIndex) ParamTable = &RS->super.tables[i];
+    }
+    assert(ParamTable && setIndex < GPU_VK_MAX_BOUND_SETS);
+    const SetLayout_Vulkan* SetLayout = &RS->pSetLayouts[setIndex];
+    // template entries sit at binding * stride
+    uint32_t dataCount = 0;
+    for (uint32_t i = 0; i < ParamTable->resources_count; i++)
+    {
+        const uint32_t end = ParamTable->resources[i].binding + ParamTable->resources[i].size;
+        if (end > dataCount) dataCount = end;
+    }
+    DECLEAR_ZERO_VAL(VkDescriptorUpdateData, pUpdateData, dataCount);
+    VulkanUtil_FillUpdateData(D, ParamTable, SetLayout, pUpdateData, nullptr, datas, count);
+
+    VulkanUtil_SwitchRootSignature(Cmd, RS);
+    D->mVkDeviceTable.vkCmdPushDescriptorSetWithTemplateKHR(Cmd->pVkCmd, SetLayout->pUpdateTemplate, RS->pPipelineLayout, setIndex, pUpdateData);
+    Cmd->bound.pSets[setIndex]  = VK_NULL_HANDLE;
+    Cmd->bound.boundSets       |= 1u << setIndex;
+    Cmd->bound.dirtySets       &= ~(1u << setIndex);
+}
+
+void GPURenderEncoderPushDescriptorSet_Vulkan(GPURenderPassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count)
+{
+    VulkanUtil_PushDescriptorSet((GPUCommandBuffer_Vulkan*)encoder, rs, set_index, datas, count);
+}
+
+void GPUComputeEncoderPushDescriptorSet_Vulkan(GPUComputePassEncoderID encoder, GPURootSignatureID rs, uint32_t set_index, const struct GPUDescriptorData* datas, uint32_t count)
+{
+    VulkanUtil_PushDescriptorSet((GPUCommandBuffer_Vulkan*)encoder, rs, set_index, datas, count);
+}
+// bindless heap
+#define GPU_VK_BINDLESS_DEFAULT_TEXTURES 16384
+#define GPU_VK_BINDLESS_DEFAULT_RW_TEXTURES 1024
+#define GPU_VK_BINDLESS_DEFAULT_BUFFERS 16384
+#define GPU_VK_BINDLESS_DEFAULT_SAMPLERS 256
+
+// per range slot allocator, a resource keeps its index for as long as it is referenced
+struct GPUVkBindlessSlots
+{
+    struct Range
+    {
+        std::unordered_map<const void*, uint32_t> indices;
+        std::vector<const void*> objects;
+        std::vector<uint32_t> refs;
+        std::vector<uint32_t> freeSlots;
+        uint32_t capacity = 0;
+    };
+    std::mutex lock;
+    Range ranges[GPU_BINDLESS_RANGE_COUNT];
+};
+
+static const VkDescriptorType gBindlessDescriptorTypes[GPU_BINDLESS_RANGE_COUNT] = {
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    VK_DESCRIPTOR_TYPE_SAMPLER
+};
+
+GPUBindlessHeapID GPUCreateBindlessHeap_Vulkan(GPUDeviceID device, const struct GPUBindlessHeapDescriptor* desc)
+{
+    const GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)device;
+    assert(D->bindless && "the device was not created with enableBindless!");
+    GPUBindlessHeap_Vulkan* H = (GPUBindlessHeap_Vulkan*)_aligned_malloc(sizeof(GPUBindlessHeap_Vulkan), _alignof(GPUBindlessHeap_Vulkan));
+    memset(H, 0, sizeof(GPUBindlessHeap_Vulkan));
+    H->pSlots = new GPUVkBindlessSlots();
+
+    // defaults shrink to what the device allows, requested counts have to fit
+    const VkPhysicalDeviceDescriptorIndexingProperties& props = ((const GPUAdapter_Vulkan*)device->pAdapter)->descriptorIndexingProperties;
+    const uint32_t limits[GPU_BINDLESS_RANGE_COUNT] = {
+        gpu_min(props.maxPerStageDescriptorUpdateAfterBindSampledImages, props.maxDescriptorSetUpdateAfterBindSampledImages),
+        gpu_min(props.maxPerStageDescriptorUpdateAfterBindStorageImages, props.maxDescriptorSetUpdateAfterBindStorageImages),
+        gpu_min(props.maxPerStageDescriptorUpdateAfterBindStorageBuffers, props.maxDescriptorSetUpdateAfterBindStorageBuffers),
+        gpu_min(props.maxPerStageDescriptorUpdateAfterBindSamplers, props.maxDescriptorSetUpdateAfterBindSamplers)
+    };
+    const uint32_t requested[GPU_BINDLESS_RANGE_COUNT] = { desc->texture_count, desc->rw_texture_count, desc->buffer_count, desc->sampler_count };
+    const uint32_t defaults[GPU_BINDLESS_RANGE_COUNT]  = {
+        GPU_VK_BINDLESS_DEFAULT_TEXTURES,
+        GPU_VK_BINDLESS_DEFAULT_RW_TEXTURES,
+        GPU_VK_BINDLESS_DEFAULT_BUFFERS,
+        GPU_VK_BINDLESS_DEFAULT_SAMPLERS
+    };
+    uint32_t counts[GPU_BINDLESS_RANGE_COUNT];
+    for (uint32_t i = 0; i < GPU_BINDLESS_RANGE_COUNT; i++)
+    {
+        assert(requested[i] <= limits[i] && "bindless range exceeds the update after bind limits!");
+        counts[i] = requested[i] ? requested[i] : gpu_min(defaults[i], limits[i]);
+    }
+    VkDescriptorSetLayoutBinding bindings[GPU_BINDLESS_RANGE_COUNT];
+    VkDescriptorBindingFlags binding_flags[GPU_BINDLESS_RANGE_COUNT];
+    VkDescriptorPoolSize pool_sizes[GPU_BINDLESS_RANGE_COUNT];
+    for (uint32_t i = 0; i < GPU_BINDLESS_RANGE_COUNT; i++)
+    {
+        H->pSlots->ranges[i].capacity  = counts[i];
+        bindings[i].binding            = i;
+        bindings[i].descriptorType     = gBindlessDescriptorTypes[i];
+        bindings[i].descriptorCount    = counts[i];
+        bindings[i].stageFlags         = VK_SHADER_STAGE_ALL;
+        bindings[i].pImmutableSamplers = NULL;
+        pool_sizes[i].type             = gBindlessDescriptorTypes[i];
+        pool_sizes[i].descriptorCount  = counts[i];
+        // slots are written while command buffers using other slots are in flight
+        binding_flags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                           VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                           VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    }
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flags_info = {
+        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .pNext         = NULL,
+        .bindingCount  = GPU_BINDLESS_RANGE_COUNT,
+        .pBindingFlags = binding_flags
+    };
+    VkDescriptorSetLayoutCreateInfo set_info = {
+        .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext        = &flags_info,
+        .flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        .bindingCount = GPU_BINDLESS_RANGE_COUNT,
+        .pBindings    = bindings
+    };
+    assert(D->mVkDeviceTable.vkCreateDescriptorSetLayout(D->pDevice, &set_info, GLOBAL_VkAllocationCallbacks, &H->pLayout) == VK_SUCCESS);
+    const size_t flags_seed = Hash64(binding_flags, sizeof(binding_flags), Hash64(&set_info.flags, sizeof(set_info.flags), DEFAULT_HASH_SEED));
+    H->hash                 = Hash64(bindings, sizeof(bindings), flags_seed);
+
+    VkDescriptorPoolCreateInfo pool_info = {
+        .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext         = NULL,
+        .flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .maxSets       = 1,
+        .poolSizeCount = GPU_BINDLESS_RANGE_COUNT,
+        .pPoolSizes    = pool_sizes
+    };
+    assert(D->mVkDeviceTable.vkCreateDescriptorPool(D->pDevice, &pool_info, GLOBAL_VkAllocationCallbacks, &H->pPool) == VK_SUCCESS);
+    VkDescriptorSetAllocateInfo alloc_info = {
+        .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext              = NULL,
+        .descriptorPool     = H->pPool,
+        .descriptorSetCount = 1,
+        .pSetLayouts        = &H->pLayout
+    };
+    assert(D->mVkDeviceTable.vkAllocateDescriptorSets(D->pDevice, &alloc_info, &H->pSet) == VK_SUCCESS);
+    return &H->super;
+}
+
+void GPUFreeBindlessHeap_Vulkan(GPUBindlessHeapID heap)
+{
+    GPUBindlessHeap_Vulkan* H = (GPUBindlessHeap_Vulkan*)heap;
+    const GPUDevice_Vulkan* D = (GPUDevice_Vulkan*)heap->device;
+    D->mVkDeviceTable.vkDestroyDescriptorPool(D->pDevice, H->pPool, GLOBAL_VkAllocationCallbacks);
+    D->mVkDeviceTable.vkDestroyDescriptorSetLayout(D->pDevice, H->pLayout, GLOBAL_VkAllocationCallbacks);
+    delete H->pSlots;
+    _aligned_free(H);
+}
+
+// returns the slot of the object, fresh is set when the descriptor still has to be written
+static uint32_t VulkanUtil_AcquireBindlessSlot(GPUVkBindlessSlots::Range& range, const void* object, bool* fresh)
+{
+    auto found = range.indices.find(object);
+    if (found != range.indices.end())
+    {
+        range.refs[found->second]++;
+        *fresh = false;
+        return found->second;
+    }
+    uint32_t index = (uint32_t)range.objects.size();
+    if (!range.freeSlots.empty())
+    {
+        index = range.freeSlots.back();
+        range.freeSlots.pop_back();
+    }
+    else
+    {
+        assert(index < range.capacity && "bindless heap range is full!");
+        range.objects.push_back(nullptr);
+        range.refs.push_back(0);
+    }
+    range.objects[index] = object;
+    range.refs[index]    = 1;
+    range.indices.emplace(object, index);
+    *fresh = true;
+    return index;
+}
+
+static void VulkanUtil_WriteBindlessSlot(const GPUBindlessHeap_Vulkan* H, EGPUBindlessRange range, uint32_t index, const VkDescriptorImageInfo* image, const VkDescriptorBufferInfo* buffer)
+{
+    const GPUDevice_Vulkan* D  = (GPUDevice_Vulkan*)H->super.device;
+    VkWriteDescriptorSet write = {
+        .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .pNext            = NULL,
+        .dstSet           = H->pSet,
+        .dstBinding       = (uint32_t)range,
+        .dstArrayElement  = index,
+        .descriptorCount  = 1,
+        .descriptorType   = gBindlessDescriptorTypes[range],
+        .pImageInfo       = image,
+        .pBufferInfo      = buffer,
+        .pTexelBufferView = NULL
+    };
+    D->mVkDeviceTable.vkUpdateDescriptorSets(D->pDevice, 1, &write, 0, NULL);
+}
+
+uint32_t GPUBindlessHeapAddTexture_Vulkan(GPUBindlessHeapID heap, GPUTextureViewID view, bool writable)
+{
+    GPUBindlessHeap_Vulkan* H         = (GPUBindlessHeap_Vulkan*)heap;
+    const GPUTextureView_Vulkan* View = (const GPUTextureView_Vulkan*)view;
+    const EGPUBindlessRange range     = writable ? GPU_BINDLESS_RANGE_RW_TEXTURE : GPU_BINDLESS_RANGE_TEXTURE;
+    std::lock_guard<std::mutex> guard(H->pSlots->lock);
+    bool fresh           = false;
+    const uint32_t index = VulkanUtil_AcquireBindlessSlot(H->pSlots->ranges[range], view, &fresh);
+    if (fresh)
+    {
+        VkDescriptorImageInfo info;
+        info.sampler     = VK_NULL_HANDLE;
+        info.imageView   = writable ? View->pVkUAVDescriptor : View->pVkSRVDescriptor;
+        info.imageLayout = writable ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        assert(info.imageView && "texture view was not created with the matching usage!");
+        VulkanUtil_WriteBindlessSlot(H, range, index, &info, NULL);
+    }
+    return index;
+}
+
+uint32_t GPUBindlessHeapAddBuffer_Vulkan(GPUBindlessHeapID heap, GPUBufferID buffer)
+{
+    GPUBindlessHeap_Vulkan* H = (GPUBindlessHeap_Vulkan*)heap;
+    const GPUBuffer_Vulkan* B = (const GPUBuffer_Vulkan*)buffer;
+    std::lock_guard<std::mutex> guard(H->pSlots->lock);
+    bool fresh           = false;
+    const uint32_t index = VulkanUtil_AcquireBindlessSlot(H->pSlots->ranges[GPU_BINDLESS_RANGE_BUFFER], buffer, &fresh);
+    if (fresh)
+    {
+        VkDescriptorBufferInfo info;
+        info.buffer = B->pVkBuffer;
+        info.offset = B->mOffset;
+        info.range  = VK_WHOLE_SIZE;
+        VulkanUtil_WriteBindlessSlot(H, GPU_BINDLESS_RANGE_BUFFER, index, NULL, &info);
+    }
+    return index;
+}
+
+uint32_t GPUBindlessHeapAddSampler_Vulkan(GPUBindlessHeapID heap, GPUSamplerID sampler)
+{
+    GPUBindlessHeap_Vulkan* H  = (GPUBindlessHeap_Vulkan*)heap;
+    const GPUSampler_Vulkan* S = (const GPUSampler_Vulkan*)sampler;
+    std::lock_guard<std::mutex> guard(H->pSlots->lock);
+    bool fresh           = false;
+    const uint32_t index = VulkanUtil_AcquireBindlessSlot(H->pSlots->ranges[GPU_BINDLESS_RANGE_SAMPLER], sampler, &fresh);
+    if (fresh)
+    {
+        VkDescriptorImageInfo info;
+        info.sampler     = S->pSampler;
+        info.imageView   = VK_NULL_HANDLE;
+        info.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VulkanUtil_WriteBindlessSlot(H, GPU_BINDLESS_RANGE_SAMPLER, index, &info, NULL);
+    }
+    return index;
+}
+
+void GPUBindlessHeapRemove_Vulkan(GPUBindlessHeapID heap, EGPUBindlessRange range, uint32_t index)
+{
+    GPUBindlessHeap_Vulkan* H = (GPUBindlessHeap_Vulkan*)heap;
+    std::lock_guard<std::mutex> guard(H->pSlots->lock);
+    GPUVkBindlessSlots::Range& slots = H->pSlots->ranges[range];
+    assert(index < slots.refs.size() && slots.refs[index] && "removing an empty bindless slot!");
+    if (--slots.refs[index] == 0)
+    {
+        // the stale descriptor stays, partially bound slots are never read unless a shader indexes them
+        slots.indices.erase(slots.objects[index]);
+        slots.objects[index] = nullptr;
+        slots.freeSlots.push_back(index);
+    }
+}
@@ -6,6 +6,7 @@
 #include "shader-reflections/spirv/spirv_reflect.h"
 #include "api.h"
 #include "Utils.h"
+#include "GPUReflectionBlob.h"
 
 void VulkanUtil_SelectValidationLayers(GPUInstance_Vulkan* pInstance, const char** instanceLayers, uint32_t layersCount)
 {
@@ -157,6 +158,21 @@ void VulkanUtil_QueryAllAdapters(struct GPUInstance_Vulkan* pInstance, const cha
             {
                 void** ppNext = &pVkAdapter->physicalDeviceFeatures.pNext;
                 *ppNext       = VK_NULL_HANDLE;
+                memset(&pVkAdapter->physicalDeviceFeatures12, 0, sizeof(VkPhysicalDeviceVulkan12Features));
+                memset(&pVkAdapter->physicalDeviceFeatures13, 0, sizeof(VkPhysicalDeviceVulkan13Features));
+                // what the adapter supports, device creation enables a subset
+                if (pVkAdapter->physicalDeviceProperties.properties.apiVersion >= VK_API_VERSION_1_2)
+                {
+                    pVkAdapter->physicalDeviceFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+                    *ppNext                                    = &pVkAdapter->physicalDeviceFeatures12;
+                    ppNext                                     = &pVkAdapter->physicalDeviceFeatures12.pNext;
+                }
+                if (pVkAdapter->physicalDeviceProperties.properties.apiVersion >= VK_API_VERSION_1_3)
+                {
+                    pVkAdapter->physicalDeviceFeatures13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+                    *ppNext                                    = &pVkAdapter->physicalDeviceFeatures13;
+                    ppNext                                     = &pVkAdapter->physicalDeviceFeatures13.pNext;
+                }
             }
             vkGetPhysicalDeviceFeatures2(pVkAdapter->pPhysicalDevice, &pVkAdapter->physicalDeviceFeatures);
 
@@ -261,22 +277,107 @@ void VulkanUtil_EnumFormatSupport(GPUAdapter_Vulkan* pAdapter)
     }
 }
 
-void VulkanUtil_RecordAdaptorDetail(GPUAdapter_Vulkan* pAdapter)
+static bool VulkanUtil_AdapterHasExtension(const GPUAdapter_Vulkan* pAdapter, const char* name)
 {
-    GPUAdapterDetail* detail = &pAdapter->adapterDetail;
+    for (uint32_t i = 0; i < pAdapter->extensionsCount; i++)
+    {
+        if (strcmp(pAdapter->ppExtensionsName[i], name) == 0) return true;
+    }
+    return false;
 }
 
-uint32_t VulkanUtil_BitSizeOfBlock(EGPUFormat format)
+void VulkanUtil_RecordAdaptorDetail(GPUAdapter_Vulkan* pAdapter)
 {
-    switch (format)
+    GPUAdapterDetail* detail            = &pAdapter->adapterDetail;
+    detail->support_timeline_semaphore  = pAdapter->physicalDeviceFeatures12.timelineSemaphore;
+    detail->support_synchronization2    = pAdapter->physicalDeviceFeatures13.synchronization2;
+    detail->support_draw_indirect_count = pAdapter->physicalDeviceFeatures12.drawIndirectCount;
+    // the bindless heap writes slots of a bound set, and shaders index it with non-uniform values
+    const VkPhysicalDeviceVulkan12Features& f12 = pAdapter->physicalDeviceFeatures12;
+    detail->support_bindless = f12.descriptorIndexing && f12.runtimeDescriptorArray &&
+                               f12.descriptorBindingPartiallyBound &&
+                               f12.descriptorBindingUpdateUnusedWhilePending &&
+                               f12.descriptorBindingSampledImageUpdateAfterBind &&
+                               f12.descriptorBindingStorageImageUpdateAfterBind &&
+                               f12.descriptorBindingStorageBufferUpdateAfterBind &&
+                               f12.shaderSampledImageArrayNonUniformIndexing;
+    // update after bind sets have their own, usually much higher, descriptor limits
+    memset(&pAdapter->descriptorIndexingProperties, 0, sizeof(VkPhysicalDeviceDescriptorIndexingProperties));
+    if (detail->support_bindless)
+    {
+        pAdapter->descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+        VkPhysicalDeviceProperties2KHR properties2   = {};
+        properties2.sType                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+        properties2.pNext                            = &pAdapter->descriptorIndexingProperties;
+        vkGetPhysicalDeviceProperties2KHR(pAdapter->pPhysicalDevice, &properties2);
+        pAdapter->descriptorIndexingProperties.pNext = VK_NULL_HANDLE;
+    }
+    detail->support_push_descriptor       = VulkanUtil_AdapterHasExtension(pAdapter, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    detail->support_buffer_device_address = f12.bufferDeviceAddress;
+    // descriptor buffers point at buffers through device addresses
+    memset(&pAdapter->descriptorBufferProperties, 0, sizeof(VkPhysicalDeviceDescriptorBufferPropertiesEXT));
+    detail->support_descriptor_buffer = 0;
+    if (f12.bufferDeviceAddress && VulkanUtil_AdapterHasExtension(pAdapter, VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME))
     {
-        case EGPUFormat::GPU_FORMAT_R16_UINT: return 16;
-        case EGPUFormat::GPU_FORMAT_R32_UINT: return 32;
-        case EGPUFormat::GPU_FORMAT_R32_SFLOAT: return 32;
-        case EGPUFormat::GPU_FORMAT_R32G32_SFLOAT: return 64;
-        case EGPUFormat::GPU_FORMAT_R32G32B32_SFLOAT: return 96;
+        VkPhysicalDeviceDescriptorBufferFeaturesEXT features = {};
+        features.sType                                       = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features2                  = {};
+        features2.sType                                      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext                                      = &features;
+        vkGetPhysicalDeviceFeatures2(pAdapter->pPhysicalDevice, &features2);
+
+        pAdapter->descriptorBufferProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+        VkPhysicalDeviceProperties2KHR properties2 = {};
+        properties2.sType                          = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+        properties2.pNext                          = &pAdapter->descriptorBufferProperties;
+        vkGetPhysicalDeviceProperties2KHR(pAdapter->pPhysicalDevice, &properties2);
+        pAdapter->descriptorBufferProperties.pNext = VK_NULL_HANDLE;
+        detail->support_descriptor_buffer          = features.descriptorBuffer;
+    }
+    detail->support_graphics_pipeline_library = 0;
+    if (VulkanUtil_AdapterHasExtension(pAdapter, VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+        VulkanUtil_AdapterHasExtension(pAdapter, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME))
+    {
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT features = {};
+        features.sType                                              = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features2                         = {};
+        features2.sType                                             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext                                             = &features;
+        vkGetPhysicalDeviceFeatures2(pAdapter->pPhysicalDevice, &features2);
+        detail->support_graphics_pipeline_library = features.graphicsPipelineLibrary;
+    }
+    detail->support_extended_dynamic_state  = 0;
+    detail->support_extended_dynamic_state2 = 0;
+    detail->support_extended_dynamic_state3 = 0;
+    if (VulkanUtil_AdapterHasExtension(pAdapter, VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+    {
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT level1  = {};
+        level1.sType                                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+        VkPhysicalDeviceExtendedDynamicState2FeaturesEXT level2 = {};
+        level2.sType                                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT;
+        VkPhysicalDeviceExtendedDynamicState3FeaturesEXT level3 = {};
+        level3.sType                                            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features2                     = {};
+        features2.sType                                         = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext                                         = &level1;
+        // only chain the structs of extensions the adapter exposes
+        const bool hasLevel2 = VulkanUtil_AdapterHasExtension(pAdapter, VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME);
+        const bool hasLevel3 = VulkanUtil_AdapterHasExtension(pAdapter, VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+        if (hasLevel2)
+        {
+            level2.pNext    = features2.pNext;
+            features2.pNext = &level2;
+        }
+        if (hasLevel3)
+        {
+            level3.pNext    = features2.pNext;
+            features2.pNext = &level3;
+        }
+        vkGetPhysicalDeviceFeatures2(pAdapter->pPhysicalDevice, &features2);
+        detail->support_extended_dynamic_state  = level1.extendedDynamicState;
+        detail->support_extended_dynamic_state2 = level1.extendedDynamicState && hasLevel2 && level2.extendedDynamicState2;
+        detail->support_extended_dynamic_state3 = level1.extendedDynamicState && hasLevel3 && level3.extendedDynamicState3PolygonMode && level3.extendedDynamicState3DepthClampEnable;
     }
-    return 0;
 }
 
 VkSampleCountFlagBits VulkanUtil_SampleCountToVk(EGPUSampleCount sampleCount)
@@ -420,8 +521,64 @@ static EGPUTextureDimension ArrDIMLut[SpvDimSubpassData + 1] = {
 };
 
 const char8_t* push_constants_name = u8"push_constants";
+
+// spirv_reflect does not list specialization constants, they are read from the module words.
+// Names point into the code copy of the reflect module
+static void VulkanUtil_ReflectSpecConstants(const SpvReflectShaderModule* module, GPUShaderReflection* reflection)
+{
+    const uint32_t* code  = spvReflectGetCode(module);
+    const uint32_t size   = spvReflectGetCodeSize(module) / sizeof(uint32_t);
+    const uint32_t header = 5;
+    uint32_t count        = 0;
+    for (uint32_t i = header; i < size && (code[i] >> 16); i += code[i] >> 16)
+    {
+        if ((code[i] & 0xFFFF) == SpvOpDecorate && code[i + 2] == SpvDecorationSpecId) count++;
+    }
+    if (count == 0) return;
+
+    DECLEAR_ZERO_VAL(uint32_t, ids, count)
+    reflection->spec_constants_count = count;
+    reflection->spec_constants       = (GPUShaderSpecConstant*)calloc(count, sizeof(GPUShaderSpecConstant));
+    count                            = 0;
+    for (uint32_t i = header; i < size && (code[i] >> 16); i += code[i] >> 16)
+    {
+        if ((code[i] & 0xFFFF) != SpvOpDecorate || code[i + 2] != SpvDecorationSpecId) continue;
+        ids[count]                                       = code[i + 1];
+        reflection->spec_constants[count++].constant_id = code[i + 3];
+    }
+    for (uint32_t i = header; i < size && (code[i] >> 16); i += code[i] >> 16)
+    {
+        const uint32_t op = code[i] & 0xFFFF;
+        if (op != SpvOpName && op != SpvOpSpecConstantTrue && op != SpvOpSpecConstantFalse && op != SpvOpSpecConstant) continue;
+        // OpName targets its first operand, the constants define their second one
+        const uint32_t id = op == SpvOpName ? code[i + 1] : code[i + 2];
+        for (uint32_t j = 0; j < count; j++)
+        {
+            if (ids[j] != id) continue;
+            GPUShaderSpecConstant& constant = reflection->spec_constants[j];
+            // 64-bit literals take two words, low word first
+            const uint32_t words = code[i] >> 16;
+            if (op == SpvOpName) constant.name = (const char8_t*)&code[i + 2];
+            else if (op == SpvOpSpecConstant)
+            {
+                constant.size          = words > 4 ? sizeof(uint64_t) : sizeof(uint32_t);
+                constant.default_value = words > 4 ? code[i + 3] | ((uint64_t)code[i + 4] << 32) : code[i + 3];
+            }
+            else
+            {
+                constant.size          = sizeof(uint32_t);
+                constant.default_value = op == SpvOpSpecConstantTrue ? 1 : 0;
+            }
+        }
+    }
+}
+
 void VulkanUtil_InitializeShaderReflection(GPUDeviceID device, GPUShaderLibrary_Vulkan* S, const struct GPUShaderLibraryDescriptor* desc)
 {
+    // a blob that does not load falls back to reflecting the SPIR-V
+    S->pReflect = nullptr;
+    if (desc->reflection && GPUUtil_LoadShaderReflection(desc->reflection, desc->reflectionSize, &S->super.entry_reflections, &S->super.entrys_count))
+        return;
     S->pReflect             = (SpvReflectShaderModule*)malloc(sizeof(SpvReflectShaderModule));
     SpvReflectResult spvRes = spvReflectCreateShaderModule(desc->codeSize, desc->code, S->pReflect);
     (void)spvRes;
@@ -533,11 +690,18 @@ void VulkanUtil_InitializeShaderReflection(GPUDeviceID device, GPUShaderLibrary_
                 current_res->offset             = root_sets[i]->offset;
             }
         }
+        VulkanUtil_ReflectSpecConstants(S->pReflect, reflection);
     }
 }
 
 void VulkanUtil_FreeShaderReflection(GPUShaderLibrary_Vulkan* S)
 {
+    if (!S->pReflect)
+    {
+        // loaded from a blob, a single allocation
+        GPU_SAFE_FREE(S->super.entry_reflections);
+        return;
+    }
     spvReflectDestroyShaderModule(S->pReflect);
     if (S->super.entry_reflections)
     {
@@ -546,6 +710,7 @@ void VulkanUtil_FreeShaderReflection(GPUShaderLibrary_Vulkan* S)
             GPUShaderReflection* reflection = S->super.entry_reflections + i;
             if (reflection->vertex_inputs) free(reflection->vertex_inputs);
             if (reflection->shader_resources) free(reflection->shader_resources);
+            if (reflection->spec_constants) free(reflection->spec_constants);
         }
     }
     GPU_SAFE_FREE(S->super.entry_reflections);
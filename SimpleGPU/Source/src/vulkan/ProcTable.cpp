@@ -1,65 +1,107 @@
 #include "backend/vulkan/GPUVulkan.h"
 
-const GPUProcTable vkTable = {
-    .CreateInstance                    = &CreateInstance_Vulkan,
-    .FreeInstance                      = &FreeInstance_Vllkan,
-    .EnumerateAdapters                 = &EnumerateAdapters_Vulkan,
-    .CreateDevice                      = &CreateDevice_Vulkan,
-    .FreeDevice                        = &FreeDevice_Vulkan,
-    .GetQueue                          = &GetQueue_Vulkan,
-    .FreeQueue                         = &GPUFreeQueue_Vulkan,
-    .SubmitQueue                       = &GPUSubmitQueue_Vulkan,
-    .WaitQueueIdle                     = &GPUWaitQueueIdle_Vulkan,
-    .QueuePresent                      = &GPUQueuePresent_Vulkan,
-    .CreateSwapchain                   = &GPUCreateSwapchain_Vulkan,
-    .FreeSwapchain                     = &GPUFreeSwapchain_Vulkan,
-    .AcquireNextImage                  = &GPUAcquireNextImage_Vulkan,
-    .CreateTextureView                 = &GPUCreateTextureView_Vulkan,
-    .FreeTextureView                   = &GPUFreeTextureView_Vulkan,
-    .CreateTexture                     = &GPUCreateTexture_Vulkan,
-    .FreeTexture                       = &GPUFreeTexture_Vulkan,
-    .CreateShaderLibrary               = &GPUCreateShaderLibrary_Vulkan,
-    .FreeShaderLibrary                 = &GPUFreeShaderLibrary_Vulkan,
-    .CreateRenderPipeline              = &GPUCreateRenderPipeline_Vulkan,
-    .FreeRenderPipeline                = &GPUFreeRenderPipeline_Vulkan,
-    .CreateRootSignature               = &GPUCreateRootSignature_Vulkan,
-    .FreeRootSignature                 = &GPUFreeRootSignature_Vulkan,
-    .CreateCommandPool                 = &GPUCreateCommandPool_Vulkan,
-    .FreeCommandPool                   = &GPUFreeCommandPool_Vulkan,
-    .ResetCommandPool                  = &GPUResetCommandPool_Vulkan,
-    .CreateCommandBuffer               = &GPUCreateCommandBuffer_Vulkan,
-    .FreeCommandBuffer                 = &GPUFreeCommandBuffer_Vulkan,
-    .CmdBegin                          = &GPUCmdBegin_Vulkan,
-    .CmdEnd                            = &GPUCmdEnd_Vulkan,
-    .CmdResourceBarrier                = &GPUCmdResourceBarrier_Vulkan,
-    .CmdTransferBufferToTexture        = &GPUCmdTransferBufferToTexture_Vulkan,
-    .CmdTransferBufferToBuffer         = &GPUCmdTransferBufferToBuffer_Vulkan,
-    .CmdTransferTextureToTexture       = &GPUCmdTransferTextureToTexture_Vulkan,
-    .CreateFence                       = &GPUCreateFence_Vulkan,
-    .FreeFence                         = &GPUFreeFence_Vulkan,
-    .WaitFences                        = &GPUWaitFences_Vulkan,
-    .QueryFenceStatus                  = &GPUQueryFenceStatus_Vulkan,
-    .GpuCreateSemaphore                = &GPUCreateSemaphore_Vulkan,
-    .GpuFreeSemaphore                  = &GPUFreeSemaphore_Vulkan,
-    .CmdBeginRenderPass                = &GPUCmdBeginRenderPass_Vulkan,
-    .CmdEndRenderPass                  = &GPUCmdEndRenderPass_Vulkan,
-    .RenderEncoderSetViewport          = &GPURenderEncoderSetViewport_Vulkan,
-    .RenderEncoderSetScissor           = &GPURenderEncoderSetScissor_Vulkan,
-    .RenderEncoderBindPipeline         = &GPURenderEncoderBindPipeline_Vulkan,
-    .RenderEncoderDraw                 = &GPURenderEncoderDraw_Vulkan,
-    .RenderEncoderDrawIndexed          = &GPURenderEncoderDrawIndexed_Vulkan,
-    .RenderEncoderDrawIndexedInstanced = &GPURenderEncoderDrawIndexedInstanced_Vulkan,
-    .RenderEncoderBindVertexBuffers    = &GPURenderEncoderBindVertexBuffers_Vulkan,
-    .RenderEncoderBindIndexBuffer      = &GPURenderEncoderBindIndexBuffer_Vulkan,
-    .RenderEncoderBindDescriptorSet    = &GPURenderEncoderBindDescriptorSet_Vulkan,
-    .CreateBuffer                      = &GPUCreateBuffer_Vulkan,
-    .FreeBuffer                        = &GPUFreeBuffer_Vulkan,
-    .TransferBufferToBuffer            = &GPUTransferBufferToBuffer_Vulkan,
-    .CreateSampler                     = &GPUCreateSampler_Vulkan,
-    .FreeSampler                       = &GPUFreeSampler_Vulkan,
-    .CreateDescriptorSet               = &GPUCreateDescriptorSet_Vulkan,
-    .FreeDescriptorSet                 = &GPUFreeDescriptorSet_Vulkan,
-    .UpdateDescriptorSet               = &GPUUpdateDescriptorSet_Vulkan,
+constexpr GPUProcTable vkTable = {
+    .CreateInstance                             = &CreateInstance_Vulkan,
+    .FreeInstance                               = &FreeInstance_Vllkan,
+    .EnumerateAdapters                          = &EnumerateAdapters_Vulkan,
+    .CreateDevice                               = &CreateDevice_Vulkan,
+    .FreeDevice                                 = &FreeDevice_Vulkan,
+    .GetQueue                                   = &GetQueue_Vulkan,
+    .FreeQueue                                  = &GPUFreeQueue_Vulkan,
+    .SubmitQueue                                = &GPUSubmitQueue_Vulkan,
+    .SubmitQueueBatches                         = &GPUSubmitQueueBatches_Vulkan,
+    .FlushQueueTransitions                      = &GPUFlushQueueTransitions_Vulkan,
+    .WaitQueueIdle                              = &GPUWaitQueueIdle_Vulkan,
+    .QueuePresent                               = &GPUQueuePresent_Vulkan,
+    .CreateSwapchain                            = &GPUCreateSwapchain_Vulkan,
+    .FreeSwapchain                              = &GPUFreeSwapchain_Vulkan,
+    .AcquireNextImage                           = &GPUAcquireNextImage_Vulkan,
+    .CreateTextureView                          = &GPUCreateTextureView_Vulkan,
+    .FreeTextureView                            = &GPUFreeTextureView_Vulkan,
+    .CreateTexture                              = &GPUCreateTexture_Vulkan,
+    .FreeTexture                                = &GPUFreeTexture_Vulkan,
+    .CreateShaderLibrary                        = &GPUCreateShaderLibrary_Vulkan,
+    .FreeShaderLibrary                          = &GPUFreeShaderLibrary_Vulkan,
+    .CreateRenderPipeline                       = &GPUCreateRenderPipeline_Vulkan,
+    .FreeRenderPipeline                         = &GPUFreeRenderPipeline_Vulkan,
+    .CreateComputePipeline                      = &GPUCreateComputePipeline_Vulkan,
+    .FreeComputePipeline                        = &GPUFreeComputePipeline_Vulkan,
+    .CreateRootSignature                        = &GPUCreateRootSignature_Vulkan,
+    .FreeRootSignature                          = &GPUFreeRootSignature_Vulkan,
+    .CreateRootSignaturePool                    = &GPUCreateRootSignaturePool_Vulkan,
+    .FreeRootSignaturePool                      = &GPUFreeRootSignaturePool_Vulkan,
+    .CreateCommandPool                          = &GPUCreateCommandPool_Vulkan,
+    .FreeCommandPool                            = &GPUFreeCommandPool_Vulkan,
+    .ResetCommandPool                           = &GPUResetCommandPool_Vulkan,
+    .CreateCommandBuffer                        = &GPUCreateCommandBuffer_Vulkan,
+    .FreeCommandBuffer                          = &GPUFreeCommandBuffer_Vulkan,
+    .CmdBegin                                   = &GPUCmdBegin_Vulkan,
+    .CmdEnd                                     = &GPUCmdEnd_Vulkan,
+    .CmdResourceBarrier                         = &GPUCmdResourceBarrier_Vulkan,
+    .CmdTransferBufferToTexture                 = &GPUCmdTransferBufferToTexture_Vulkan,
+    .CmdTransferBufferToBuffer                  = &GPUCmdTransferBufferToBuffer_Vulkan,
+    .CmdTransferTextureToTexture                = &GPUCmdTransferTextureToTexture_Vulkan,
+    .CmdTransferBufferToTextureRegions          = &GPUCmdTransferBufferToTextureRegions_Vulkan,
+    .CmdTransferBufferToBufferRegions           = &GPUCmdTransferBufferToBufferRegions_Vulkan,
+    .CmdTransferTextureToTextureRegions         = &GPUCmdTransferTextureToTextureRegions_Vulkan,
+    .CreateFence                                = &GPUCreateFence_Vulkan,
+    .FreeFence                                  = &GPUFreeFence_Vulkan,
+    .WaitFences                                 = &GPUWaitFences_Vulkan,
+    .QueryFenceStatus                           = &GPUQueryFenceStatus_Vulkan,
+    .GpuCreateSemaphore                         = &GPUCreateSemaphore_Vulkan,
+    .GpuFreeSemaphore                           = &GPUFreeSemaphore_Vulkan,
+    .CreateTimelineSemaphore                    = &GPUCreateTimelineSemaphore_Vulkan,
+    .SignalSemaphore                            = &GPUSignalSemaphore_Vulkan,
+    .WaitSemaphores                             = &GPUWaitSemaphores_Vulkan,
+    .QuerySemaphoreValue                        = &GPUQuerySemaphoreValue_Vulkan,
+    .CmdBeginRenderPass                         = &GPUCmdBeginRenderPass_Vulkan,
+    .CmdEndRenderPass                           = &GPUCmdEndRenderPass_Vulkan,
+    .CmdBeginRenderBundle                       = &GPUCmdBeginRenderBundle_Vulkan,
+    .CmdEndRenderBundle                         = &GPUCmdEndRenderBundle_Vulkan,
+    .RenderEncoderExecuteBundles                = &GPURenderEncoderExecuteBundles_Vulkan,
+    .RenderEncoderSetViewport                   = &GPURenderEncoderSetViewport_Vulkan,
+    .RenderEncoderSetScissor                    = &GPURenderEncoderSetScissor_Vulkan,
+    .RenderEncoderBindPipeline                  = &GPURenderEncoderBindPipeline_Vulkan,
+    .RenderEncoderSetRasterizerState            = &GPURenderEncoderSetRasterizerState_Vulkan,
+    .RenderEncoderSetDepthState                 = &GPURenderEncoderSetDepthState_Vulkan,
+    .RenderEncoderSetPrimitiveTopology          = &GPURenderEncoderSetPrimitiveTopology_Vulkan,
+    .RenderEncoderDraw                          = &GPURenderEncoderDraw_Vulkan,
+    .RenderEncoderDrawInstanced                 = &GPURenderEncoderDrawInstanced_Vulkan,
+    .RenderEncoderDrawIndexed                   = &GPURenderEncoderDrawIndexed_Vulkan,
+    .RenderEncoderDrawIndexedInstanced          = &GPURenderEncoderDrawIndexedInstanced_Vulkan,
+    .RenderEncoderDrawIndirect                  = &GPURenderEncoderDrawIndirect_Vulkan,
+    .RenderEncoderDrawIndexedIndirect           = &GPURenderEncoderDrawIndexedIndirect_Vulkan,
+    .RenderEncoderDrawIndirectCount             = &GPURenderEncoderDrawIndirectCount_Vulkan,
+    .RenderEncoderDrawIndexedIndirectCount      = &GPURenderEncoderDrawIndexedIndirectCount_Vulkan,
+    .RenderEncoderBindVertexBuffers             = &GPURenderEncoderBindVertexBuffers_Vulkan,
+    .RenderEncoderBindIndexBuffer               = &GPURenderEncoderBindIndexBuffer_Vulkan,
+    .RenderEncoderBindDescriptorSet             = &GPURenderEncoderBindDescriptorSet_Vulkan,
+    .RenderEncoderBindDescriptorSetWithOffsets  = &GPURenderEncoderBindDescriptorSetWithOffsets_Vulkan,
+    .RenderEncoderPushConstants                 = &GPURenderEncoderPushConstants_Vulkan,
+    .RenderEncoderPushDescriptorSet             = &GPURenderEncoderPushDescriptorSet_Vulkan,
+    .CmdBeginComputePass                        = &GPUCmdBeginComputePass_Vulkan,
+    .CmdEndComputePass                          = &GPUCmdEndComputePass_Vulkan,
+    .ComputeEncoderBindPipeline                 = &GPUComputeEncoderBindPipeline_Vulkan,
+    .ComputeEncoderBindDescriptorSet            = &GPUComputeEncoderBindDescriptorSet_Vulkan,
+    .ComputeEncoderBindDescriptorSetWithOffsets = &GPUComputeEncoderBindDescriptorSetWithOffsets_Vulkan,
+    .ComputeEncoderPushConstants                = &GPUComputeEncoderPushConstants_Vulkan,
+    .ComputeEncoderPushDescriptorSet            = &GPUComputeEncoderPushDescriptorSet_Vulkan,
+    .ComputeEncoderDispatch                     = &GPUComputeEncoderDispatch_Vulkan,
+    .ComputeEncoderDispatchIndirect             = &GPUComputeEncoderDispatchIndirect_Vulkan,
+    .CreateBuffer                               = &GPUCreateBuffer_Vulkan,
+    .FreeBuffer                                 = &GPUFreeBuffer_Vulkan,
+    .TransferBufferToBuffer                     = &GPUTransferBufferToBuffer_Vulkan,
+    .CreateSampler                              = &GPUCreateSampler_Vulkan,
+    .FreeSampler                                = &GPUFreeSampler_Vulkan,
+    .CreateDescriptorSet                        = &GPUCreateDescriptorSet_Vulkan,
+    .FreeDescriptorSet                          = &GPUFreeDescriptorSet_Vulkan,
+    .UpdateDescriptorSet                        = &GPUUpdateDescriptorSet_Vulkan,
+    .CreateBindlessHeap                         = &GPUCreateBindlessHeap_Vulkan,
+    .FreeBindlessHeap                           = &GPUFreeBindlessHeap_Vulkan,
+    .BindlessHeapAddTexture                     = &GPUBindlessHeapAddTexture_Vulkan,
+    .BindlessHeapAddBuffer                      = &GPUBindlessHeapAddBuffer_Vulkan,
+    .BindlessHeapAddSampler                     = &GPUBindlessHeapAddSampler_Vulkan,
+    .BindlessHeapRemove                         = &GPUBindlessHeapRemove_Vulkan,
 };
 const GPUProcTable* GPUVulkanProcTable()
 {
@@ -0,0 +1,53 @@
+#pragma once
+#include "api.h"
+#include "backend/null/GPUNull.h"
+#include <cstdio>
+
+#define CHECK(cond)                                                     \
+    if (!(cond))                                                        \
+    {                                                                   \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        return 1;                                                       \
+    }
+
+// null instance with its only adapter, a device and the graphics queue the tests run on
+typedef struct NullDevice
+{
+    GPUInstanceID instance;
+    GPUAdapterID adapter;
+    GPUDeviceID device;
+    GPUQueueID queue;
+} NullDevice;
+
+static inline bool NullDevice_Create(NullDevice* pNull, uint32_t completion_delay_us, bool validate_barriers)
+{
+    GPUNullInstanceDescriptor null_desc{};
+    null_desc.chained.backend     = GPUBackend_Null;
+    null_desc.completion_delay_us = completion_delay_us;
+    null_desc.validate_barriers   = validate_barriers;
+    GPUInstanceDescriptor instance_desc{};
+    instance_desc.pChained = &null_desc.chained;
+    instance_desc.backend  = GPUBackend_Null;
+    pNull->instance        = GPUCreateInstance(&instance_desc);
+
+    uint32_t adapterCount = 1;
+    GPUEnumerateAdapters(pNull->instance, &pNull->adapter, &adapterCount);
+    if (adapterCount != 1 || !pNull->adapter) return false;
+
+    GPUQueueGroupDescriptor queue_group{};
+    queue_group.queueType  = GPU_QUEUE_TYPE_GRAPHICS;
+    queue_group.queueCount = 1;
+    GPUDeviceDescriptor device_desc{};
+    device_desc.pQueueGroup     = &queue_group;
+    device_desc.queueGroupCount = 1;
+    pNull->device               = GPUCreateDevice(pNull->adapter, &device_desc);
+    pNull->queue                = pNull->device ? GPUGetQueue(pNull->device, GPU_QUEUE_TYPE_GRAPHICS, 0) : nullptr;
+    return pNull->device && pNull->queue;
+}
+
+static inline void NullDevice_Free(NullDevice* pNull)
+{
+    if (pNull->queue) GPUFreeQueue(pNull->queue);
+    if (pNull->device) GPUFreeDevice(pNull->device);
+    if (pNull->instance) GPUFreeInstance(pNull->instance);
+}
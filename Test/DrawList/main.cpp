@@ -0,0 +1,245 @@
+#include "../Common/NullDevice.h"
+#include "GPUDrawList.hpp"
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+struct DrawCall
+{
+    bool indexed;
+    uint32_t count;
+    uint32_t instance_count;
+    uint32_t first;
+    uint32_t first_instance;
+};
+
+// the null backend draws nothing, the replay is observed through a copy of its proc table
+static std::vector<DrawCall> sDrawCalls;
+
+static void RecordDrawInstanced(GPURenderPassEncoderID /*encoder*/, uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
+{
+    sDrawCalls.push_back({ false, vertex_count, instance_count, first_vertex, first_instance });
+}
+
+static void RecordDrawIndexedInstanced(GPURenderPassEncoderID /*encoder*/, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t /*vertexOffset*/, uint32_t firstInstance)
+{
+    sDrawCalls.push_back({ true, indexCount, instanceCount, firstIndex, firstInstance });
+}
+
+struct DrawListFixture
+{
+    GPURenderPipelineID pipelines[2];
+    GPUBufferID vertex_buffer;
+    GPUBufferID index_buffer;
+    GPUBufferID instance_buffer;
+    GPUDrawGeometry indexed;
+    GPUDrawGeometry non_indexed;
+    uint32_t stride;
+};
+
+static GPUDrawPacket MakePacket(const DrawListFixture& f, uint32_t pipeline, const GPUDrawGeometry* geometry, uint8_t layer, uint16_t depth, uint32_t first, const uint32_t* id)
+{
+    GPUDrawPacket packet{};
+    packet.pipeline      = f.pipelines[pipeline];
+    packet.geometry      = geometry;
+    packet.count         = 36;
+    packet.first         = first;
+    packet.layer         = layer;
+    packet.depth         = depth;
+    packet.instance_data = id;
+    return packet;
+}
+
+static GPUDrawListStats Replay(const DrawListFixture& f, GPUDrawListID list, GPURenderPassEncoderID encoder)
+{
+    sDrawCalls.clear();
+    memset(f.instance_buffer->cpu_mapped_address, 0xff, f.instance_buffer->size);
+    GPUDrawListReplayDescriptor replay_desc{};
+    replay_desc.instance_buffer = f.instance_buffer;
+    return GPUDrawListReplay(list, encoder, &replay_desc);
+}
+
+// every draw differs in its first vertex so nothing merges, the instance data lands in key order:
+// layer, then pipeline in recording order, then depth, and equal keys keep their recording order
+static int TestSortOrder(const DrawListFixture& f, GPUDrawListID list, GPURenderPassEncoderID encoder)
+{
+    const uint32_t ids[5] = { 0, 1, 2, 3, 4 };
+    GPUDrawPacket packets[5] = {
+        MakePacket(f, 0, &f.non_indexed, 1, 0, 0, &ids[0]),
+        MakePacket(f, 1, &f.non_indexed, 0, 9, 1, &ids[1]),
+        MakePacket(f, 0, &f.non_indexed, 0, 7, 2, &ids[2]),
+        MakePacket(f, 0, &f.non_indexed, 0, 2, 3, &ids[3]),
+        MakePacket(f, 0, &f.non_indexed, 1, 0, 4, &ids[4])
+    };
+    for (const GPUDrawPacket& packet : packets)
+    {
+        GPUDrawListRecord(list, &packet);
+    }
+    const GPUDrawListStats stats = Replay(f, list, encoder);
+    CHECK(stats.draws == 5 && stats.draw_calls == 5);
+    CHECK(stats.pipeline_binds == 3);
+    CHECK(stats.geometry_binds == 1);
+
+    const uint32_t expected[5] = { 3, 2, 1, 0, 4 };
+    const uint32_t* pInstances = (const uint32_t*)f.instance_buffer->cpu_mapped_address;
+    CHECK(sDrawCalls.size() == 5);
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        CHECK(pInstances[i] == expected[i]);
+        CHECK(!sDrawCalls[i].indexed);
+        CHECK(sDrawCalls[i].first == expected[i]);
+        CHECK(sDrawCalls[i].instance_count == 1);
+        CHECK(sDrawCalls[i].first_instance == i);
+    }
+    GPUDrawListReset(list);
+    return 0;
+}
+
+// draws that only differ in depth collapse into one instanced call once they are adjacent in the sorted stream
+static int TestInstancedMerge(const DrawListFixture& f, GPUDrawListID list, GPURenderPassEncoderID encoder)
+{
+    const uint32_t ids[6] = { 10, 11, 12, 13, 14, 15 };
+    GPUDrawPacket packets[6] = {
+        MakePacket(f, 0, &f.indexed, 0, 5, 0, &ids[0]),
+        MakePacket(f, 1, &f.indexed, 0, 1, 0, &ids[1]),
+        MakePacket(f, 0, &f.indexed, 0, 3, 0, &ids[2]),
+        MakePacket(f, 0, &f.indexed, 0, 4, 0, &ids[3]),
+        MakePacket(f, 0, &f.indexed, 0, 6, 6, &ids[4]), // other index range, a call of its own
+        MakePacket(f, 1, &f.indexed, 0, 2, 0, &ids[5])
+    };
+    for (const GPUDrawPacket& packet : packets)
+    {
+        GPUDrawListRecord(list, &packet);
+    }
+    const GPUDrawListStats stats = Replay(f, list, encoder);
+    CHECK(stats.draws == 6 && stats.draw_calls == 3);
+    CHECK(stats.pipeline_binds == 2);
+
+    const uint32_t expected[6] = { 12, 13, 10, 14, 11, 15 };
+    const uint32_t* pInstances = (const uint32_t*)f.instance_buffer->cpu_mapped_address;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        CHECK(pInstances[i] == expected[i]);
+    }
+    CHECK(sDrawCalls.size() == 3);
+    CHECK(sDrawCalls[0].indexed && sDrawCalls[0].count == 36 && sDrawCalls[0].first == 0);
+    CHECK(sDrawCalls[0].instance_count == 3 && sDrawCalls[0].first_instance == 0);
+    CHECK(sDrawCalls[1].first == 6);
+    CHECK(sDrawCalls[1].instance_count == 1 && sDrawCalls[1].first_instance == 3);
+    CHECK(sDrawCalls[2].instance_count == 2 && sDrawCalls[2].first_instance == 4);
+    GPUDrawListReset(list);
+    return 0;
+}
+
+// the transparent layer is depth-major, its draws follow their depth across both pipelines
+// and the two adjacent draws that share all state still merge
+static int TestDepthMajor(const DrawListFixture& f, GPUDrawListID list, GPURenderPassEncoderID encoder)
+{
+    const uint32_t ids[5] = { 20, 21, 22, 23, 24 };
+    GPUDrawPacket packets[5] = {
+        MakePacket(f, 0, &f.non_indexed, 1, 5, 0, &ids[0]),
+        MakePacket(f, 1, &f.non_indexed, 1, 3, 0, &ids[1]),
+        MakePacket(f, 0, &f.non_indexed, 1, 1, 0, &ids[2]),
+        MakePacket(f, 1, &f.non_indexed, 1, 4, 0, &ids[3]),
+        MakePacket(f, 1, &f.non_indexed, 0, 9, 0, &ids[4]) // opaque, still before every transparent draw
+    };
+    for (const GPUDrawPacket& packet : packets)
+    {
+        GPUDrawListRecord(list, &packet);
+    }
+    const GPUDrawListStats stats = Replay(f, list, encoder);
+    CHECK(stats.draws == 5 && stats.draw_calls == 4);
+    CHECK(stats.pipeline_binds == 4);
+
+    const uint32_t expected[5] = { 24, 22, 21, 23, 20 };
+    const uint32_t* pInstances = (const uint32_t*)f.instance_buffer->cpu_mapped_address;
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        CHECK(pInstances[i] == expected[i]);
+    }
+    CHECK(sDrawCalls.size() == 4);
+    CHECK(sDrawCalls[2].instance_count == 2 && sDrawCalls[2].first_instance == 2);
+    GPUDrawListReset(list);
+    return 0;
+}
+
+static int TestDrawList(GPUDeviceID device, GPUQueueID queue)
+{
+    DrawListFixture f{};
+    GPURenderPipelineDescriptor pipeline_desc{};
+    f.pipelines[0] = GPUCreateRenderPipeline(device, &pipeline_desc);
+    f.pipelines[1] = GPUCreateRenderPipeline(device, &pipeline_desc);
+
+    GPUBufferDescriptor buffer_desc{};
+    buffer_desc.size          = 4096;
+    buffer_desc.descriptors   = GPU_RESOURCE_TYPE_VERTEX_BUFFER;
+    buffer_desc.memory_usage  = GPU_MEM_USAGE_GPU_ONLY;
+    f.vertex_buffer           = GPUCreateBuffer(device, &buffer_desc);
+    buffer_desc.descriptors   = GPU_RESOURCE_TYPE_INDEX_BUFFER;
+    f.index_buffer            = GPUCreateBuffer(device, &buffer_desc);
+    buffer_desc.size          = 256;
+    buffer_desc.flags         = GPU_BCF_PERSISTENT_MAP_BIT;
+    buffer_desc.descriptors   = GPU_RESOURCE_TYPE_VERTEX_BUFFER;
+    buffer_desc.memory_usage  = GPU_MEM_USAGE_CPU_TO_GPU;
+    f.instance_buffer         = GPUCreateBuffer(device, &buffer_desc);
+    CHECK(f.instance_buffer->cpu_mapped_address);
+    f.stride                  = 12;
+    f.indexed                 = { &f.vertex_buffer, &f.stride, nullptr, 1, f.index_buffer, 0, sizeof(uint16_t) };
+    f.non_indexed             = { &f.vertex_buffer, &f.stride, nullptr, 1, nullptr, 0, 0 };
+
+    GPUDrawListDescriptor list_desc{};
+    list_desc.instance_data_size = sizeof(uint32_t);
+    list_desc.reserve_count      = 8;
+    GPUDrawListID list           = GPUCreateDrawList(device, &list_desc);
+    // layer 1 stands for the transparent draws
+    const uint8_t transparent          = 1;
+    list_desc.depth_major_layers       = &transparent;
+    list_desc.depth_major_layers_count = 1;
+    GPUDrawListID depth_major_list     = GPUCreateDrawList(device, &list_desc);
+
+    // the table members are const, the copy is patched bytewise
+    alignas(GPUProcTable) uint8_t procs[sizeof(GPUProcTable)];
+    const GPUProcRenderEncoderDrawInstanced draw               = &RecordDrawInstanced;
+    const GPUProcRenderEncoderDrawIndexedInstanced drawIndexed = &RecordDrawIndexedInstanced;
+    memcpy(procs, device->pProcTableCache, sizeof(GPUProcTable));
+    memcpy(procs + offsetof(GPUProcTable, RenderEncoderDrawInstanced), &draw, sizeof(draw));
+    memcpy(procs + offsetof(GPUProcTable, RenderEncoderDrawIndexedInstanced), &drawIndexed, sizeof(drawIndexed));
+    const GPUProcTable* pNullProcs        = device->pProcTableCache;
+    ((GPUDevice*)device)->pProcTableCache = (const GPUProcTable*)procs;
+
+    GPUCommandPoolID pool = GPUCreateCommandPool(queue);
+    GPUCommandBufferDescriptor cmd_desc{};
+    GPUCommandBufferID cmd = GPUCreateCommandBuffer(pool, &cmd_desc);
+    GPUCmdBegin(cmd);
+    GPURenderPassDescriptor pass_desc{};
+    GPURenderPassEncoderID encoder = GPUCmdBeginRenderPass(cmd, &pass_desc);
+    int result                     = TestSortOrder(f, list, encoder);
+    if (!result) result = TestInstancedMerge(f, list, encoder);
+    if (!result) result = TestDepthMajor(f, depth_major_list, encoder);
+    GPUCmdEndRenderPass(cmd, encoder);
+    GPUCmdEnd(cmd);
+
+    ((GPUDevice*)device)->pProcTableCache = pNullProcs;
+    GPUFreeCommandBuffer(cmd);
+    GPUFreeCommandPool(pool);
+    GPUFreeDrawList(depth_major_list);
+    GPUFreeDrawList(list);
+    GPUFreeBuffer(f.instance_buffer);
+    GPUFreeBuffer(f.index_buffer);
+    GPUFreeBuffer(f.vertex_buffer);
+    GPUFreeRenderPipeline(f.pipelines[1]);
+    GPUFreeRenderPipeline(f.pipelines[0]);
+    return result;
+}
+
+int main()
+{
+    NullDevice null_device{};
+    CHECK(NullDevice_Create(&null_device, 0, false));
+
+    const int result = TestDrawList(null_device.device, null_device.queue);
+    printf(result ? "draw list tests failed\n" : "draw list tests passed\n");
+
+    NullDevice_Free(&null_device);
+    return result;
+}
@@ -0,0 +1,7 @@
+local source_file_list = {"$(projectdir)/"..project_name.."/Source/src/build.**.cpp", "$(projectdir)/"..project_name.."/Source/src/shader-reflections/spirv/spirv_reflect.c"}
+target("test_draw_list")
+    set_kind("binary")
+    add_deps("SimpleGPU")
+    set_group("test/draw_list")
+    add_defines("UNICODE")
+    add_files("main.cpp", source_file_list)
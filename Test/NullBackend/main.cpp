@@ -0,0 +1,123 @@
+#include "../Common/NullDevice.h"
+#include <cstring>
+
+// a staging buffer is filled on the cpu, copied into a buffer and a texture and submitted,
+// the null backend validates the barriers and completes the submission after a delay
+static int TestRecordAndSubmit(GPUDeviceID device, GPUQueueID queue)
+{
+    GPUBufferDescriptor staging_desc{};
+    staging_desc.size         = 4096;
+    staging_desc.flags        = GPU_BCF_PERSISTENT_MAP_BIT;
+    staging_desc.descriptors  = GPU_RESOURCE_TYPE_NONE;
+    staging_desc.memory_usage = GPU_MEM_USAGE_CPU_ONLY;
+    staging_desc.start_state  = GPU_RESOURCE_STATE_COPY_SOURCE;
+    GPUBufferID staging       = GPUCreateBuffer(device, &staging_desc);
+    CHECK(staging->cpu_mapped_address);
+    memset(staging->cpu_mapped_address, 0x5a, staging_desc.size);
+
+    GPUBufferDescriptor buffer_desc{};
+    buffer_desc.size         = 256;
+    buffer_desc.descriptors  = GPU_RESOURCE_TYPE_BUFFER;
+    buffer_desc.memory_usage = GPU_MEM_USAGE_GPU_ONLY;
+    buffer_desc.start_state  = GPU_RESOURCE_STATE_COPY_DEST;
+    GPUBufferID buffer       = GPUCreateBuffer(device, &buffer_desc);
+    CHECK(buffer->size == 256);
+    CHECK(!buffer->cpu_mapped_address);
+
+    // 8x8 + 4x4 + 2x2 + 1x1 texels of 4 bytes, times 2 layers
+    GPUTextureDescriptor texture_desc{};
+    texture_desc.width        = 8;
+    texture_desc.height       = 8;
+    texture_desc.depth        = 1;
+    texture_desc.array_size   = 2;
+    texture_desc.mip_levels   = 4;
+    texture_desc.format       = GPU_FORMAT_R8G8BA8_UNORM;
+    texture_desc.sample_count = GPU_SAMPLE_COUNT_1;
+    texture_desc.descriptors  = GPU_RESOURCE_TYPE_TEXTURE;
+    texture_desc.start_state  = GPU_RESOURCE_STATE_UNDEFINED;
+    GPUTextureID texture      = GPUCreateTexture(device, &texture_desc);
+    CHECK(texture->sizeInBytes == (64 + 16 + 4 + 1) * 4 * 2);
+
+    GPUCommandPoolID pool = GPUCreateCommandPool(queue);
+    GPUCommandBufferDescriptor cmd_desc{};
+    GPUCommandBufferID cmd = GPUCreateCommandBuffer(pool, &cmd_desc);
+    GPUCmdBegin(cmd);
+    {
+        GPUTextureBarrier texture_barrier{};
+        texture_barrier.texture   = texture;
+        texture_barrier.src_state = GPU_RESOURCE_STATE_UNDEFINED;
+        texture_barrier.dst_state = GPU_RESOURCE_STATE_COPY_DEST;
+        GPUResourceBarrierDescriptor barrier_desc{};
+        barrier_desc.texture_barriers       = &texture_barrier;
+        barrier_desc.texture_barriers_count = 1;
+        GPUCmdResourceBarrier(cmd, &barrier_desc);
+
+        GPUBufferToBufferTransfer buffer_copy{};
+        buffer_copy.dst  = buffer;
+        buffer_copy.src  = staging;
+        buffer_copy.size = buffer_desc.size;
+        GPUCmdTransferBufferToBuffer(cmd, &buffer_copy);
+
+        GPUBufferToTextureTransfer texture_copy{};
+        texture_copy.dst                         = texture;
+        texture_copy.src                         = staging;
+        texture_copy.src_offset                  = 256;
+        texture_copy.dst_subresource.aspects     = GPU_TVA_COLOR;
+        texture_copy.dst_subresource.layer_count = 2;
+        GPUCmdTransferBufferToTexture(cmd, &texture_copy);
+
+        GPUBufferBarrier buffer_barrier{};
+        buffer_barrier.buffer              = buffer;
+        buffer_barrier.src_state           = GPU_RESOURCE_STATE_COPY_DEST;
+        buffer_barrier.dst_state           = GPU_RESOURCE_STATE_SHADER_RESOURCE;
+        texture_barrier.src_state          = GPU_RESOURCE_STATE_COPY_DEST;
+        texture_barrier.dst_state          = GPU_RESOURCE_STATE_SHADER_RESOURCE;
+        barrier_desc.buffer_barriers       = &buffer_barrier;
+        barrier_desc.buffer_barriers_count = 1;
+        GPUCmdResourceBarrier(cmd, &barrier_desc);
+    }
+    GPUCmdEnd(cmd);
+
+    GPUFenceID fence        = GPUCreateFence(device);
+    GPUSemaphoreID timeline = GPUCreateTimelineSemaphore(device, 0);
+    CHECK(GPUQueryFenceStatus(fence) == GPU_FENCE_STATUS_NOTSUBMITTED);
+    const uint64_t signal = 1;
+    GPUQueueSubmitDescriptor submit_desc{};
+    submit_desc.cmds                   = &cmd;
+    submit_desc.cmds_count             = 1;
+    submit_desc.signal_fence           = fence;
+    submit_desc.signal_semaphores      = &timeline;
+    submit_desc.signal_values          = &signal;
+    submit_desc.signal_semaphore_count = 1;
+    GPUSubmitQueue(queue, &submit_desc);
+    CHECK(GPUQueryFenceStatus(fence) == GPU_FENCE_STATUS_INCOMPLETE);
+    CHECK(GPUQuerySemaphoreValue(timeline) == 0);
+
+    // waiting resets the fence for the next submission
+    GPUWaitFences(&fence, 1);
+    CHECK(GPUQueryFenceStatus(fence) == GPU_FENCE_STATUS_NOTSUBMITTED);
+    CHECK(GPUWaitSemaphores(&timeline, &signal, 1, UINT64_MAX));
+    CHECK(GPUQuerySemaphoreValue(timeline) == 1);
+    GPUWaitQueueIdle(queue);
+
+    GPUFreeSemaphore(timeline);
+    GPUFreeFence(fence);
+    GPUFreeCommandBuffer(cmd);
+    GPUFreeCommandPool(pool);
+    GPUFreeTexture(texture);
+    GPUFreeBuffer(buffer);
+    GPUFreeBuffer(staging);
+    return 0;
+}
+
+int main()
+{
+    NullDevice null_device{};
+    CHECK(NullDevice_Create(&null_device, 50000, true));
+
+    const int result = TestRecordAndSubmit(null_device.device, null_device.queue);
+    printf(result ? "null backend tests failed\n" : "null backend tests passed\n");
+
+    NullDevice_Free(&null_device);
+    return result;
+}
@@ -0,0 +1,313 @@
+#include "../Common/NullDevice.h"
+#include "GPUUploader.hpp"
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static uint64_t FindByte(GPUUploaderID uploader, uint8_t value)
+{
+    const uint8_t* pMapped = (const uint8_t*)uploader->m_pRing->cpu_mapped_address;
+    for (uint64_t i = 0; i < uploader->mRingSize; i++)
+    {
+        if (pMapped[i] == value) return i;
+    }
+    return UINT64_MAX;
+}
+
+static GPUUploadToken UploadBytes(GPUUploaderID uploader, GPUBufferID buffer, uint8_t value, uint64_t size)
+{
+    std::vector<uint8_t> data(size, value);
+    GPUBufferUpload upload{};
+    upload.dst       = buffer;
+    upload.data      = data.data();
+    upload.size      = data.size();
+    upload.src_state = GPU_RESOURCE_STATE_COPY_DEST;
+    upload.dst_state = GPU_RESOURCE_STATE_COPY_DEST;
+    GPUUploadBatch batch{};
+    batch.buffers        = &upload;
+    batch.buffers_count  = 1;
+    batch.dst_queue_type = uploader->m_pQueue->queueType;
+    GPUUploaderEnqueue(uploader, &batch);
+    return GPUUploaderFlush(uploader);
+}
+
+// the ring is filled with copies that never complete on their own, the next upload has to wait
+// until the test completes the oldest one and wrap to the ring front while the younger ranges are in flight
+static int TestRingWrapAround()
+{
+    NullDevice null_device{};
+    CHECK(NullDevice_Create(&null_device, UINT32_MAX, true));
+    GPUUploaderDescriptor uploader_desc{};
+    uploader_desc.queue     = null_device.queue;
+    uploader_desc.ring_size = 3500;
+    GPUUploaderID uploader  = GPUCreateUploader(null_device.device, &uploader_desc);
+
+    GPUBufferDescriptor buffer_desc{};
+    buffer_desc.size         = 1000;
+    buffer_desc.descriptors  = GPU_RESOURCE_TYPE_BUFFER;
+    buffer_desc.memory_usage = GPU_MEM_USAGE_GPU_ONLY;
+    buffer_desc.start_state  = GPU_RESOURCE_STATE_COPY_DEST;
+    GPUBufferID buffer       = GPUCreateBuffer(null_device.device, &buffer_desc);
+
+    for (uint8_t i = 1; i <= 3; i++)
+    {
+        CHECK(UploadBytes(uploader, buffer, i, 1000) == i);
+    }
+    CHECK(!GPUUploaderIsComplete(uploader, 1));
+    // the result is the same whether the signal lands before or during the wait for free space
+    std::thread completion([&] { GPUSignalSemaphore(uploader->m_pTimeline, 1); });
+    const GPUUploadToken last = UploadBytes(uploader, buffer, 4, 500);
+    completion.join();
+    CHECK(last == 4);
+    CHECK(GPUUploaderIsComplete(uploader, 1));
+    CHECK(!GPUUploaderIsComplete(uploader, 2));
+
+    // only the retired range got overwritten
+    CHECK(FindByte(uploader, 4) == 0);
+    CHECK(FindByte(uploader, 1) == 500);
+    CHECK(FindByte(uploader, 2) == 1008);
+    CHECK(FindByte(uploader, 3) == 2016);
+    GPUSignalSemaphore(uploader->m_pTimeline, last);
+    GPUUploaderWait(uploader, last);
+    CHECK(GPUUploaderIsComplete(uploader, last));
+
+    GPUFreeBuffer(buffer);
+    GPUFreeUploader(uploader);
+    NullDevice_Free(&null_device);
+    return 0;
+}
+
+// 12 byte texels do not divide 256, the staging offset has to stay on a texel boundary
+static int TestTextureAlignment(GPUDeviceID device, GPUQueueID queue)
+{
+    GPUUploaderDescriptor uploader_desc{};
+    uploader_desc.queue     = queue;
+    uploader_desc.ring_size = 4096;
+    GPUUploaderID uploader  = GPUCreateUploader(device, &uploader_desc);
+
+    GPUBufferDescriptor buffer_desc{};
+    buffer_desc.size         = 16;
+    buffer_desc.descriptors  = GPU_RESOURCE_TYPE_BUFFER;
+    buffer_desc.memory_usage = GPU_MEM_USAGE_GPU_ONLY;
+    buffer_desc.start_state  = GPU_RESOURCE_STATE_COPY_DEST;
+    GPUBufferID buffer       = GPUCreateBuffer(device, &buffer_desc);
+
+    GPUTextureDescriptor texture_desc{};
+    texture_desc.width        = 4;
+    texture_desc.height       = 4;
+    texture_desc.depth        = 1;
+    texture_desc.array_size   = 1;
+    texture_desc.mip_levels   = 1;
+    texture_desc.format       = GPU_FORMAT_R32G32B32_SFLOAT;
+    texture_desc.sample_count = GPU_SAMPLE_COUNT_1;
+    texture_desc.descriptors  = GPU_RESOURCE_TYPE_TEXTURE;
+    texture_desc.start_state  = GPU_RESOURCE_STATE_COPY_DEST;
+    GPUTextureID texture      = GPUCreateTexture(device, &texture_desc);
+
+    uint8_t bufferData[16];
+    uint8_t textureData[4 * 4 * 12];
+    memset(bufferData, 0x11, sizeof(bufferData));
+    memset(textureData, 0x22, sizeof(textureData));
+    GPUBufferUpload bufferUpload{};
+    bufferUpload.dst       = buffer;
+    bufferUpload.data      = bufferData;
+    bufferUpload.size      = sizeof(bufferData);
+    bufferUpload.src_state = GPU_RESOURCE_STATE_COPY_DEST;
+    bufferUpload.dst_state = GPU_RESOURCE_STATE_COPY_DEST;
+    GPUTextureUpload textureUpload{};
+    textureUpload.dst                             = texture;
+    textureUpload.dst_subresource.aspects         = GPU_TVA_COLOR;
+    textureUpload.dst_subresource.layer_count     = 1;
+    textureUpload.data                            = textureData;
+    textureUpload.size                            = sizeof(textureData);
+    textureUpload.src_state                       = GPU_RESOURCE_STATE_COPY_DEST;
+    textureUpload.dst_state                       = GPU_RESOURCE_STATE_SHADER_RESOURCE;
+    GPUUploadBatch batch{};
+    batch.buffers        = &bufferUpload;
+    batch.buffers_count  = 1;
+    batch.textures       = &textureUpload;
+    batch.textures_count = 1;
+    batch.dst_queue_type = queue->queueType;
+    GPUUploaderWait(uploader, GPUUploaderEnqueue(uploader, &batch));
+
+    // lcm(256, 12) = 768
+    CHECK(FindByte(uploader, 0x11) == 0);
+    CHECK(FindByte(uploader, 0x22) == 768);
+
+    GPUFreeTexture(texture);
+    GPUFreeBuffer(buffer);
+    GPUFreeUploader(uploader);
+    return 0;
+}
+
+// two uploads into one buffer share its transitions, the null backend asserts on a barrier
+// that does not start from the current state
+static int TestBarrierMerge(GPUDeviceID device, GPUQueueID queue)
+{
+    GPUUploaderDescriptor uploader_desc{};
+    uploader_desc.queue     = queue;
+    uploader_desc.ring_size = 4096;
+    GPUUploaderID uploader  = GPUCreateUploader(device, &uploader_desc);
+
+    GPUBufferDescriptor buffer_desc{};
+    buffer_desc.size         = 64;
+    buffer_desc.descriptors  = GPU_RESOURCE_TYPE_BUFFER;
+    buffer_desc.memory_usage = GPU_MEM_USAGE_GPU_ONLY;
+    buffer_desc.start_state  = GPU_RESOURCE_STATE_SHADER_RESOURCE;
+    GPUBufferID buffer       = GPUCreateBuffer(device, &buffer_desc);
+
+    uint8_t data[16] = {};
+    GPUBufferUpload uploads[2]{};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        uploads[i].dst        = buffer;
+        uploads[i].dst_offset = i * sizeof(data);
+        uploads[i].data       = data;
+        uploads[i].size       = sizeof(data);
+        uploads[i].src_state  = GPU_RESOURCE_STATE_SHADER_RESOURCE;
+        uploads[i].dst_state  = GPU_RESOURCE_STATE_SHADER_RESOURCE;
+    }
+    GPUUploadBatch batch{};
+    batch.buffers        = uploads;
+    batch.buffers_count  = 2;
+    batch.dst_queue_type = queue->queueType;
+    GPUUploaderWait(uploader, GPUUploaderEnqueue(uploader, &batch));
+
+    GPUFreeBuffer(buffer);
+    GPUFreeUploader(uploader);
+    return 0;
+}
+
+// an empty batch hands out the last submitted token, waiting on it must not block
+static int TestEmptyBatch(GPUDeviceID device, GPUQueueID queue)
+{
+    GPUUploaderDescriptor uploader_desc{};
+    uploader_desc.queue     = queue;
+    uploader_desc.ring_size = 4096;
+    GPUUploaderID uploader  = GPUCreateUploader(device, &uploader_desc);
+
+    GPUUploadBatch batch{};
+    batch.dst_queue_type       = queue->queueType;
+    const GPUUploadToken token = GPUUploaderEnqueue(uploader, &batch);
+    CHECK(token == 0);
+    GPUUploaderWait(uploader, token);
+    CHECK(GPUUploaderIsComplete(uploader, token));
+    CHECK(GPUUploaderFlush(uploader) == 0);
+
+    GPUFreeUploader(uploader);
+    return 0;
+}
+
+struct BufferCommand
+{
+    bool barrier; // a copy dest to copy dest barrier, otherwise a copy
+    GPUBufferID buffer;
+    uint32_t regions_count;
+};
+
+// the commands are observed through a copy of the null proc table
+static std::vector<BufferCommand> sBufferCommands;
+static GPUProcCmdResourceBarrier sNullResourceBarrier;
+
+static void RecordResourceBarrier(GPUCommandBufferID cmd, const GPUResourceBarrierDescriptor* desc)
+{
+    for (uint32_t i = 0; i < desc->buffer_barriers_count; i++)
+    {
+        const GPUBufferBarrier& barrier = desc->buffer_barriers[i];
+        if (barrier.src_state == GPU_RESOURCE_STATE_COPY_DEST && barrier.dst_state == GPU_RESOURCE_STATE_COPY_DEST)
+            sBufferCommands.push_back({ true, barrier.buffer, 0 });
+    }
+    sNullResourceBarrier(cmd, desc);
+}
+
+static void RecordBufferCopy(GPUCommandBufferID /*cmd*/, const GPUBufferToBufferRegions* desc)
+{
+    sBufferCommands.push_back({ false, desc->dst, desc->regions_count });
+}
+
+// a copy that rewrites bytes an earlier copy of the same flush wrote has to wait for it,
+// whether the two uploads are adjacent or another resource is copied in between
+static int TestOverlappingUploads(GPUDeviceID device, GPUQueueID queue)
+{
+    GPUUploaderDescriptor uploader_desc{};
+    uploader_desc.queue     = queue;
+    uploader_desc.ring_size = 4096;
+    GPUUploaderID uploader  = GPUCreateUploader(device, &uploader_desc);
+
+    GPUBufferDescriptor buffer_desc{};
+    buffer_desc.size         = 64;
+    buffer_desc.descriptors  = GPU_RESOURCE_TYPE_BUFFER;
+    buffer_desc.memory_usage = GPU_MEM_USAGE_GPU_ONLY;
+    buffer_desc.start_state  = GPU_RESOURCE_STATE_COPY_DEST;
+    GPUBufferID a            = GPUCreateBuffer(device, &buffer_desc);
+    GPUBufferID b            = GPUCreateBuffer(device, &buffer_desc);
+
+    // the table members are const, the copy is patched bytewise
+    alignas(GPUProcTable) uint8_t procs[sizeof(GPUProcTable)];
+    const GPUProcCmdResourceBarrier barrier           = &RecordResourceBarrier;
+    const GPUProcCmdTransferBufferToBufferRegions copy = &RecordBufferCopy;
+    memcpy(procs, device->pProcTableCache, sizeof(GPUProcTable));
+    memcpy(procs + offsetof(GPUProcTable, CmdResourceBarrier), &barrier, sizeof(barrier));
+    memcpy(procs + offsetof(GPUProcTable, CmdTransferBufferToBufferRegions), &copy, sizeof(copy));
+    const GPUProcTable* pNullProcs        = device->pProcTableCache;
+    sNullResourceBarrier                  = pNullProcs->CmdResourceBarrier;
+    ((GPUDevice*)device)->pProcTableCache = (const GPUProcTable*)procs;
+
+    uint8_t data[16] = {};
+    const struct
+    {
+        GPUBufferID dst;
+        uint64_t offset;
+    } writes[5] = { { a, 0 }, { a, 16 }, { a, 8 }, { b, 0 }, { a, 40 } };
+    GPUBufferUpload uploads[6]{};
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        uploads[i].dst        = writes[i].dst;
+        uploads[i].dst_offset = writes[i].offset;
+        uploads[i].data       = data;
+        uploads[i].size       = sizeof(data);
+        uploads[i].src_state  = GPU_RESOURCE_STATE_COPY_DEST;
+        uploads[i].dst_state  = GPU_RESOURCE_STATE_COPY_DEST;
+    }
+    // the last one rewrites a but is separated from its earlier copies by the copy into b,
+    // it still shares a copy command with the upload before it
+    uploads[5]            = uploads[0];
+    uploads[5].dst_offset = 4;
+    GPUUploadBatch batch{};
+    batch.buffers        = uploads;
+    batch.buffers_count  = 6;
+    batch.dst_queue_type = queue->queueType;
+    sBufferCommands.clear();
+    GPUUploaderWait(uploader, GPUUploaderEnqueue(uploader, &batch));
+    ((GPUDevice*)device)->pProcTableCache = pNullProcs;
+
+    CHECK(sBufferCommands.size() == 6);
+    CHECK(!sBufferCommands[0].barrier && sBufferCommands[0].buffer == a && sBufferCommands[0].regions_count == 2);
+    CHECK(sBufferCommands[1].barrier && sBufferCommands[1].buffer == a);
+    CHECK(!sBufferCommands[2].barrier && sBufferCommands[2].buffer == a && sBufferCommands[2].regions_count == 1);
+    CHECK(!sBufferCommands[3].barrier && sBufferCommands[3].buffer == b);
+    CHECK(sBufferCommands[4].barrier && sBufferCommands[4].buffer == a);
+    CHECK(!sBufferCommands[5].barrier && sBufferCommands[5].buffer == a && sBufferCommands[5].regions_count == 2);
+
+    GPUFreeBuffer(b);
+    GPUFreeBuffer(a);
+    GPUFreeUploader(uploader);
+    return 0;
+}
+
+int main()
+{
+    NullDevice null_device{};
+    CHECK(NullDevice_Create(&null_device, 0, true));
+
+    int result = TestTextureAlignment(null_device.device, null_device.queue);
+    if (!result) result = TestBarrierMerge(null_device.device, null_device.queue);
+    if (!result) result = TestEmptyBatch(null_device.device, null_device.queue);
+    if (!result) result = TestOverlappingUploads(null_device.device, null_device.queue);
+    if (!result) result = TestRingWrapAround();
+    printf(result ? "uploader tests failed\n" : "uploader tests passed\n");
+
+    NullDevice_Free(&null_device);
+    return result;
+}
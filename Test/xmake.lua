@@ -1 +1,4 @@
-includes("SimpleGPU/xmake.lua")
\ No newline at end of file
+includes("SimpleGPU/xmake.lua")
+includes("NullBackend/xmake.lua")
+includes("Uploader/xmake.lua")
+includes("DrawList/xmake.lua")
\ No newline at end of file